@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+"""
+Example: Connect Four as an array-backed Python game (pymcts.ArrayPythonState)
+
+Same rules as connect_four_python.py, but the game object holds no state: every state is a fixed-size
+NumPy buffer stored in C++, and the methods below only implement the logic on those buffers. Search trees
+then contain no Python objects, so large searches don't fill the interpreter's heap.
+"""
+import sys
+import os
+# Add the project directory to path to find pymcts module
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+import pymcts
+import numpy
+import random
+import time
+
+ROWS, COLS = 6, 7
+TURN = ROWS * COLS          # side to move: 1 (X) or -1 (O)
+RESULT = TURN + 1           # 0 while running, 1 or -1 for the winner, 2 for a draw
+SYMBOLS = {0: ' ', 1: 'X', -1: 'O'}
+
+
+def _wins(board, row, col, player):
+    """Whether the piece just dropped at (row, col) completes four in a row"""
+    for dr, dc in ((0, 1), (1, 0), (1, 1), (1, -1)):
+        count = 1
+        for sign in (1, -1):
+            r, c = row + sign * dr, col + sign * dc
+            while 0 <= r < ROWS and 0 <= c < COLS and board[r * COLS + c] == player:
+                count += 1
+                r, c = r + sign * dr, c + sign * dc
+        if count >= 4:
+            return True
+    return False
+
+
+def _drop(board, col):
+    """Drop a piece of the side to move in col (board is a list or an array), False if the column is full"""
+    player = int(board[TURN])
+    for row in range(ROWS - 1, -1, -1):
+        if board[row * COLS + col] == 0:
+            board[row * COLS + col] = player
+            if _wins(board, row, col, player):
+                board[RESULT] = player
+            elif all(board[c] != 0 for c in range(COLS)):
+                board[RESULT] = 2
+            board[TURN] = -player
+            return True
+    return False
+
+
+class ConnectFourArrayGame:
+    """Connect Four logic on int8 buffers: 42 squares (row 0 at the top), the side to move and the result"""
+    state_size = ROWS * COLS + 2
+    state_dtype = numpy.int8
+    action_space_size = COLS
+
+    @staticmethod
+    def initial_state():
+        state = numpy.zeros(ConnectFourArrayGame.state_size, dtype=numpy.int8)
+        state[TURN] = 1
+        return state
+
+    def actions(self, state):
+        if state[RESULT] != 0:
+            return []
+        return numpy.flatnonzero(state[:COLS] == 0)
+
+    def next_state(self, state, action, out):
+        # out already holds a copy of state
+        if not _drop(out, action):
+            raise ValueError(f"Column {action} is full")
+
+    def is_terminal(self, state):
+        return state[RESULT] != 0
+
+    def is_self_side_turn(self, state):
+        return state[TURN] == 1
+
+    def rollout(self, state):
+        board = state.tolist()        # the buffer is only valid during the call
+        while board[RESULT] == 0:
+            _drop(board, random.choice([c for c in range(COLS) if board[c] == 0]))
+        return {1: 1.0, -1: 0.0, 2: 0.5}[board[RESULT]]
+
+    def rollout_many(self, states):
+        # one Python call per leaf batch (see pymcts.set_leaf_batch_size)
+        return [self.rollout(state) for state in states]
+
+    def print(self, state):
+        print("\n  " + " ".join(str(c) for c in range(COLS)))
+        for row in range(ROWS):
+            print("| " + " ".join(SYMBOLS[int(v)] for v in state[row * COLS:(row + 1) * COLS]) + " |")
+        print("-" * (2 * COLS + 3))
+        print(f"Current player: {SYMBOLS[int(state[TURN])]}")
+
+
+def demo_game(max_iter=2000, max_seconds=5):
+    """MCTS (X) against a random player (O)"""
+    print("\n🎮 Array-backed Connect Four - MCTS vs random")
+    print("=" * 60)
+    start = pymcts.ArrayPythonState(ConnectFourArrayGame(), ConnectFourArrayGame.initial_state())
+    agent = pymcts.MCTS_agent(start, max_iter, max_seconds)
+    enemy_move = None
+    began = time.time()
+    while True:
+        move = agent.genmove(enemy_move)
+        state = agent.get_current_state()
+        print(f"MCTS plays column {move.action} ({start.get_arena_slots()} states alive)")
+        if state.is_terminal():
+            break
+        enemy_move = random.choice(state.actions_to_try())
+        state = state.next_state(enemy_move)
+        print(f"Random plays column {enemy_move.action}")
+        if state.is_terminal():
+            break
+    state.print()
+    print(f"Game took {time.time() - began:.1f}s")
+
+
+if __name__ == "__main__":
+    demo_game()
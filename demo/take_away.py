@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+"""
+Take-away game in plain Python: two players take 1 or 2 stones from a pile and whoever takes the last stone wins.
+The side to move loses exactly when the number of stones is a multiple of 3, so searches can be checked against
+the exact value. The classes don't derive from pymcts types (wrap states in pymcts.SerializedPythonState) and are
+picklable, so trees of them can be saved with their states. ArrayPileGame is the same game for
+pymcts.ArrayPythonState, on buffers [stones, first_to_move].
+"""
+import sys
+import os
+
+
+def pile_value(stones, first_to_move):
+    """Exact result for the first player: the side to move loses iff stones % 3 == 0."""
+    mover_wins = stones % 3 != 0
+    return 1.0 if mover_wins == bool(first_to_move) else 0.0
+
+
+class PileMove:
+    def __init__(self, take):
+        self.take = take
+
+    def __eq__(self, other):
+        return getattr(other, "take", None) == self.take     # also matches moves of other classes, e.g. enemy moves
+
+    def __hash__(self):
+        return self.take
+
+    def sprint(self):
+        return f"Take{self.take}"
+
+
+class PileState:
+    move_class = PileMove           # subclasses can use their own moves
+
+    def __init__(self, stones=10, first_to_move=True):
+        self.stones = stones
+        self.first_to_move = first_to_move
+
+    def actions_to_try(self):
+        return [self.move_class(take) for take in (1, 2) if take <= self.stones]
+
+    def next_state(self, move):
+        return type(self)(self.stones - move.take, not self.first_to_move)     # keeps subclasses
+
+    def is_terminal(self):
+        return self.stones == 0
+
+    def is_self_side_turn(self):
+        return self.first_to_move
+
+    def print(self):
+        print(f"{self.stones} stones")
+
+    def value(self):
+        return pile_value(self.stones, self.first_to_move)
+
+    def rollout(self):
+        return self.value()
+
+
+class ArrayPileGame:
+    """Take-away logic on int64 buffers [stones, first_to_move]; actions are the number of stones taken."""
+    state_size = 2
+    state_dtype = "int64"
+    action_space_size = 3
+
+    def actions(self, state):
+        return [take for take in (1, 2) if take <= state[0]]
+
+    def next_state(self, state, action, out):
+        # out already holds a copy of state
+        out[0] -= action
+        out[1] = 1 - state[1]
+
+    def is_terminal(self, state):
+        return state[0] == 0
+
+    def is_self_side_turn(self, state):
+        return bool(state[1])
+
+    def rollout(self, state):
+        return pile_value(state[0], state[1])
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+    import pymcts
+
+    agent = pymcts.MCTS_agent(pymcts.SerializedPythonState(PileState(10)), max_iter=500, max_seconds=1)
+    move = agent.genmove(None)
+    print(f"10 stones: MCTS plays {move.sprint()} (Take1 leaves a multiple of 3)")
@@ -0,0 +1,51 @@
+#ifndef MCTS_EXAMPLES_BENCHMARK_H
+#define MCTS_EXAMPLES_BENCHMARK_H
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include "../mcts/include/mcts.h"
+
+
+/** The "bench <n>" command of the example CLIs: clone, expansion, rollout and tree search throughput from state,
+ * with n expansions, rollouts and search iterations (and 100 n clones). The search stops after max_seconds */
+template <class Game_state>
+void benchmark_state(const Game_state &state, int num, double max_seconds) {
+    typedef std::chrono::steady_clock clk;
+    clk::time_point t0 = clk::now();
+    for (int i = 0 ; i < 100 * num ; i++) {
+        delete state.clone();
+    }
+    clk::time_point t1 = clk::now();
+    long children = 0;
+    for (int i = 0 ; i < num ; i++) {    // what expand() pays for: generate moves and build every child state
+        queue<MCTS_move *> *actions = state.actions_to_try();
+        while (!actions->empty()) {
+            delete state.next_state(actions->front());
+            delete actions->front();
+            actions->pop();
+            children++;
+        }
+        delete actions;
+    }
+    clk::time_point t2 = clk::now();
+    for (int i = 0 ; i < num ; i++) {
+        state.rollout();
+    }
+    clk::time_point t3 = clk::now();
+    MCTS_tree bench_tree(state.clone());
+    bench_tree.grow_tree(num, max_seconds);
+    clk::time_point t4 = clk::now();
+    double dclone = std::chrono::duration<double>(t1 - t0).count();
+    double dexpand = std::chrono::duration<double>(t2 - t1).count();
+    double drollout = std::chrono::duration<double>(t3 - t2).count();
+    double dsearch = std::chrono::duration<double>(t4 - t3).count();
+    std::cout << "State size: " << sizeof(Game_state) << " bytes" << std::endl
+              << "Clones/sec: " << std::setprecision(6) << (100.0 * num) / dclone << std::endl
+              << "Full expansions/sec: " << num / dexpand << " (" << children / dexpand << " child states/sec)" << std::endl
+              << "Rollouts/sec: " << num / drollout << std::endl
+              << "Tree iterations/sec: " << num / dsearch << " (tree size " << bench_tree.get_size() << ")" << std::endl;
+}
+
+
+#endif
@@ -0,0 +1,176 @@
+#include <iostream>
+#include <random>
+#include <cstring>
+#include "ConnectFour.h"
+
+
+using namespace std;
+
+
+ConnectFour_state::ConnectFour_state() : MCTS_state(), stones{0, 0}, moves_played(0), turn('X'), winner(' ') {
+    for (int c = 0 ; c < COLUMNS ; c++) {
+        heights[c] = (unsigned char) (HEIGHT * c);
+    }
+}
+
+bool ConnectFour_state::has_four(uint64_t b) {
+    // shifts: 1 -> vertical, HEIGHT -> horizontal, HEIGHT - 1 and HEIGHT + 1 -> the two diagonals
+    uint64_t m = b & (b >> 1);
+    if (m & (m >> 2)) return true;
+    m = b & (b >> HEIGHT);
+    if (m & (m >> (2 * HEIGHT))) return true;
+    m = b & (b >> (HEIGHT - 1));
+    if (m & (m >> (2 * (HEIGHT - 1)))) return true;
+    m = b & (b >> (HEIGHT + 1));
+    if (m & (m >> (2 * (HEIGHT + 1)))) return true;
+    return false;
+}
+
+void ConnectFour_state::drop(int column) {
+    uint64_t &own = stones[(turn == 'X') ? 0 : 1];
+    own |= ((uint64_t) 1) << heights[column]++;
+    moves_played++;
+    if (has_four(own)) winner = turn;
+    else if (moves_played == COLUMNS * ROWS) winner = 'd';
+    turn = (turn == 'X') ? 'O' : 'X';
+}
+
+int ConnectFour_state::completing_column(uint64_t b) const {
+    for (int c = 0 ; c < COLUMNS ; c++) {
+        if (!column_full(c) && has_four(b | (((uint64_t) 1) << heights[c]))) return c;
+    }
+    return -1;
+}
+
+MCTS_move *ConnectFour_state::winning_move() const {
+    if (is_terminal()) return NULL;
+    int c = completing_column(stones[(turn == 'X') ? 0 : 1]);
+    return (c >= 0) ? new ConnectFour_move(c, turn) : NULL;
+}
+
+MCTS_move *ConnectFour_state::blocking_move() const {
+    if (is_terminal()) return NULL;
+    int c = completing_column(stones[(turn == 'X') ? 1 : 0]);
+    return (c >= 0) ? new ConnectFour_move(c, turn) : NULL;
+}
+
+bool ConnectFour_state::legal_move(const ConnectFour_move *move) const {
+    if (move == NULL || is_terminal()) return false;
+    if (move->player != turn) return false;
+    if (move->column < 0 || move->column >= COLUMNS) return false;
+    return !column_full(move->column);
+}
+
+bool ConnectFour_state::play_move(const ConnectFour_move *move) {
+    if (!legal_move(move)) {
+        cout << "Invalid command: Illegal move: " << ((move != NULL) ? move->sprint() : "NULL") << endl << endl;
+        return false;
+    }
+    drop(move->column);
+    return true;
+}
+
+MCTS_state *ConnectFour_state::next_state(const MCTS_move *move) const {
+    // Note: We have to manually cast it to its correct type
+    const ConnectFour_move *m = (const ConnectFour_move *) move;
+    if (!legal_move(m)) {
+        cerr << "Warning: Illegal move " << ((m != NULL) ? m->sprint() : "NULL") << endl;
+        return NULL;
+    }
+    ConnectFour_state *new_state = new ConnectFour_state(*this);
+    new_state->drop(m->column);
+    return new_state;
+}
+
+queue<MCTS_move *> *ConnectFour_state::actions_to_try() const {
+    queue<MCTS_move *> *Q = new queue<MCTS_move *>();
+    if (is_terminal()) return Q;
+    for (int c = 0 ; c < COLUMNS ; c++) {
+        if (!column_full(c)) {
+            Q->push(new ConnectFour_move(c, turn));
+        }
+    }
+    return Q;
+}
+
+double ConnectFour_state::rollout() const {
+    if (is_terminal()) return (winner == 'X') ? 1.0 : (winner == 'd') ? 0.5 : 0.0;
+    // Simulate a completely random game on a stack copy (no allocations)
+    static thread_local std::random_device rd;
+    static thread_local std::mt19937 gen(rd());
+    ConnectFour_state s(*this);
+    int playable[COLUMNS];
+    while (s.winner == ' ') {
+        int n = 0;
+        for (int c = 0 ; c < COLUMNS ; c++) {
+            if (!s.column_full(c)) playable[n++] = c;
+        }
+        std::uniform_int_distribution<> dis(0, n - 1);
+        s.drop(playable[dis(gen)]);
+    }
+    return (s.winner == 'X') ? 1.0 : (s.winner == 'd') ? 0.5 : 0.0;
+}
+
+vector<double> ConnectFour_state::to_numpy() const {
+    vector<double> planes(COLUMNS * ROWS, 0.0);
+    uint64_t own = stones[(turn == 'X') ? 0 : 1], other = stones[(turn == 'X') ? 1 : 0];
+    for (int c = 0 ; c < COLUMNS ; c++) {
+        for (int r = 0 ; r < ROWS ; r++) {
+            int i = HEIGHT * c + r;
+            planes[ROWS * c + r] = ((own >> i) & 1) ? 1.0 : ((other >> i) & 1) ? -1.0 : 0.0;
+        }
+    }
+    return planes;
+}
+
+bool ConnectFour_state::serialize(string &out) const {
+    out.append(reinterpret_cast<const char *>(stones), sizeof(stones));
+    out.append(reinterpret_cast<const char *>(heights), sizeof(heights));
+    out += (char) moves_played;
+    out += turn;
+    out += winner;
+    return true;
+}
+
+MCTS_state *ConnectFour_state::deserialize(const char *data, size_t size) const {
+    if (size != sizeof(stones) + sizeof(heights) + 3) return NULL;
+    ConnectFour_state *state = new ConnectFour_state();
+    memcpy(state->stones, data, sizeof(stones));
+    memcpy(state->heights, data + sizeof(stones), sizeof(heights));
+    data += sizeof(stones) + sizeof(heights);
+    state->moves_played = (unsigned char) data[0];
+    state->turn = data[1];
+    state->winner = data[2];
+    bool valid = (state->turn == 'X' || state->turn == 'O') && (state->stones[0] & state->stones[1]) == 0
+                 && (state->winner == 'X' || state->winner == 'O' || state->winner == 'd' || state->winner == ' ');
+    // every column filled from the bottom up to its height, nothing above it (or in the sentinel bits)
+    uint64_t filled = 0;
+    for (int c = 0 ; c < COLUMNS ; c++) {
+        valid = valid && state->heights[c] >= HEIGHT * c && state->heights[c] <= HEIGHT * c + ROWS;
+        if (valid) filled |= (((uint64_t) 1) << state->heights[c]) - (((uint64_t) 1) << (HEIGHT * c));
+    }
+    int stones_played = 0;
+    for (uint64_t b = state->stones[0] | state->stones[1] ; b ; b &= b - 1) stones_played++;
+    valid = valid && (state->stones[0] | state->stones[1]) == filled && state->moves_played == stones_played;
+    if (!valid) {
+        delete state;
+        return NULL;
+    }
+    return state;
+}
+
+void ConnectFour_state::print() const {
+    cout << endl;
+    for (int r = ROWS - 1 ; r >= 0 ; r--) {
+        cout << "|";
+        for (int c = 0 ; c < COLUMNS ; c++) {
+            int i = HEIGHT * c + r;
+            cout << (((stones[0] >> i) & 1) ? 'X' : ((stones[1] >> i) & 1) ? 'O' : ' ') << "|";
+        }
+        if (r == ROWS - 1) cout << "     Player turn: " << turn;
+        if (r == ROWS - 2 && winner != ' ') cout << "     " << ((winner == 'd') ? string("Draw") : string("Winner: ") + winner);
+        cout << endl;
+    }
+    cout << "+-+-+-+-+-+-+-+" << endl;
+    cout << " 0 1 2 3 4 5 6" << endl << endl;
+}
@@ -0,0 +1,75 @@
+#ifndef MCTS_CONNECTFOUR_H
+#define MCTS_CONNECTFOUR_H
+
+#include "../../mcts/include/state.h"
+#include <cstdint>
+
+using namespace std;
+
+
+struct ConnectFour_move : public MCTS_move {
+    int column;
+    char player;                    // 'X' (moves first) or 'O'
+    ConnectFour_move(int column, char p) : column(column), player(p) {}
+    bool operator==(const MCTS_move& other) const override {
+        const ConnectFour_move &o = (const ConnectFour_move &) other;    // Note: Casting necessary
+        return column == o.column && player == o.player;
+    }
+    string sprint() const override {
+        return string("Drop") + player + "@" + to_string(column);
+    }
+    vector<double> to_numpy() const override {
+        // [column, player (1 for X)]
+        return {(double) column, (player == 'X') ? 1.0 : 0.0};
+    }
+    vector<int> to_env_action() const override {
+        return {column, (player == 'X') ? 1 : 0};
+    }
+};
+
+
+/** Standard 7 columns x 6 rows Connect Four on the usual 49-bit bitboard layout: each column takes 7 bits
+ * (bit 7 * column + row, row 0 at the bottom) and the 7th bit of every column is an always-empty sentinel,
+ * so four in a row in any direction is found with two shift-and-AND steps and never wraps between columns.
+ */
+class ConnectFour_state : public MCTS_state {
+public:
+    static const int COLUMNS = 7, ROWS = 6, HEIGHT = ROWS + 1;
+private:
+    uint64_t stones[2];                                       // [0] -> 'X', [1] -> 'O'
+    unsigned char heights[COLUMNS];                           // bit index of the next free square of every column
+    unsigned char moves_played;
+    char turn, winner;                                        // winner: 'X', 'O', 'd' for draw or ' ' if not over yet
+    //////////////////////////////////////////
+    static bool has_four(uint64_t b);
+    bool column_full(int column) const { return heights[column] == HEIGHT * column + ROWS; }
+    void drop(int column);                                    // current player drops in column, updates winner and turn
+    int completing_column(uint64_t b) const;                  // a column where b would get four in a row, -1 if none
+public:
+    ConnectFour_state();
+    char get_turn() const { return turn; }
+    char get_winner() const { return winner; }
+    bool legal_move(const ConnectFour_move *move) const;
+    bool play_move(const ConnectFour_move *move);
+    /** Overrides: **/
+    bool is_terminal() const override { return winner != ' '; }
+    MCTS_state *next_state(const MCTS_move *move) const override;
+    MCTS_state *clone() const override { return new ConnectFour_state(*this); }
+    queue<MCTS_move *> *actions_to_try() const override;
+    double rollout() const override;                          // the rollout simulation in MCTS
+    void print() const override;
+    bool is_self_side_turn() const override { return turn == 'X'; }
+    MCTS_move *winning_move() const override;
+    MCTS_move *blocking_move() const override;
+    // Training data: the 42 squares column by column from the bottom (1 own, -1 opponent's, 0 empty for the side to
+    // move), moves indexed by column
+    vector<double> to_numpy() const override;
+    int action_space_size() const override { return COLUMNS; }
+    int action_index(const MCTS_move *move) const override { return ((const ConnectFour_move *) move)->column; }
+    // Saved trees (MCTS_tree::save() with states): the bitboards, column heights, move count, turn and winner
+    bool serialize(string &out) const override;
+    MCTS_state *deserialize(const char *data, size_t size) const override;
+};
+
+
+#endif
@@ -0,0 +1,170 @@
+#include <iostream>
+#include "ConnectFour.h"
+#include "../../mcts/include/mcts.h"
+#include "../Benchmark.h"
+
+/** AI PARAMETERS **/
+#define MAXITER 20000
+#define MAXSECONDS 15
+
+#define PROMPT "> "
+
+typedef ConnectFour_state Game_state;
+
+const string commands = R"(Valid commands are:
+  quit or q                         -- exits program
+  help                              -- lists commands
+  autoprint                         -- toggles automatic printing of the board after every command (initially true)
+  winner                            -- check if there is a winner yet and who
+  showboard or print                -- prints board
+  playmove or m <column>            -- drops a piece in column (0-6) for current player
+  genmove                           -- generates move for current player using MCTS
+  clearboard or reset               -- resets the board
+  bench <n>                         -- measures clone, expansion, rollout and tree search throughput)";
+
+
+bool parse_column(const string &s, int &column) {
+    if (s.size() == 1 && isdigit(s[0])) {
+        column = s[0] - '0';
+        if (column < Game_state::COLUMNS) return true;
+    }
+    return false;
+}
+
+
+int main() {
+    srand(time(NULL));
+
+    cout << "============================================================" << endl
+         << "=============╣    Welcome to Connect Four!    ╠=============" << endl
+         << "============================================================" << endl << endl;
+    cout << commands << endl << endl;
+
+    Game_state *state = new Game_state();
+    string command;
+    char winner = ' ';
+    bool auto_print = true;
+    if (auto_print) {
+        state->print();
+    }
+    /** Game Tree for AI (works for both sides) **/
+    MCTS_tree *game_tree = new MCTS_tree(new Game_state());    // Important: do not use the same state that we change in main loop
+
+    cout << state->get_turn() << "'s move:" << endl << PROMPT;
+    flush(cout);
+    while (cin >> command) {
+        if (command == "q" || command == "quit"){
+            cout << "Exiting..." << endl;
+            break;
+        }
+        else if (command == "listcommands" || command == "help") {
+            cout << commands << endl;
+        }
+        else if (command == "autoprint") {
+            auto_print = !auto_print;        // toggle
+        }
+        else if (command == "winner") {
+            winner = state->get_winner();
+            cout << ((winner != ' ') ? "TRUE " : "FALSE ") << winner << endl;
+        }
+        else if (command == "showboard" || command == "print") {
+            state->print();
+        }
+        else if (command == "playmove" || command == "m") {
+            if (winner != ' ') {
+                cin.ignore(512, '\n');
+                cout << "Game has already finished." << endl << endl;
+            } else {
+                string col;
+                cin >> col;
+                int column;
+                bool succ = parse_column(col, column);
+                if (!succ) {
+                    cout << "Invalid command: Invalid arguments" << endl << endl;
+                } else {
+                    // play the move
+                    ConnectFour_move move(column, state->get_turn());
+                    succ = state->play_move(&move);
+                    if (succ) {
+                        cout << move.sprint() << endl << endl;
+                        winner = state->get_winner();
+                        // advance game tree
+                        game_tree->advance_tree(&move);
+                    }
+                }
+            }
+        }
+        else if (command == "genmove") {    // generate AI move
+            if (winner != ' ') {
+                cin.ignore(512, '\n');
+                cout << "Game has already finished." << endl << endl;
+            } else {
+                // grow tree by thinking ahead and sampling monte carlo rollouts
+                game_tree->grow_tree(MAXITER, MAXSECONDS);
+                game_tree->print_stats();   // debug
+
+                // select best child node at root level
+                MCTS_node *best_child = game_tree->select_best_child();
+                if (best_child == NULL) {
+                    cerr << "Warning: Could not find best child. Tree has no children? Possible terminal node" << endl << endl;
+                } else {
+                    const ConnectFour_move *best_move = (const ConnectFour_move *) best_child->get_move();
+
+                    // advance the tree so the selected child node is now the root
+                    game_tree->advance_tree(best_move);
+
+                    // play AI move
+                    bool succ = state->play_move(best_move);
+                    if (!succ) {
+                        cerr << "Warning: AI generated illegal move: " <<  best_move->sprint() << endl << endl;
+                    } else {
+                        // print AI's move
+                        cout << best_move->sprint() << endl << endl;
+                    }
+                }
+                winner = state->get_winner();
+            }
+        } else if (command == "stats") {
+            game_tree->print_stats();
+        }
+        else if (command == "clearboard" || command == "reset") {
+            delete state;
+            state = new Game_state();
+            delete game_tree;
+            game_tree = new MCTS_tree(new Game_state());
+            winner = ' ';
+        }
+        else if (command == "rollout") {   // for debug
+            double res = 0.0;
+            int num;
+            cin >> num;
+            for (int i = 0 ; i < num ; i++) {
+                res += state->rollout();
+            }
+            double score = res / num;
+            cout << "Rollout average score: " << setprecision(4) << 100.0 * score << endl;
+        }
+        else if (command == "bench") {     // for debug: clone, expansion, rollout and search throughput from the current state
+            int num;
+            cin >> num;
+            benchmark_state(*state, num, MAXSECONDS);
+        }
+        else {
+            cout << "? unknown command" << endl << endl;
+        }
+        // before reading next command
+        if (auto_print) {
+            state->print();
+        }
+        if (winner == 'X' || winner == 'O') {
+            cout << endl << winner << " has won the game!" << endl << endl;
+        } else if (winner == 'd') {
+            cout << endl << "The game is a draw." << endl << endl;
+        }
+        cout << state->get_turn() << "'s move:" << endl << PROMPT;
+        flush(cout);
+    }
+    delete state;
+    delete game_tree;
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include <iostream>
+#include <random>
+#include "Gomoku.h"
+
+
+using namespace std;
+
+
+template <int M, int N, int K>
+Generic_MNK_state<M, N, K>::Generic_MNK_state() : MCTS_state(), stones{}, stones_played(0), turn('x'), winner(' ') {
+}
+
+template <int M, int N, int K>
+int Generic_MNK_state<M, N, K>::count_direction(const uint64_t *own, short int x, short int y, short int dx, short int dy) {
+    // number of consecutive own stones starting next to (x, y) and moving towards (dx, dy), at most K - 1 are needed
+    int count = 0;
+    for (x += dx, y += dy ; count < K - 1 && x >= 0 && x < M && y >= 0 && y < N ; x += dx, y += dy) {
+        if (!test_bit(own, x * N + y)) break;
+        count++;
+    }
+    return count;
+}
+
+template <int M, int N, int K>
+bool Generic_MNK_state<M, N, K>::completes_line(const uint64_t *own, int i) {
+    // A new line can only go through the last stone, so look at the 4 lines through it instead of the whole board
+    static const short int DIRECTIONS[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    short int x = i / N, y = i % N;
+    for (int d = 0 ; d < 4 ; d++) {
+        short int dx = DIRECTIONS[d][0], dy = DIRECTIONS[d][1];
+        if (1 + count_direction(own, x, y, dx, dy) + count_direction(own, x, y, -dx, -dy) >= K) return true;
+    }
+    return false;
+}
+
+template <int M, int N, int K>
+void Generic_MNK_state<M, N, K>::place(int i) {
+    uint64_t *own = stones[(turn == 'x') ? 0 : 1];
+    own[i >> 6] |= ((uint64_t) 1) << (i & 63);
+    stones_played++;
+    if (completes_line(own, i)) winner = turn;
+    else if (stones_played == SQUARES) winner = 'd';
+    turn = (turn == 'x') ? 'o' : 'x';
+}
+
+template <int M, int N, int K>
+bool Generic_MNK_state<M, N, K>::legal_move(const Gomoku_move *move) const {
+    if (move == NULL || is_terminal()) return false;
+    if (move->player != turn) return false;
+    if (move->x < 0 || move->x >= M || move->y < 0 || move->y >= N) return false;
+    return !occupied(move->x * N + move->y);
+}
+
+template <int M, int N, int K>
+bool Generic_MNK_state<M, N, K>::play_move(const Gomoku_move *move) {
+    if (!legal_move(move)) {
+        cout << "Invalid command: Illegal move: " << ((move != NULL) ? move->sprint() : "NULL") << endl << endl;
+        return false;
+    }
+    place(move->x * N + move->y);
+    return true;
+}
+
+template <int M, int N, int K>
+MCTS_state *Generic_MNK_state<M, N, K>::next_state(const MCTS_move *move) const {
+    // Note: We have to manually cast it to its correct type
+    const Gomoku_move *m = (const Gomoku_move *) move;
+    if (!legal_move(m)) {
+        cerr << "Warning: Illegal move " << ((m != NULL) ? m->sprint() : "NULL") << endl;
+        return NULL;
+    }
+    Generic_MNK_state *new_state = new Generic_MNK_state(*this);
+    new_state->place(m->x * N + m->y);
+    return new_state;
+}
+
+template <int M, int N, int K>
+queue<MCTS_move *> *Generic_MNK_state<M, N, K>::actions_to_try() const {
+    queue<MCTS_move *> *Q = new queue<MCTS_move *>();
+    if (is_terminal()) return Q;
+    for (int i = 0 ; i < SQUARES ; i++) {
+        if (!occupied(i)) {
+            Q->push(new Gomoku_move(i / N, i % N, turn));
+        }
+    }
+    return Q;
+}
+
+template <int M, int N, int K>
+double Generic_MNK_state<M, N, K>::rollout() const {
+    if (is_terminal()) return (winner == 'x') ? 1.0 : (winner == 'd') ? 0.5 : 0.0;
+    // Simulate a completely random game on a stack copy (no allocations): draw empty squares
+    // from an array without replacement by swapping the chosen one with the last one
+    static thread_local std::random_device rd;
+    static thread_local std::mt19937 gen(rd());
+    Generic_MNK_state s(*this);
+    short int empty[SQUARES];
+    int n = 0;
+    for (int i = 0 ; i < SQUARES ; i++) {
+        if (!occupied(i)) empty[n++] = i;
+    }
+    while (s.winner == ' ') {
+        std::uniform_int_distribution<> dis(0, n - 1);
+        int r = dis(gen);
+        int i = empty[r];
+        empty[r] = empty[--n];
+        s.place(i);
+    }
+    return (s.winner == 'x') ? 1.0 : (s.winner == 'd') ? 0.5 : 0.0;
+}
+
+template <int M, int N, int K>
+vector<double> Generic_MNK_state<M, N, K>::to_numpy() const {
+    vector<double> planes(SQUARES, 0.0);
+    const uint64_t *own = stones[(turn == 'x') ? 0 : 1], *other = stones[(turn == 'x') ? 1 : 0];
+    for (int i = 0 ; i < SQUARES ; i++) {
+        planes[i] = test_bit(own, i) ? 1.0 : test_bit(other, i) ? -1.0 : 0.0;
+    }
+    return planes;
+}
+
+template <int M, int N, int K>
+int Generic_MNK_state<M, N, K>::action_index(const MCTS_move *move) const {
+    const Gomoku_move *m = (const Gomoku_move *) move;
+    return m->x * N + m->y;
+}
+
+template <int M, int N, int K>
+void Generic_MNK_state<M, N, K>::print() const {
+    cout << endl << "    ";
+    for (int j = 0 ; j < N ; j++) cout << (char) ('A' + j) << ' ';
+    cout << endl;
+    for (int i = 0 ; i < M ; i++) {
+        printf("%3d ", i + 1);
+        for (int j = 0 ; j < N ; j++) {
+            int sq = i * N + j;
+            cout << (test_bit(stones[0], sq) ? 'x' : test_bit(stones[1], sq) ? 'o' : '.') << ' ';
+        }
+        if (i == 0) cout << "     Player turn: " << turn;
+        if (i == 1 && winner != ' ') cout << "     " << ((winner == 'd') ? string("Draw") : string("Winner: ") + winner);
+        cout << endl;
+    }
+    cout << endl;
+}
+
+
+/** Explicit instantiations of the variants typedef'd in Gomoku.h **/
+template class Generic_MNK_state<15, 15, 5>;
+template class Generic_MNK_state<9, 9, 5>;
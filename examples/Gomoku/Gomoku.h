@@ -0,0 +1,79 @@
+#ifndef MCTS_GOMOKU_H
+#define MCTS_GOMOKU_H
+
+#include "../../mcts/include/state.h"
+#include <cstdint>
+
+using namespace std;
+
+
+struct Gomoku_move : public MCTS_move {
+    short int x, y;                 // row, column
+    char player;                    // 'x' (moves first) or 'o'
+    Gomoku_move(short int x, short int y, char p) : x(x), y(y), player(p) {}
+    bool operator==(const MCTS_move& other) const override {
+        const Gomoku_move &o = (const Gomoku_move &) other;          // Note: Casting necessary
+        return x == o.x && y == o.y && player == o.player;
+    }
+    string sprint() const override {
+        return string(1, player) + " at " + string(1, (char) ('A' + y)) + to_string(x + 1);
+    }
+    vector<double> to_numpy() const override {
+        // [x, y, player (1 for x)]
+        return {(double) x, (double) y, (player == 'x') ? 1.0 : 0.0};
+    }
+    vector<int> to_env_action() const override {
+        return {x, y, (player == 'x') ? 1 : 0};
+    }
+};
+
+
+/** m,n,k-game: two players alternate placing stones on an M x N board and the first one to get K in a row
+ * (horizontally, vertically or diagonally) wins. Gomoku is the 15,15,5 game, TicTacToe the 3,3,3 one.
+ * Each player's stones are a bitboard (bit x * N + y) and wins are only looked for through the last stone played,
+ * so the state is a small fixed-size value and rollouts play on a stack copy of it.
+ * Only the variants typedef'd at the bottom of this file are instantiated (in Gomoku.cpp).
+ */
+template <int M, int N, int K>
+class Generic_MNK_state : public MCTS_state {
+public:
+    static const short int ROWS = M, COLS = N, SQUARES = M * N, IN_A_ROW = K;
+    static const short int WORDS = (M * N + 63) / 64;        // 64-bit words per bitboard
+private:
+    uint64_t stones[2][WORDS];                                // [0] -> 'x', [1] -> 'o'
+    short int stones_played;
+    char turn, winner;                                        // winner: 'x', 'o', 'd' for draw or ' ' if not over yet
+    //////////////////////////////////////////
+    static bool test_bit(const uint64_t *bits, int i) { return (bits[i >> 6] >> (i & 63)) & 1; }
+    bool occupied(int i) const { return test_bit(stones[0], i) || test_bit(stones[1], i); }
+    static int count_direction(const uint64_t *own, short int x, short int y, short int dx, short int dy);
+    static bool completes_line(const uint64_t *own, int i);   // is the stone on square i part of K in a row?
+    void place(int i);                                        // current player plays square i, updates winner and turn
+public:
+    Generic_MNK_state();
+    char get_turn() const { return turn; }
+    char get_winner() const { return winner; }
+    short int get_number_of_stones() const { return stones_played; }
+    bool legal_move(const Gomoku_move *move) const;
+    bool play_move(const Gomoku_move *move);
+    /** Overrides: **/
+    bool is_terminal() const override { return winner != ' '; }
+    MCTS_state *next_state(const MCTS_move *move) const override;
+    MCTS_state *clone() const override { return new Generic_MNK_state(*this); }
+    queue<MCTS_move *> *actions_to_try() const override;
+    double rollout() const override;                          // the rollout simulation in MCTS
+    void print() const override;
+    bool is_self_side_turn() const override { return turn == 'x'; }
+    // Training data: the M x N squares (1 own, -1 opponent's, 0 empty for the side to move), moves indexed x * N + y
+    vector<double> to_numpy() const override;
+    int action_space_size() const override { return SQUARES; }
+    int action_index(const MCTS_move *move) const override;
+};
+
+
+/** Instantiated variants **/
+typedef Generic_MNK_state<15, 15, 5> Gomoku_state;           // standard free-style Gomoku, branching factor 225
+typedef Generic_MNK_state<9, 9, 5>   Gomoku9_state;          // reduced board for quick tests
+
+
+#endif
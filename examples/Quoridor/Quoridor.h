@@ -1,92 +1,149 @@
-#ifndef MCTS_QUORIDOR_H
-#define MCTS_QUORIDOR_H
-
-#include "../../mcts/include/state.h"
-#include <forward_list>
-#include <random>
-
-
-/** TODOs-Ideas:
- * - If all I need is the shortest path to a goal state then A* search could be faster than BFS with a heuristic
- * that prioritizes moves towards the endzone (i.e. up for black, down for white)?
- */
-
-
-struct Quoridor_move : public MCTS_move {
-    short int x, y;
-    char player;
-    char type;         // 'h'/'v' -> horizontal/vertical wall, ' ' or other for move
-    Quoridor_move(short int x, short int y, char p, char t) : x(x), y(y), player(p), type(t) { }
-    bool operator==(const MCTS_move& other) const override {
-        const Quoridor_move &o = (const Quoridor_move &) other;
-        return x == o.x && y == o.y && player == o.player && type == o.type;
-    }
-    string sprint() const override {
-        string movetype = (type == 'h') ? "places horizontal wall at" : (type == 'v') ? "places vertical wall at" : "moves to";
-        string playerstr = (player == 'W') ? "White" : "Black";
-        return playerstr + " " + movetype + " " + string(1, (char) ('A' + y)) + to_string(x + 1);
-    }
-};
-
-
-class Quoridor_state : public MCTS_state {
-    /** white's and black's coordinates on the board */
-    short int wx, wy, bx, by;
-    /** white's and black's remaining number of walls */
-    short int wwallsno, bwallsno;
-    /** Effectively a look-up table:
-     * ' ', 'h', 'v', 'b' for empty, horizontal, vertical and both walls in the right and bottom part of a cell */
-    char walls[9][9]{};
-    bool wall_connections[8][8]{};    // Note: can be a bitmap to save up space (bools are 1 byte = 8 bits)
-    /** Whose turn it is to play: 'W' or 'B' */
-    char turn;
-    /** Keep track of the distance from each player to each square while
-     * taking account for any walls */
-    short int **wdists;
-    short int **bdists;
-    /** moves played */
-    unsigned int move_counter;
-    /** randomness for rollouts */
-    static default_random_engine generator;
-    //////////////////////////////////////////
-    char change_turn() { turn = (turn == 'W') ? 'B' : 'W'; return turn; }
-    bool horizontal_wall(short int x, short int y) const { return walls[x][y] == 'h' || walls[x][y] == 'b'; }
-    bool vertical_wall(short int x, short int y) const { return walls[x][y] == 'v' || walls[x][y] == 'b'; }
-    void add_wall(short int x, short int y, bool horizontal);
-    void remove_wall(short int x, short int y, bool horizontal);
-    bool legal_step(short int x, short int y, char p) const;
-    bool legal_wall(short int x, short int y, char p, bool horizontal, bool check_blocking = true);
-    short int **calculate_dists_from(short int x, short int y, bool stop_at_goal, char player);
-    static void reset_dists(short int **&dists);
-public:
-    Quoridor_state();
-    Quoridor_state(const Quoridor_state &other);
-    ~Quoridor_state() override;
-    char whose_turn() const { return turn; }
-    unsigned int get_number_of_turns() const { return move_counter; }
-    char check_winner() const;
-    short int remaining_walls(char p) const { return (p == 'W') ? wwallsno : bwallsno; }
-    bool legal_move(const Quoridor_move *move);
-    bool play_move(const Quoridor_move *move);
-    int get_shortest_path(char player, const Quoridor_move *extra_wall_move = NULL, short int posx = -1, short int posy = -1);
-    forward_list<MCTS_move *> get_legal_step_moves(char p) const;
-    vector<MCTS_move *> get_legal_step_moves2(char p) const;
-    Quoridor_move *get_best_step_move(char player);
-    /** Heuristics **/
-    queue<MCTS_move *> *generate_good_moves();
-    queue<MCTS_move *> *generate_all_moves();
-    friend bool force_playwall(Quoridor_state &s);
-    friend Quoridor_move *pick_semirandom_move(Quoridor_state &s, std::uniform_real_distribution<double> &dist, std::default_random_engine &gen);
-    friend double evaluate_position(Quoridor_state &s, bool cheap);
-    /** Overrides: **/
-    bool is_terminal() const override;
-    MCTS_state *next_state(const MCTS_move *move) const override;
-    MCTS_state *clone() const override;
-    queue<MCTS_move *> *actions_to_try() const override;
-    double rollout() const override;                        // the rollout simulation in MCTS
-    void print() const override;
-    bool is_self_side_turn() const override { return turn == 'W'; }
-};
-
-
-#endif
+#ifndef MCTS_QUORIDOR_H
+#define MCTS_QUORIDOR_H
+
+#include "../../mcts/include/state.h"
+#include <forward_list>
+#include <random>
+#include <cstdint>
+
+
+/** TODOs-Ideas:
+ * - If all I need is the shortest path to a goal state then A* search could be faster than BFS with a heuristic
+ * that prioritizes moves towards the endzone (i.e. up for black, down for white)?
+ */
+
+
+struct Quoridor_move : public MCTS_move {
+    short int x, y;
+    char player;
+    char type;         // 'h'/'v' -> horizontal/vertical wall, ' ' or other for move
+    Quoridor_move(short int x, short int y, char p, char t) : x(x), y(y), player(p), type(t) { }
+    bool operator==(const MCTS_move& other) const override {
+        const Quoridor_move &o = (const Quoridor_move &) other;
+        return x == o.x && y == o.y && player == o.player && type == o.type;
+    }
+    string sprint() const override {
+        string movetype = (type == 'h') ? "places horizontal wall at" : (type == 'v') ? "places vertical wall at" : "moves to";
+        string playerstr = (player == 'W') ? "White" : "Black";
+        return playerstr + " " + movetype + " " + string(1, (char) ('A' + y)) + to_string(x + 1);
+    }
+    vector<double> to_numpy() const override {
+        // [x, y, player (1 for white), type (0 step, 1 horizontal, 2 vertical)]
+        return {(double) x, (double) y, (player == 'W') ? 1.0 : 0.0, (type == 'h') ? 1.0 : (type == 'v') ? 2.0 : 0.0};
+    }
+    vector<int> to_env_action() const override {
+        return {x, y, (player == 'W') ? 1 : 0, (type == 'h') ? 1 : (type == 'v') ? 2 : 0};
+    }
+};
+
+
+/** Board size and number of walls per player are compile-time parameters so that the
+ * BFS, the wall grids and the move loops all get specialized for a given variant.
+ * Only the variants typedef'd at the bottom of this file are instantiated (in Quoridor.cpp).
+ */
+template <int BOARD_SIZE, int NUM_WALLS>
+class Generic_Quoridor_state;
+
+template <int BOARD_SIZE, int NUM_WALLS>
+bool force_playwall(Generic_Quoridor_state<BOARD_SIZE, NUM_WALLS> &s);
+template <int BOARD_SIZE, int NUM_WALLS>
+Quoridor_move *pick_semirandom_move(Generic_Quoridor_state<BOARD_SIZE, NUM_WALLS> &s, std::uniform_real_distribution<double> &dist, std::default_random_engine &gen);
+template <int BOARD_SIZE, int NUM_WALLS>
+double evaluate_position(Generic_Quoridor_state<BOARD_SIZE, NUM_WALLS> &s, bool cheap);
+
+
+template <int BOARD_SIZE, int NUM_WALLS>
+class Generic_Quoridor_state : public MCTS_state {
+public:
+    static const short int N = BOARD_SIZE;           // squares per side
+    static const short int WN = BOARD_SIZE - 1;      // wall slots per side
+    static const short int WALLS = NUM_WALLS;        // walls per player at the start
+    static const short int WALL_WORDS = (WN * WN + 63) / 64;     // 64-bit words per wall bitmap
+private:
+    /** Wall centers as bitmaps, bit (x * WN + y) set if a wall is centered at the bottom-right corner of cell (x, y).
+     * A horizontal wall there covers the bottom of cells (x, y) and (x, y + 1), a vertical one covers the right
+     * side of cells (x, y) and (x + 1, y). Everything else (segments, crossings) is derived from these. */
+    uint64_t hwalls[WALL_WORDS];
+    uint64_t vwalls[WALL_WORDS];
+    /** moves played */
+    unsigned int move_counter;
+    /** Cached shortest path of each player to their goal row (PATH_UNKNOWN until computed, < 0 if blocked) */
+    short int wpath, bpath;
+    /** white's and black's coordinates on the board */
+    signed char wx, wy, bx, by;
+    /** white's and black's remaining number of walls */
+    signed char wwallsno, bwallsno;
+    /** Whose turn it is to play: 'W' or 'B' */
+    char turn;
+    /** randomness for rollouts */
+    static default_random_engine generator;
+    static const short int PATH_UNKNOWN = -2;
+    //////////////////////////////////////////
+    static bool test_bit(const uint64_t *bits, int i) { return (bits[i >> 6] >> (i & 63)) & 1; }
+    static void set_bit(uint64_t *bits, int i) { bits[i >> 6] |= ((uint64_t) 1) << (i & 63); }
+    static void clear_bit(uint64_t *bits, int i) { bits[i >> 6] &= ~(((uint64_t) 1) << (i & 63)); }
+    char change_turn() { turn = (turn == 'W') ? 'B' : 'W'; return turn; }
+    bool horizontal_wall(short int x, short int y) const {      // wall below cell (x, y)
+        if (x < 0 || x >= WN || y < 0 || y >= N) return false;
+        return (y < WN && test_bit(hwalls, x * WN + y)) || (y > 0 && test_bit(hwalls, x * WN + y - 1));
+    }
+    bool vertical_wall(short int x, short int y) const {        // wall right of cell (x, y)
+        if (x < 0 || x >= N || y < 0 || y >= WN) return false;
+        return (x < WN && test_bit(vwalls, x * WN + y)) || (x > 0 && test_bit(vwalls, (x - 1) * WN + y));
+    }
+    bool wall_connection(short int x, short int y) const {      // some wall is centered at (x, y)
+        if (x < 0 || x >= WN || y < 0 || y >= WN) return false;
+        return test_bit(hwalls, x * WN + y) || test_bit(vwalls, x * WN + y);
+    }
+    void add_wall(short int x, short int y, bool horizontal) { set_bit(horizontal ? hwalls : vwalls, x * WN + y); }
+    void remove_wall(short int x, short int y, bool horizontal) { clear_bit(horizontal ? hwalls : vwalls, x * WN + y); }
+    bool legal_step(short int x, short int y, char p) const;
+    bool legal_wall(short int x, short int y, char p, bool horizontal, bool check_blocking = true);
+    short int shortest_path_from(short int x, short int y, char player) const;
+public:
+    Generic_Quoridor_state();
+    /** No heap members: copying (clone, next_state, rollouts) is a plain member-wise copy **/
+    char whose_turn() const { return turn; }
+    unsigned int get_number_of_turns() const { return move_counter; }
+    char check_winner() const;
+    short int remaining_walls(char p) const { return (p == 'W') ? wwallsno : bwallsno; }
+    bool legal_move(const Quoridor_move *move);
+    bool play_move(const Quoridor_move *move);
+    int get_shortest_path(char player, const Quoridor_move *extra_wall_move = NULL, short int posx = -1, short int posy = -1);
+    forward_list<MCTS_move *> get_legal_step_moves(char p) const;
+    vector<MCTS_move *> get_legal_step_moves2(char p) const;
+    Quoridor_move *get_best_step_move(char player);
+    /** Heuristics **/
+    queue<MCTS_move *> *generate_good_moves();
+    queue<MCTS_move *> *generate_all_moves();
+    friend bool force_playwall<>(Generic_Quoridor_state &s);
+    friend Quoridor_move *pick_semirandom_move<>(Generic_Quoridor_state &s, std::uniform_real_distribution<double> &dist, std::default_random_engine &gen);
+    friend double (::evaluate_position<>)(Generic_Quoridor_state &s, bool cheap);
+    /** Overrides: **/
+    bool is_terminal() const override;
+    MCTS_state *next_state(const MCTS_move *move) const override;
+    MCTS_state *clone() const override;
+    queue<MCTS_move *> *actions_to_try() const override;
+    double rollout() const override;                        // the rollout simulation in MCTS
+    void print() const override;
+    bool is_self_side_turn() const override { return turn == 'W'; }
+    MCTS_move *winning_move() const override;               // a step onto the goal row
+    MCTS_move *blocking_move() const override;              // a wall that leaves the enemy no step onto its goal row
+    // Saved trees (MCTS_tree::save() with states): board size, walls, pawns, wall counts, move counter and turn
+    bool serialize(string &out) const override;
+    MCTS_state *deserialize(const char *data, size_t size) const override;
+};
+
+
+/** Instantiated variants **/
+typedef Generic_Quoridor_state<5, 3>   Quoridor5_state;     // reduced board for fast regression play
+typedef Generic_Quoridor_state<7, 6>   Quoridor7_state;
+typedef Generic_Quoridor_state<9, 10>  Quoridor_state;      // standard game
+typedef Generic_Quoridor_state<11, 14> Quoridor11_state;    // stress tests
+
+/** States are copied on every expansion and rollout so keep them within a cache line **/
+static_assert(sizeof(Quoridor_state) <= 64, "Quoridor_state should fit in 64 bytes");
+static_assert(sizeof(Quoridor11_state) <= 64, "Quoridor11_state should fit in 64 bytes");
+
+
+#endif
@@ -0,0 +1,82 @@
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include "Quoridor.h"
+#include "../../mcts/include/mcts.h"
+#include "../../mcts/include/OpeningBook.h"
+
+
+/** Merges Quoridor search trees into an opening book (make QuoridorBook -> quoridor_book):
+ *   quoridor_book [-d depth] [-m min_visits] book.bin game1.tree game2.tree ...
+ * The trees are files of MCTS_tree::save() (e.g. from the "savetrees" command of quoridor) of the starting position
+ * or saved with states. An existing book is merged into the new one, so books accumulate over many runs. Use the
+ * book with the "book" command of quoridor or MCTS_agent::set_opening_book(). */
+
+/** BOARD VARIANT (as in main.cpp) **/
+#ifndef QUORIDOR_SIZE
+#define QUORIDOR_SIZE 9
+#endif
+#if QUORIDOR_SIZE == 5
+typedef Quoridor5_state Game_state;
+#elif QUORIDOR_SIZE == 7
+typedef Quoridor7_state Game_state;
+#elif QUORIDOR_SIZE == 11
+typedef Quoridor11_state Game_state;
+#else
+typedef Quoridor_state Game_state;
+#endif
+
+#define DEFAULT_DEPTH 8          // plies below the roots of the trees
+#define DEFAULT_MIN_VISITS 100   // nodes searched less than this are left out
+
+
+int main(int argc, char **argv) {
+    int depth = DEFAULT_DEPTH;
+    unsigned int min_visits = DEFAULT_MIN_VISITS;
+    int i = 1;
+    for ( ; i + 1 < argc && argv[i][0] == '-' ; i += 2) {
+        if (strcmp(argv[i], "-d") == 0) depth = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-m") == 0) min_visits = (unsigned int) atoi(argv[i + 1]);
+        else break;
+    }
+    if (argc - i < 2 || argv[i][0] == '-') {
+        cerr << "Usage: " << argv[0] << " [-d depth (" << DEFAULT_DEPTH << ")] [-m min_visits (" << DEFAULT_MIN_VISITS
+             << ")] book tree..." << endl;
+        return 1;
+    }
+    const string book_path = argv[i++];
+    OpeningBookBuilder builder;
+    string error;
+    FILE *existing = fopen(book_path.c_str(), "rb");
+    if (existing != NULL) {
+        fclose(existing);
+        OpeningBook *book = OpeningBook::open(book_path, error);
+        if (book == NULL) {
+            cerr << "Error: " << error << endl;
+            return 1;
+        }
+        builder.add_book(*book);
+        cout << book_path << ": " << book->get_size() << " positions" << endl;
+        delete book;
+    }
+    for ( ; i < argc ; i++) {
+        MCTS_tree *tree = MCTS_tree::load(argv[i], new Game_state(), error);
+        if (tree == NULL) {
+            cerr << "Warning: Skipping " << argv[i] << ": " << error << endl;
+            continue;
+        }
+        if (!builder.add_tree(*tree, depth, min_visits, error)) {
+            cerr << "Error: " << error << endl;
+            delete tree;
+            return 1;
+        }
+        cout << argv[i] << ": " << tree->get_size() << " nodes" << endl;
+        delete tree;
+    }
+    if (!builder.write(book_path, error)) {
+        cerr << "Error: " << error << endl;
+        return 1;
+    }
+    cout << "Wrote " << builder.get_size() << " positions to " << book_path << endl;
+    return 0;
+}
@@ -1,206 +1,267 @@
-#include <iostream>
-#include "Quoridor.h"
-#include "../../mcts/include/mcts.h"
-
-/** AI PARAMETERS **/
-#define MAXITER 20000
-#define MAXSECONDS 15
-
-#define PROMPT "> "
-
-const string commands = R"(Valid commands are:
-  quit or q                         -- exits program
-  help                              -- lists commands
-  autoprint                         -- toggles automatic printing of the board after every command (initially true)
-  winner                            -- check if there is a winner yet and who
-  showboard or print                -- prints board
-  playmove or m <col><row>          -- plays a move for current player
-  playwall or w <type> <col><row>   -- places a wall for current player
-  genmove                           -- generates move for current player using MCTS
-  clearboard or reset               -- resets the board)";
-
-
-char parse_type(const string &s) {
-    if (s == "H" || s == "h" || s == "Horizontal" || s == "horizontal" || s == "HORIZONTAL") return 'h';
-    if (s == "V" || s == "v" || s == "Vertical" || s == "vertical" || s == "VERTICAL") return 'v';
-    return 0x00;
-}
-
-bool parse_coords(const string &s, int &x, int &y) {
-    if (s.size() == 2) {
-        y = toupper((char) s[0]) - 'A';
-        x = ((char) s[1]) - '1';
-        if (x >= 0 && x < 9 && y >= 0 && y < 9) return true;
-    }
-    return false;
-}
-
-
-int main() {
-    /** Important to set seed once. Quoridor_state won't do this! (TODO) **/
-    srand(time(NULL));
-
-    cout << "============================================================" << endl
-         << "===============╣    Welcome to Quoridor!    ╠===============" << endl
-         << "============================================================" << endl << endl;
-    cout << commands << endl << endl;
-
-    Quoridor_state *state = new Quoridor_state();
-    string command;
-    char winner = ' ';
-    bool auto_print = true;
-    if (auto_print) {
-        state->print();
-    }
-    /** Game Tree for AI (works for both sides) **/
-    MCTS_tree *game_tree = new MCTS_tree(new Quoridor_state());    // Important: do not use the same state that we change in main loop
-
-    cout << (state->whose_turn() == 'W' ? "White's move:" : "Black's move:") << endl << PROMPT;
-    flush(cout);
-    while (cin >> command) {
-        if (command == "q" || command == "quit"){
-            cout << "Exiting..." << endl;
-            break;
-        }
-        else if (command == "listcommands" || command == "help") {
-            cout << commands << endl;
-        }
-        else if (command == "autoprint") {
-            auto_print = !auto_print;        // toggle
-        }
-        else if (command == "winner") {
-            winner = state->check_winner();
-            cout << ((winner != ' ') ? "TRUE " : "FALSE ") << winner << endl;
-        }
-        else if (command == "showboard" || command == "print") {
-            state->print();
-        }
-        else if (command == "playmove" || command == "m") {
-            if (winner != ' ') {
-                cin.ignore(512, '\n');
-                cout << "Game has already finished." << endl << endl;
-            } else {
-                string coords;
-                cin >> coords;
-                int x, y;
-                char p = state->whose_turn();
-                bool succ = parse_coords(coords, x, y);
-                if (!succ) {
-                    cout << "Invalid command: Invalid arguments" << endl << endl;
-                } else {
-                    // play the move
-                    Quoridor_move move(x, y, p, ' ');
-                    succ = state->play_move(&move);
-                    if (succ) {
-                        cout << move.sprint() << endl << endl;
-                        // check if winning move
-                        winner = state->check_winner();
-                        // advance game tree
-                        game_tree->advance_tree(&move);
-                    }
-                }
-            }
-        }
-        else if (command == "playwall" || command == "w") {
-            if (winner != ' ') {
-                cin.ignore(512, '\n');
-                cout << "Game has already finished." << endl << endl;
-            } else {
-                string type, coords;
-                cin >> type >> coords;
-                char p = state->whose_turn();
-                char t = parse_type(type);
-                int x, y;
-                bool succ = parse_coords(coords, x, y);
-                if (t == 0x00 || !succ) {
-                    cout << "Invalid command: Invalid arguments" << endl << endl;
-                } else {
-                    // play the move
-                    Quoridor_move move(x, y, p, t);
-                    succ = state->play_move(&move);
-                    if (succ) {
-                        cout << move.sprint() << endl << endl;
-                        // advance game tree
-                        game_tree->advance_tree(&move);
-                    }
-                }
-            }
-        }
-        else if (command == "genmove") {    // generate AI move
-            if (winner != ' ') {
-                cin.ignore(512, '\n');
-                cout << "Game has already finished." << endl << endl;
-            } else {
-                // determine "thinking time" required
-                double max_seconds = MAXSECONDS;
-                if (state->remaining_walls(state->whose_turn()) == 0) {
-                    // if can't play a wall then there isn't much to think about
-                    max_seconds = (max_seconds >= 5) ? 2.5 : max_seconds / 2;
-                } else if (state->remaining_walls(state->whose_turn() == 'W' ? 'B' : 'W') == 0) {
-                    // if enemy can't play a wall then less thinking is probably required as well
-                    max_seconds = 0.75 * max_seconds;
-                }
-
-                // grow tree by thinking ahead and sampling monte carlo rollouts
-                game_tree->grow_tree(MAXITER, max_seconds);
-                game_tree->print_stats();   // debug
-
-                // select best child node at root level
-                MCTS_node *best_child = game_tree->select_best_child();
-                if (best_child == NULL) {
-                    cerr << "Warning: Could not find best child. Tree has no children? Possible terminal node" << endl << endl;
-                }
-                const Quoridor_move *best_move = (const Quoridor_move *) best_child->get_move();
-
-                // advance the tree so the selected child node is now the root
-                game_tree->advance_tree(best_move);
-
-                // play AI move
-                bool succ = state->play_move(best_move);
-                if (!succ) {
-                    cerr << "Warning: AI generated illegal move: " <<  best_move->sprint() << endl << endl;
-                } else {
-                    // print AI's move
-                    cout << best_move->sprint() << endl << endl;
-                }
-
-                // check if winning move
-                winner = state->check_winner();
-            }
-        } else if (command == "stats") {
-            game_tree->print_stats();
-        }
-        else if (command == "clearboard" || command == "reset") {
-            delete state;
-            state = new Quoridor_state();
-            delete game_tree;
-            game_tree = new MCTS_tree(new Quoridor_state());
-        }
-        else if (command == "rollout") {   // for debug
-            double res = 0.0;
-            int num;
-            cin >> num;
-            for (int i = 0 ; i < num ; i++) {
-                res += state->rollout();
-            }
-            double score = res / num;
-            cout << "Rollout average score: " << setprecision(4) << 100.0 * score << endl;
-        }
-        else {
-            cout << "? unknown command" << endl << endl;
-        }
-        // before reading next command
-        if (auto_print) {
-            state->print();
-        }
-        if (winner == 'W' || winner == 'B') {
-            cout << endl << ((winner == 'W') ? "White" : "Black") << " has won the game!" << endl << endl;
-        }
-        cout << (state->whose_turn() == 'W' ? "White's move:" : "Black's move:") << endl << PROMPT;
-        flush(cout);
-    }
-    delete state;
-    delete game_tree;
-    return 0;
-}
-
+#include <iostream>
+#include "Quoridor.h"
+#include "../../mcts/include/mcts.h"
+#include "../../mcts/include/OpeningBook.h"
+#include "../Benchmark.h"
+
+/** AI PARAMETERS **/
+#define MAXITER 20000
+#define MAXSECONDS 15
+#define BOOK_SEED_VISITS 5000    // at most this many simulations of the opening book are seeded into the root
+
+#define PROMPT "> "
+
+/** BOARD VARIANT (build with -DQUORIDOR_SIZE=5, 7 or 11 for the other instantiated variants) **/
+#ifndef QUORIDOR_SIZE
+#define QUORIDOR_SIZE 9
+#endif
+#if QUORIDOR_SIZE == 5
+typedef Quoridor5_state Game_state;
+#elif QUORIDOR_SIZE == 7
+typedef Quoridor7_state Game_state;
+#elif QUORIDOR_SIZE == 11
+typedef Quoridor11_state Game_state;
+#else
+typedef Quoridor_state Game_state;
+#endif
+
+const string commands = R"(Valid commands are:
+  quit or q                         -- exits program
+  help                              -- lists commands
+  autoprint                         -- toggles automatic printing of the board after every command (initially true)
+  winner                            -- check if there is a winner yet and who
+  showboard or print                -- prints board
+  playmove or m <col><row>          -- plays a move for current player
+  playwall or w <type> <col><row>   -- places a wall for current player
+  genmove                           -- generates move for current player using MCTS
+  clearboard or reset               -- resets the board
+  savetrees <prefix>                -- saves the search tree of every following genmove as <prefix><n>.tree (for quoridor_book)
+  book <file>                       -- consults an opening book built by quoridor_book before every genmove
+  bench <n>                         -- measures clone, expansion, rollout and tree search throughput)";
+
+
+char parse_type(const string &s) {
+    if (s == "H" || s == "h" || s == "Horizontal" || s == "horizontal" || s == "HORIZONTAL") return 'h';
+    if (s == "V" || s == "v" || s == "Vertical" || s == "vertical" || s == "VERTICAL") return 'v';
+    return 0x00;
+}
+
+bool parse_coords(const string &s, int &x, int &y) {
+    if (s.size() == 2 || (s.size() == 3 && isdigit(s[2]))) {
+        y = toupper((char) s[0]) - 'A';
+        x = atoi(s.c_str() + 1) - 1;
+        if (x >= 0 && x < Game_state::N && y >= 0 && y < Game_state::N) return true;
+    }
+    return false;
+}
+
+
+int main() {
+    /** Important to set seed once. Quoridor_state won't do this! (TODO) **/
+    srand(time(NULL));
+
+    cout << "============================================================" << endl
+         << "===============╣    Welcome to Quoridor!    ╠===============" << endl
+         << "============================================================" << endl << endl;
+    cout << commands << endl << endl;
+
+    Game_state *state = new Game_state();
+    string command;
+    char winner = ' ';
+    bool auto_print = true;
+    if (auto_print) {
+        state->print();
+    }
+    /** Game Tree for AI (works for both sides) **/
+    MCTS_tree *game_tree = new MCTS_tree(new Game_state());    // Important: do not use the same state that we change in main loop
+    OpeningBook *book = NULL;
+    string tree_prefix;                 // where genmove saves its search trees (empty -> nowhere)
+    int saved_trees = 0;
+
+    cout << (state->whose_turn() == 'W' ? "White's move:" : "Black's move:") << endl << PROMPT;
+    flush(cout);
+    while (cin >> command) {
+        if (command == "q" || command == "quit"){
+            cout << "Exiting..." << endl;
+            break;
+        }
+        else if (command == "listcommands" || command == "help") {
+            cout << commands << endl;
+        }
+        else if (command == "autoprint") {
+            auto_print = !auto_print;        // toggle
+        }
+        else if (command == "winner") {
+            winner = state->check_winner();
+            cout << ((winner != ' ') ? "TRUE " : "FALSE ") << winner << endl;
+        }
+        else if (command == "showboard" || command == "print") {
+            state->print();
+        }
+        else if (command == "playmove" || command == "m") {
+            if (winner != ' ') {
+                cin.ignore(512, '\n');
+                cout << "Game has already finished." << endl << endl;
+            } else {
+                string coords;
+                cin >> coords;
+                int x, y;
+                char p = state->whose_turn();
+                bool succ = parse_coords(coords, x, y);
+                if (!succ) {
+                    cout << "Invalid command: Invalid arguments" << endl << endl;
+                } else {
+                    // play the move
+                    Quoridor_move move(x, y, p, ' ');
+                    succ = state->play_move(&move);
+                    if (succ) {
+                        cout << move.sprint() << endl << endl;
+                        // check if winning move
+                        winner = state->check_winner();
+                        // advance game tree
+                        game_tree->advance_tree(&move);
+                    }
+                }
+            }
+        }
+        else if (command == "playwall" || command == "w") {
+            if (winner != ' ') {
+                cin.ignore(512, '\n');
+                cout << "Game has already finished." << endl << endl;
+            } else {
+                string type, coords;
+                cin >> type >> coords;
+                char p = state->whose_turn();
+                char t = parse_type(type);
+                int x, y;
+                bool succ = parse_coords(coords, x, y);
+                if (t == 0x00 || !succ) {
+                    cout << "Invalid command: Invalid arguments" << endl << endl;
+                } else {
+                    // play the move
+                    Quoridor_move move(x, y, p, t);
+                    succ = state->play_move(&move);
+                    if (succ) {
+                        cout << move.sprint() << endl << endl;
+                        // advance game tree
+                        game_tree->advance_tree(&move);
+                    }
+                }
+            }
+        }
+        else if (command == "genmove") {    // generate AI move
+            if (winner != ' ') {
+                cin.ignore(512, '\n');
+                cout << "Game has already finished." << endl << endl;
+            } else {
+                // determine "thinking time" required
+                double max_seconds = MAXSECONDS;
+                if (state->remaining_walls(state->whose_turn()) == 0) {
+                    // if can't play a wall then there isn't much to think about
+                    max_seconds = (max_seconds >= 5) ? 2.5 : max_seconds / 2;
+                } else if (state->remaining_walls(state->whose_turn() == 'W' ? 'B' : 'W') == 0) {
+                    // if enemy can't play a wall then less thinking is probably required as well
+                    max_seconds = 0.75 * max_seconds;
+                }
+
+                // start from what earlier searches found and play known positions right away
+                MCTS_node *best_child = NULL;
+                if (book != NULL) {
+                    unsigned int book_visits;
+                    MCTS_node *book_child = book->seed(*game_tree, BOOK_SEED_VISITS, book_visits);
+                    if (book_visits >= MAXITER) best_child = book_child;
+                }
+
+                if (best_child == NULL) {
+                    // grow tree by thinking ahead and sampling monte carlo rollouts
+                    game_tree->grow_tree(MAXITER, max_seconds);
+                    game_tree->print_stats();   // debug
+
+                    // select best child node at root level
+                    best_child = game_tree->select_best_child();
+
+                    // keep the search for opening books (with states: the tree's root is not the starting position)
+                    string error;
+                    if (!tree_prefix.empty() && !game_tree->save(tree_prefix + to_string(saved_trees++) + ".tree", true, error)) {
+                        cerr << "Warning: Could not save tree: " << error << endl;
+                    }
+                }
+                if (best_child == NULL) {
+                    cerr << "Warning: Could not find best child. Tree has no children? Possible terminal node" << endl << endl;
+                }
+                const Quoridor_move *best_move = (const Quoridor_move *) best_child->get_move();
+
+                // advance the tree so the selected child node is now the root
+                game_tree->advance_tree(best_move);
+
+                // play AI move
+                bool succ = state->play_move(best_move);
+                if (!succ) {
+                    cerr << "Warning: AI generated illegal move: " <<  best_move->sprint() << endl << endl;
+                } else {
+                    // print AI's move
+                    cout << best_move->sprint() << endl << endl;
+                }
+
+                // check if winning move
+                winner = state->check_winner();
+            }
+        } else if (command == "stats") {
+            game_tree->print_stats();
+        }
+        else if (command == "clearboard" || command == "reset") {
+            delete state;
+            state = new Game_state();
+            delete game_tree;
+            game_tree = new MCTS_tree(new Game_state());
+        }
+        else if (command == "savetrees") {
+            cin >> tree_prefix;
+            saved_trees = 0;
+        }
+        else if (command == "book") {
+            string path, error;
+            cin >> path;
+            OpeningBook *opened = OpeningBook::open(path, error);
+            if (opened == NULL) {
+                cout << "Could not open book: " << error << endl << endl;
+            } else {
+                delete book;
+                book = opened;
+                cout << book->get_size() << " positions" << endl << endl;
+            }
+        }
+        else if (command == "rollout") {   // for debug
+            double res = 0.0;
+            int num;
+            cin >> num;
+            for (int i = 0 ; i < num ; i++) {
+                res += state->rollout();
+            }
+            double score = res / num;
+            cout << "Rollout average score: " << setprecision(4) << 100.0 * score << endl;
+        }
+        else if (command == "bench") {     // for debug: clone, expansion, rollout and search throughput from the current state
+            int num;
+            cin >> num;
+            benchmark_state(*state, num, MAXSECONDS);
+        }
+        else {
+            cout << "? unknown command" << endl << endl;
+        }
+        // before reading next command
+        if (auto_print) {
+            state->print();
+        }
+        if (winner == 'W' || winner == 'B') {
+            cout << endl << ((winner == 'W') ? "White" : "Black") << " has won the game!" << endl << endl;
+        }
+        cout << (state->whose_turn() == 'W' ? "White's move:" : "Black's move:") << endl << PROMPT;
+        flush(cout);
+    }
+    delete state;
+    delete game_tree;
+    delete book;
+    return 0;
+}
+
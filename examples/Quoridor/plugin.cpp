@@ -0,0 +1,16 @@
+#include "Quoridor.h"
+#include "../../mcts/include/GamePlugin.h"
+
+
+/** Quoridor as a game plugin (make QuoridorPlugin -> quoridor_plugin.so), e.g. for pymcts.load_game().
+ * The options select the board: "5", "7", "9" (default) or "11", i.e. the variants typedef'd in Quoridor.h */
+static MCTS_state *create_quoridor(const char *options) {
+    string size = (options != NULL) ? options : "";
+    if (size.empty() || size == "9") return new Quoridor_state();
+    if (size == "5") return new Quoridor5_state();
+    if (size == "7") return new Quoridor7_state();
+    if (size == "11") return new Quoridor11_state();
+    return NULL;
+}
+
+MCTS_EXPORT_GAME("Quoridor", "Quoridor; options: board size 5, 7, 9 (default) or 11", create_quoridor)
@@ -1,332 +1,493 @@
-#include <iostream>
-#include "TicTacToe.h"
-#include <ctime>
-#include <string>
-#include <random>
-#include <thread>
-
-
-using namespace std;
-
-
-TicTacToe_state::TicTacToe_state() : MCTS_state(), turn('x') {
-    // initialize board as empty
-    for (int i = 0 ; i < 9 ; i++) {
-        board[i / 3][i % 3] = ' ';
-    }
-    // calculate winner
-    winner = calculate_winner();
-}
-
-TicTacToe_state::TicTacToe_state(const TicTacToe_state &other)
-        : MCTS_state(other), turn(other.turn), winner(other.winner) {
-    // copy board
-    for (int i = 0 ; i < 9 ; i++) {
-        board[i / 3][i % 3] = other.board[i / 3][i % 3];
-    }
-}
-
-bool TicTacToe_state::player_won(char player) const {
-    if (player != 'x' && player != 'o') cerr << "Warning: check winner for unknown player" << endl;
-    for (int i = 0 ; i < 3 ; i++) {
-        if (board[i][0] == player && board[i][1] == player && board[i][2] == player) return true;
-        if (board[0][i] == player && board[1][i] == player && board[2][i] == player) return true;
-    }
-    return (board[0][0] == player && board[1][1] == player && board[2][2] == player) ||
-           (board[0][2] == player && board[1][1] == player && board[2][0] == player);
-}
-
-bool TicTacToe_state::is_terminal() const {
-    return winner != ' ';
-}
-
-char TicTacToe_state::get_turn() const { return turn; }
-
-char TicTacToe_state::get_winner() const { return winner; }
-
-void TicTacToe_state::change_turn() {
-    turn = (turn == 'x') ? 'o' : 'x';
-}
-
-MCTS_state *TicTacToe_state::next_state(const MCTS_move *move) const {
-    // Note: We have to manually cast it to its correct type
-    TicTacToe_move *m = (TicTacToe_move *) move;
-    TicTacToe_state *new_state = new TicTacToe_state(*this);  // create new state from current
-    if (new_state->board[m->x][m->y] == ' ') {
-        new_state->board[m->x][m->y] = m->player;             // play move
-        new_state->winner = new_state->calculate_winner();    // check again for a winner
-        new_state->change_turn();
-    } else {
-        cerr << "Warning: Illegal move (" << m->x << ", " << m->y << ")" << endl;
-        return NULL;
-    }
-    return new_state;
-}
-
-queue<MCTS_move *> *TicTacToe_state::actions_to_try() const {
-    queue<MCTS_move *> *Q = new queue<MCTS_move *>();
-    for (int i = 0 ; i < 9 ; i++) {
-        if (board[i / 3][i % 3] == ' ') {
-            Q->push(new TicTacToe_move(i / 3, i % 3, turn));
-        }
-    }
-    return Q;
-}
-
-double TicTacToe_state::rollout() const {
-    if (is_terminal()) return (winner == 'x') ? 1.0 : (winner == 'd') ? 0.5 : 0.0;
-    // Simulate a completely random game
-    // Note: dequeue is not very efficient for random accesses but vector is not efficient for deletes
-    deque<int> available;
-    for (int i = 0 ; i < 9 ; i++){
-        if (board[i / 3][i % 3] == ' ') {
-            available.push_front(i);
-        }
-    }
-    long long r;
-    int a;
-    TicTacToe_state *curstate = (TicTacToe_state *) this;   // TODO: ignore const...
-    
-    // Thread-safe random number generation
-    static thread_local std::random_device rd;
-    static thread_local std::mt19937 gen(rd());
-    
-    bool first = true;
-    do {
-        if (available.empty()) {
-            cerr << "Warning: Ran out of available moves and state is not terminal?";
-            return 0.0;
-        }
-        std::uniform_int_distribution<> dis(0, available.size() - 1);
-        r = dis(gen);
-        a = available[r];
-        TicTacToe_move move(a / 3, a % 3, curstate->turn);
-        available.erase(available.begin() + r);    // delete from available moves
-        TicTacToe_state *old = curstate;
-        curstate = (TicTacToe_state *) curstate->next_state(&move);
-        if (!first) {
-            delete old;
-        }
-        first = false;
-    } while (!curstate->is_terminal());
-    double res = (curstate->winner == 'x') ? 1.0 : (curstate->winner == 'd') ? 0.5 : 0.0;
-    delete curstate;
-    return res;
-}
-
-double TicTacToe_state::heuristic_rollout() const {
-    if (is_terminal()) return (winner == 'x') ? 1.0 : (winner == 'd') ? 0.5 : 0.0;
-    
-    // Heuristic-guided simulation: prioritize winning, blocking, center, corners
-    deque<int> available;
-    for (int i = 0 ; i < 9 ; i++){
-        if (board[i / 3][i % 3] == ' ') {
-            available.push_front(i);
-        }
-    }
-    
-    TicTacToe_state *curstate = (TicTacToe_state *) this;
-    static thread_local std::random_device rd;
-    static thread_local std::mt19937 gen(rd());
-    
-    bool first = true;
-    do {
-        if (available.empty()) {
-            cerr << "Warning: Ran out of available moves and state is not terminal?";
-            return 0.0;
-        }
-        
-        // Find best move using heuristics
-        int best_move = find_best_heuristic_move(curstate, available);
-        
-        // Remove chosen move from available
-        for (auto it = available.begin(); it != available.end(); ++it) {
-            if (*it == best_move) {
-                available.erase(it);
-                break;
-            }
-        }
-        
-        TicTacToe_move move(best_move / 3, best_move % 3, curstate->turn);
-        TicTacToe_state *old = curstate;
-        curstate = (TicTacToe_state *) curstate->next_state(&move);
-        if (!first) {
-            delete old;
-        }
-        first = false;
-    } while (!curstate->is_terminal());
-    
-    double res = (curstate->winner == 'x') ? 1.0 : (curstate->winner == 'd') ? 0.5 : 0.0;
-    delete curstate;
-    return res;
-}
-
-int TicTacToe_state::find_best_heuristic_move(TicTacToe_state* state, const deque<int>& available) const {
-    static thread_local std::random_device rd;
-    static thread_local std::mt19937 gen(rd());
-    
-    // Priority 1: Win if possible
-    for (int pos : available) {
-        TicTacToe_move test_move(pos / 3, pos % 3, state->turn);
-        TicTacToe_state* test_state = (TicTacToe_state*)state->next_state(&test_move);
-        if (test_state->winner == state->turn) {
-            delete test_state;
-            return pos;
-        }
-        delete test_state;
-    }
-    
-    // Priority 2: Block opponent's win
-    char opponent = (state->turn == 'x') ? 'o' : 'x';
-    for (int pos : available) {
-        TicTacToe_move test_move(pos / 3, pos % 3, opponent);
-        TicTacToe_state* test_state = (TicTacToe_state*)state->next_state(&test_move);
-        if (test_state->winner == opponent) {
-            delete test_state;
-            return pos;
-        }
-        delete test_state;
-    }
-    
-    // Priority 3: Take center (position 4)
-    for (int pos : available) {
-        if (pos == 4) return pos;
-    }
-    
-    // Priority 4: Take corners (0, 2, 6, 8)
-    vector<int> corners = {0, 2, 6, 8};
-    for (int corner : corners) {
-        for (int pos : available) {
-            if (pos == corner) return pos;
-        }
-    }
-    
-    // Priority 5: Random choice from remaining
-    std::uniform_int_distribution<> dis(0, available.size() - 1);
-    return available[dis(gen)];
-}
-
-double TicTacToe_state::evaluate_move(const MCTS_move* move) const {
-    const TicTacToe_move* ttt_move = static_cast<const TicTacToe_move*>(move);
-    int pos = ttt_move->x * 3 + ttt_move->y;
-    
-    // Test if this move wins the game
-    TicTacToe_state* test_state = (TicTacToe_state*)next_state(move);
-    if (test_state->winner == turn) {
-        delete test_state;
-        return 1.0;  // Winning move
-    }
-    delete test_state;
-    
-    // Test if this move blocks opponent's win
-    char opponent = (turn == 'x') ? 'o' : 'x';
-    TicTacToe_move opponent_move(ttt_move->x, ttt_move->y, opponent);
-    TicTacToe_state* opponent_test = (TicTacToe_state*)next_state(&opponent_move);
-    if (opponent_test->winner == opponent) {
-        delete opponent_test;
-        return 0.8;  // Blocking move
-    }
-    delete opponent_test;
-    
-    // Positional preferences
-    if (pos == 4) return 0.6;  // Center
-    if (pos == 0 || pos == 2 || pos == 6 || pos == 8) return 0.4;  // Corners
-    return 0.2;  // Edges
-}
-
-double TicTacToe_state::evaluate_position() const {
-    if (is_terminal()) {
-        if (winner == 'x') return 1.0;
-        if (winner == 'o') return 0.0;
-        return 0.5;  // Draw
-    }
-    
-    // Simple evaluation: count winning opportunities
-    double x_score = count_winning_lines('x');
-    double o_score = count_winning_lines('o');
-    double total = x_score + o_score;
-    
-    if (total == 0) return 0.5;
-    return x_score / total;
-}
-
-double TicTacToe_state::count_winning_lines(char player) const {
-    double count = 0.0;
-    
-    // Check all lines (rows, columns, diagonals)
-    // Rows
-    for (int i = 0; i < 3; i++) {
-        if (can_win_line(board[i][0], board[i][1], board[i][2], player)) count += 1.0;
-    }
-    
-    // Columns
-    for (int j = 0; j < 3; j++) {
-        if (can_win_line(board[0][j], board[1][j], board[2][j], player)) count += 1.0;
-    }
-    
-    // Diagonals
-    if (can_win_line(board[0][0], board[1][1], board[2][2], player)) count += 1.0;
-    if (can_win_line(board[0][2], board[1][1], board[2][0], player)) count += 1.0;
-    
-    return count;
-}
-
-bool TicTacToe_state::can_win_line(char pos1, char pos2, char pos3, char player) const {
-    char opponent = (player == 'x') ? 'o' : 'x';
-    // A line can be won if it contains the player's pieces and no opponent pieces
-    int player_count = 0;
-    int opponent_count = 0;
-    
-    if (pos1 == player) player_count++;
-    else if (pos1 == opponent) opponent_count++;
-    
-    if (pos2 == player) player_count++;
-    else if (pos2 == opponent) opponent_count++;
-    
-    if (pos3 == player) player_count++;
-    else if (pos3 == opponent) opponent_count++;
-    
-    return opponent_count == 0;  // Can win if no opponent pieces
-}
-
-void TicTacToe_state::print() const {
-    printf(" %c | %c | %c\n---+---+---\n %c | %c | %c\n---+---+---\n %c | %c | %c\n",
-           board[0][0], board[0][1], board[0][2],
-           board[1][0], board[1][1], board[1][2],
-           board[2][0], board[2][1], board[2][2]);
-}
-
-char TicTacToe_state::calculate_winner() const {
-    if (player_won('x')) return 'x';
-    else if (player_won('o')) return 'o';
-    bool all_taken = true;
-    for (int i = 0 ; i < 9 ; i++) {
-        if (board[i / 3][i % 3] == ' ') {
-            all_taken = false;
-            break;
-        }
-    }
-    if (all_taken) return 'd';   // draw
-    else return ' ';             // no-one yet
-}
-
-bool TicTacToe_move::operator==(const MCTS_move &other) const {
-    const TicTacToe_move &o = (const TicTacToe_move &) other;        // Note: Casting necessary
-    return x == o.x && y == o.y && player == o.player;
-}
-
-std::string TicTacToe_move::sprint() const {
-    return std::string("(") + std::to_string(x) + "," + std::to_string(y) + "," + player + ")";
-}
-
-std::vector<double> TicTacToe_move::to_numpy() const {
-    // Convert move to numpy-like representation: [x, y, player_as_double]
-    double player_val = (player == 'x') ? 1.0 : 0.0;
-    return {static_cast<double>(x), static_cast<double>(y), player_val};
-}
-
-std::vector<int> TicTacToe_move::to_env_action() const {
-    // Convert move to environment action format: [x, y, player_as_int]
-    int player_val = (player == 'x') ? 1 : 0;
-    return {x, y, player_val};
-}
+#include <iostream>
+#include "TicTacToe.h"
+#include <ctime>
+#include <string>
+#include <random>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+
+
+using namespace std;
+
+
+/** The 8 lines of the board as masks over the 3 * x + y bit layout **/
+static constexpr uint16_t WIN_MASKS[8] = {
+    0x007, 0x038, 0x1C0,        // rows
+    0x049, 0x092, 0x124,        // columns
+    0x111, 0x054                // diagonals
+};
+static constexpr uint16_t CENTER = 0x010;
+static constexpr uint16_t CORNERS = 0x145;     // squares 0, 2, 6 and 8
+
+static inline int popcount9(uint16_t b) {
+#if defined(__GNUC__)
+    return __builtin_popcount(b);
+#else
+    int c = 0;
+    for ( ; b ; b &= b - 1) c++;
+    return c;
+#endif
+}
+
+static inline int lowest_bit(uint16_t b) {
+#if defined(__GNUC__)
+    return __builtin_ctz(b);
+#else
+    int i = 0;
+    while (!((b >> i) & 1)) i++;
+    return i;
+#endif
+}
+
+static inline int highest_bit(uint16_t b) {
+#if defined(__GNUC__)
+    return 31 - __builtin_clz(b);
+#else
+    int i = 15;
+    while (!((b >> i) & 1)) i--;
+    return i;
+#endif
+}
+
+/** Index of the n-th (0-based) set bit of b, n < popcount(b) **/
+static inline int nth_bit(uint16_t b, int n) {
+    while (n-- > 0) b &= b - 1;
+    return lowest_bit(b);
+}
+
+/** Symmetry group of the board: SYMMETRY[t][i] is where square i goes under transform t, where transform
+ * t = 4 * m + r mirrors the columns if m = 1 and then turns the board r quarter turns clockwise **/
+struct Board_symmetries {
+    int square[8][9];
+    int compose[8][8];
+    int inverse[8];
+    Board_symmetries() {
+        for (int t = 0 ; t < 8 ; t++) {
+            for (int i = 0 ; i < 9 ; i++) {
+                int x = i / 3, y = i % 3;
+                if (t >= 4) y = 2 - y;
+                for (int r = 0 ; r < (t & 3) ; r++) {
+                    int tmp = x;
+                    x = y;
+                    y = 2 - tmp;
+                }
+                square[t][i] = 3 * x + y;
+            }
+        }
+        for (int a = 0 ; a < 8 ; a++) {
+            for (int b = 0 ; b < 8 ; b++) {
+                for (int c = 0 ; c < 8 ; c++) {
+                    bool same = true;
+                    for (int i = 0 ; i < 9 && same ; i++) same = square[c][i] == square[b][square[a][i]];
+                    if (same) {
+                        compose[a][b] = c;
+                        break;
+                    }
+                }
+                if (compose[a][b] == 0) inverse[a] = b;
+            }
+        }
+    }
+    uint16_t apply(int t, uint16_t b) const {
+        uint16_t out = 0;
+        for ( ; b ; b &= b - 1) out |= (uint16_t) (1 << square[t][lowest_bit(b)]);
+        return out;
+    }
+};
+
+static const Board_symmetries SYMMETRIES;
+
+static inline bool has_line(uint16_t b) {
+    for (int i = 0 ; i < 8 ; i++) {
+        if ((b & WIN_MASKS[i]) == WIN_MASKS[i]) return true;
+    }
+    return false;
+}
+
+/** Lookup tables for the rollouts, indexed by the bitboard b of one player: nth[b][k] is the k-th (0-based) set
+ * bit of b, line[b] is 1 if b contains a complete line and completes[b] has the squares outside b that would
+ * complete one (intersect with the empty squares to get the immediate wins) **/
+struct Rollout_tables {
+    unsigned char nth[512][9];
+    unsigned char line[512];
+    uint16_t completes[512];
+    Rollout_tables() {
+        for (int b = 0 ; b < 512 ; b++) {
+            line[b] = has_line((uint16_t) b) ? 1 : 0;
+            completes[b] = 0;
+            for (int i = 0 ; i < 9 ; i++) {
+                uint16_t bit = (uint16_t) (1 << i);
+                if (!(b & bit) && has_line((uint16_t) (b | bit))) completes[b] |= bit;
+            }
+            for (int k = 0 ; k < 9 ; k++) {
+                nth[b][k] = (unsigned char) ((k < popcount9((uint16_t) b)) ? nth_bit((uint16_t) b, k) : 0);
+            }
+        }
+    }
+};
+
+static const Rollout_tables ROLLOUT_TABLES;
+
+
+/** Perfect play oracle: the minimax value of every position reachable from the empty board (5478 of them),
+ * stored as 2 (x wins), 1 (draw) or 0 (o wins) and indexed in base 3 with square i counting 3^i for an x and
+ * 2 * 3^i for an o. Solved by a memoized search the first time it is needed. **/
+class Perfect_play_table {
+    static const int ENTRIES = 19683;        // 3^9
+    signed char values[ENTRIES];             // -1 -> not reachable
+    int positions;
+    static int index(uint16_t x, uint16_t o) {
+        int idx = 0;
+        for (int i = 8 ; i >= 0 ; i--) {
+            idx = 3 * idx + ((x >> i) & 1) + 2 * ((o >> i) & 1);
+        }
+        return idx;
+    }
+    signed char solve(uint16_t x, uint16_t o, bool x_to_move) {
+        signed char &v = values[index(x, o)];
+        if (v >= 0) return v;
+        positions++;
+        if (has_line(x)) return v = 2;
+        if (has_line(o)) return v = 0;
+        uint16_t empty = (uint16_t) (~(x | o) & TicTacToe_state::FULL_BOARD);
+        if (!empty) return v = 1;
+        signed char best = x_to_move ? 0 : 2;
+        for ( ; empty ; empty &= empty - 1) {
+            uint16_t bit = (uint16_t) (empty & -empty);
+            signed char child = x_to_move ? solve(x | bit, o, false) : solve(x, o | bit, true);
+            best = x_to_move ? max(best, child) : min(best, child);
+        }
+        return v = best;
+    }
+public:
+    Perfect_play_table() : positions(0) {
+        for (int i = 0 ; i < ENTRIES ; i++) values[i] = -1;
+        solve(0, 0, true);
+    }
+    signed char value(uint16_t x, uint16_t o) const { return values[index(x, o)]; }
+    int size() const { return positions; }
+};
+
+static const Perfect_play_table &perfect_play() {
+    static const Perfect_play_table table;   // thread-safe lazy initialization
+    return table;
+}
+
+
+TicTacToe_state::TicTacToe_state() : MCTS_state(), xbits(0), obits(0), turn('x') {
+    // calculate winner
+    winner = calculate_winner();
+}
+
+TicTacToe_state::TicTacToe_state(const TicTacToe_state &other)
+        : MCTS_state(other), xbits(other.xbits), obits(other.obits), turn(other.turn), winner(other.winner) {
+}
+
+bool TicTacToe_state::is_terminal() const {
+    return winner != ' ';
+}
+
+char TicTacToe_state::get_turn() const { return turn; }
+
+char TicTacToe_state::get_winner() const { return winner; }
+
+void TicTacToe_state::change_turn() {
+    turn = (turn == 'x') ? 'o' : 'x';
+}
+
+MCTS_state *TicTacToe_state::next_state(const MCTS_move *move) const {
+    // Note: We have to manually cast it to its correct type
+    TicTacToe_move *m = (TicTacToe_move *) move;
+    int i = 3 * m->x + m->y;
+    if (m->x < 0 || m->x > 2 || m->y < 0 || m->y > 2 || !((empty_squares() >> i) & 1)) {
+        cerr << "Warning: Illegal move (" << m->x << ", " << m->y << ")" << endl;
+        return NULL;
+    }
+    TicTacToe_state *new_state = new TicTacToe_state(*this);  // create new state from current
+    uint16_t &own = (m->player == 'x') ? new_state->xbits : new_state->obits;
+    own |= (uint16_t) (1 << i);                               // play move
+    new_state->winner = new_state->calculate_winner();        // check again for a winner
+    new_state->change_turn();
+    return new_state;
+}
+
+queue<MCTS_move *> *TicTacToe_state::actions_to_try() const {
+    queue<MCTS_move *> *Q = new queue<MCTS_move *>();
+    for (uint16_t empty = empty_squares() ; empty ; empty &= empty - 1) {
+        int i = lowest_bit(empty);
+        Q->push(new TicTacToe_move(i / 3, i % 3, turn));
+    }
+    return Q;
+}
+
+double TicTacToe_state::rollout() const {
+    if (is_terminal()) return (winner == 'x') ? 1.0 : (winner == 'd') ? 0.5 : 0.0;
+    // Simulate a completely random game on a stack copy of the bitboards (no allocations)
+    static thread_local std::random_device rd;
+    static thread_local std::mt19937 gen(rd());
+    uint16_t own = (turn == 'x') ? xbits : obits, other = (turn == 'x') ? obits : xbits;
+    bool x_to_move = turn == 'x';
+    for (;;) {
+        uint16_t empty = (uint16_t) (~(own | other) & FULL_BOARD);
+        if (!empty) return 0.5;                                 // draw
+        std::uniform_int_distribution<> dis(0, popcount9(empty) - 1);
+        own |= (uint16_t) (1 << nth_bit(empty, dis(gen)));
+        if (has_line(own)) return x_to_move ? 1.0 : 0.0;
+        std::swap(own, other);
+        x_to_move = !x_to_move;
+    }
+}
+
+double TicTacToe_state::rollout_n(int count) const {
+    if (count <= 0) return 0.0;
+    if (is_terminal()) return count * ((winner == 'x') ? 1.0 : (winner == 'd') ? 0.5 : 0.0);
+    // Simulates LANES games side by side. Every game has the same number of empty squares at a given ply, so all
+    // lanes run the same straight-line code (xorshift RNG, table lookups, masks) which the compiler can vectorize.
+    static const int LANES = ROLLOUT_LANES;
+    static const unsigned char UNDECIDED = 0xFF;
+    static thread_local std::random_device rd;
+    static thread_local std::mt19937 gen(rd());
+    const uint16_t own0 = (turn == 'x') ? xbits : obits, other0 = (turn == 'x') ? obits : xbits;
+    const int empties = popcount9(empty_squares());
+    double sum = 0.0;
+    const int batched = count - count % LANES;              // the remaining games are played one by one
+    for (int i = batched ; i < count ; i++) sum += rollout();
+    for (int first = 0 ; first < batched ; first += LANES) {
+        uint16_t own[LANES], other[LANES];
+        uint32_t rng[LANES];
+        unsigned char won_at[LANES];                            // ply at which the game was decided
+        for (int l = 0 ; l < LANES ; l++) {
+            own[l] = own0;
+            other[l] = other0;
+            rng[l] = (uint32_t) gen() | 1u;                     // xorshift state must not be 0
+            won_at[l] = UNDECIDED;
+        }
+        for (int ply = 0 ; ply < empties ; ply++) {
+            const uint32_t n = (uint32_t) (empties - ply);
+            unsigned char pending = 0;
+            for (int l = 0 ; l < LANES ; l++) {
+                uint32_t r = rng[l];
+                r ^= r << 13;
+                r ^= r >> 17;
+                r ^= r << 5;
+                rng[l] = r;
+                uint32_t k = (uint32_t) (((uint64_t) r * n) >> 32);        // uniform in [0, n)
+                uint16_t empty = (uint16_t) (~(own[l] | other[l]) & FULL_BOARD);
+                uint16_t placed = (uint16_t) (own[l] | (1u << ROLLOUT_TABLES.nth[empty][k]));
+                unsigned char undecided = (unsigned char) (won_at[l] == UNDECIDED);
+                won_at[l] = (undecided & ROLLOUT_TABLES.line[placed]) ? (unsigned char) ply : won_at[l];
+                pending |= (unsigned char) (won_at[l] == UNDECIDED);
+                own[l] = other[l];                              // decided games keep playing harmlessly
+                other[l] = placed;
+            }
+            if (!pending) break;
+        }
+        for (int l = 0 ; l < LANES ; l++) {
+            if (won_at[l] == UNDECIDED) {
+                sum += 0.5;
+            } else {
+                bool mover_won = (won_at[l] % 2) == 0;          // even plies are played by the side to move now
+                sum += (mover_won == (turn == 'x')) ? 1.0 : 0.0;
+            }
+        }
+    }
+    return sum;
+}
+
+double TicTacToe_state::heuristic_rollout() const {
+    if (is_terminal()) return (winner == 'x') ? 1.0 : (winner == 'd') ? 0.5 : 0.0;
+    // Heuristic-guided simulation (win, block, center, corners, random) on stack copies of the bitboards
+    uint16_t own = (turn == 'x') ? xbits : obits, other = (turn == 'x') ? obits : xbits;
+    bool x_to_move = turn == 'x';
+    for (;;) {
+        if (!(~(own | other) & FULL_BOARD)) return 0.5;         // draw
+        own |= (uint16_t) (1 << find_best_heuristic_move(own, other));
+        if (ROLLOUT_TABLES.line[own]) return x_to_move ? 1.0 : 0.0;
+        std::swap(own, other);
+        x_to_move = !x_to_move;
+    }
+}
+
+int TicTacToe_state::find_best_heuristic_move(uint16_t own, uint16_t other) {
+    static thread_local std::random_device rd;
+    static thread_local std::mt19937 gen(rd());
+    const uint16_t empty = (uint16_t) (~(own | other) & FULL_BOARD);
+
+    // Priority 1: Win if possible (the highest square among several, as the rollouts always picked)
+    uint16_t candidates = ROLLOUT_TABLES.completes[own] & empty;
+    if (candidates) return highest_bit(candidates);
+
+    // Priority 2: Block opponent's win
+    candidates = ROLLOUT_TABLES.completes[other] & empty;
+    if (candidates) return highest_bit(candidates);
+
+    // Priority 3: Take center
+    if (empty & CENTER) return 4;
+
+    // Priority 4: Take corners (0, 2, 6, 8)
+    candidates = empty & CORNERS;
+    if (candidates) return lowest_bit(candidates);
+
+    // Priority 5: Random choice from remaining
+    std::uniform_int_distribution<> dis(0, popcount9(empty) - 1);
+    return nth_bit(empty, dis(gen));
+}
+
+double TicTacToe_state::evaluate_move(const MCTS_move* move) const {
+    const TicTacToe_move* ttt_move = static_cast<const TicTacToe_move*>(move);
+    int pos = ttt_move->x * 3 + ttt_move->y;
+    uint16_t bit = (uint16_t) (1 << pos);
+    uint16_t own = (turn == 'x') ? xbits : obits, other = (turn == 'x') ? obits : xbits;
+
+    // Test if this move wins the game
+    if (ROLLOUT_TABLES.completes[own] & bit) return 1.0;    // Winning move
+
+    // Test if this move blocks opponent's win
+    if (ROLLOUT_TABLES.completes[other] & bit) return 0.8;  // Blocking move
+
+    // Positional preferences
+    if (bit & CENTER) return 0.6;  // Center
+    if (bit & CORNERS) return 0.4;  // Corners
+    return 0.2;  // Edges
+}
+
+MCTS_move *TicTacToe_state::winning_move() const {
+    if (is_terminal()) return NULL;
+    uint16_t wins = ROLLOUT_TABLES.completes[(turn == 'x') ? xbits : obits] & empty_squares();
+    if (!wins) return NULL;
+    int i = lowest_bit(wins);
+    return new TicTacToe_move(i / 3, i % 3, turn);
+}
+
+MCTS_move *TicTacToe_state::blocking_move() const {
+    if (is_terminal()) return NULL;
+    uint16_t threats = ROLLOUT_TABLES.completes[(turn == 'x') ? obits : xbits] & empty_squares();
+    if (!threats) return NULL;
+    int i = lowest_bit(threats);
+    return new TicTacToe_move(i / 3, i % 3, turn);
+}
+
+double TicTacToe_state::evaluate_position() const {
+    return exact_value();
+}
+
+double TicTacToe_state::exact_value() const {
+    signed char v = perfect_play().value(xbits, obits);
+    if (v < 0) {
+        cerr << "Warning: position is not reachable in a legal game" << endl;
+        return 0.5;
+    }
+    return 0.5 * v;
+}
+
+bool TicTacToe_state::is_optimal_move(const TicTacToe_move *move) const {
+    uint16_t bit = (uint16_t) (1 << (3 * move->x + move->y));
+    if (is_terminal() || move->player != turn || !(empty_squares() & bit)) return false;
+    signed char child = (turn == 'x') ? perfect_play().value(xbits | bit, obits) : perfect_play().value(xbits, obits | bit);
+    return child == perfect_play().value(xbits, obits);
+}
+
+int TicTacToe_state::number_of_solved_positions() {
+    return perfect_play().size();
+}
+
+vector<double> TicTacToe_state::to_numpy() const {
+    vector<double> planes(9, 0.0);
+    uint16_t own = (turn == 'x') ? xbits : obits, other = (turn == 'x') ? obits : xbits;
+    for (int i = 0 ; i < 9 ; i++) {
+        planes[i] = ((own >> i) & 1) ? 1.0 : ((other >> i) & 1) ? -1.0 : 0.0;
+    }
+    return planes;
+}
+
+int TicTacToe_state::action_index(const MCTS_move *move) const {
+    const TicTacToe_move *m = (const TicTacToe_move *) move;
+    return 3 * m->x + m->y;
+}
+
+bool TicTacToe_state::serialize(string &out) const {
+    out.append(reinterpret_cast<const char *>(&xbits), sizeof(xbits));
+    out.append(reinterpret_cast<const char *>(&obits), sizeof(obits));
+    out += turn;
+    out += winner;
+    return true;
+}
+
+MCTS_state *TicTacToe_state::deserialize(const char *data, size_t size) const {
+    if (size != 2 * sizeof(uint16_t) + 2) return NULL;
+    TicTacToe_state *state = new TicTacToe_state();
+    memcpy(&state->xbits, data, sizeof(uint16_t));
+    memcpy(&state->obits, data + sizeof(uint16_t), sizeof(uint16_t));
+    state->turn = data[2 * sizeof(uint16_t)];
+    state->winner = data[2 * sizeof(uint16_t) + 1];
+    if (((state->xbits | state->obits) & ~FULL_BOARD) || (state->xbits & state->obits)
+        || (state->turn != 'x' && state->turn != 'o')) {
+        delete state;
+        return NULL;
+    }
+    return state;
+}
+
+void TicTacToe_state::print() const {
+    printf(" %c | %c | %c\n---+---+---\n %c | %c | %c\n---+---+---\n %c | %c | %c\n",
+           square(0), square(1), square(2),
+           square(3), square(4), square(5),
+           square(6), square(7), square(8));
+}
+
+char TicTacToe_state::calculate_winner() const {
+    if (has_line(xbits)) return 'x';
+    else if (has_line(obits)) return 'o';
+    if ((xbits | obits) == FULL_BOARD) return 'd';   // draw
+    else return ' ';                                  // no-one yet
+}
+
+bool TicTacToe_state::canonical_form(unsigned long long &key, int &transform) const {
+    // canonical variant: the one with the smallest (xbits, obits) pair
+    key = ((unsigned long long) xbits << 9) | obits;
+    transform = 0;
+    for (int t = 1 ; t < 8 ; t++) {
+        unsigned long long k = ((unsigned long long) SYMMETRIES.apply(t, xbits) << 9) | SYMMETRIES.apply(t, obits);
+        if (k < key) {
+            key = k;
+            transform = t;
+        }
+    }
+    return true;
+}
+
+MCTS_move *TicTacToe_state::transform_move(const MCTS_move *move, int transform) const {
+    const TicTacToe_move *m = (const TicTacToe_move *) move;
+    int i = SYMMETRIES.square[transform][3 * m->x + m->y];
+    return new TicTacToe_move(i / 3, i % 3, m->player);
+}
+
+int TicTacToe_state::compose_transforms(int first, int second) const {
+    return SYMMETRIES.compose[first][second];
+}
+
+int TicTacToe_state::inverse_transform(int transform) const {
+    return SYMMETRIES.inverse[transform];
+}
+
+bool TicTacToe_move::operator==(const MCTS_move &other) const {
+    const TicTacToe_move &o = (const TicTacToe_move &) other;        // Note: Casting necessary
+    return x == o.x && y == o.y && player == o.player;
+}
+
+std::string TicTacToe_move::sprint() const {
+    return std::string("(") + std::to_string(x) + "," + std::to_string(y) + "," + player + ")";
+}
+
+std::vector<double> TicTacToe_move::to_numpy() const {
+    // Convert move to numpy-like representation: [x, y, player_as_double]
+    double player_val = (player == 'x') ? 1.0 : 0.0;
+    return {static_cast<double>(x), static_cast<double>(y), player_val};
+}
+
+std::vector<int> TicTacToe_move::to_env_action() const {
+    // Convert move to environment action format: [x, y, player_as_int]
+    int player_val = (player == 'x') ? 1 : 0;
+    return {x, y, player_val};
+}
@@ -1,52 +1,80 @@
-#ifndef MCTS_TICTACTOE_H
-#define MCTS_TICTACTOE_H
-
-#include "../../mcts/include/state.h"
-#include <deque>
-
-using namespace std;
-
-
-class TicTacToe_state : public MCTS_state {
-    char board[3][3]{};
-    bool player_won(char player) const;
-    char calculate_winner() const;
-    char turn, winner;
-    void change_turn();
-    
-    // Heuristic helper methods
-    int find_best_heuristic_move(TicTacToe_state* state, const deque<int>& available) const;
-    double count_winning_lines(char player) const;
-    bool can_win_line(char pos1, char pos2, char pos3, char player) const;
-    
-public:
-    TicTacToe_state();
-    TicTacToe_state(const TicTacToe_state &other);
-    char get_turn() const;
-    char get_winner() const;
-    bool is_terminal() const override;
-    MCTS_state *next_state(const MCTS_move *move) const override;
-    queue<MCTS_move *> *actions_to_try() const override;
-    double rollout() const override;                        // the rollout simulation in MCTS
-    void print() const override;
-    bool is_self_side_turn() const override { return turn == 'x'; }
-    MCTS_state* clone() const override { return new TicTacToe_state(*this); }
-    
-    // Heuristic rollout methods
-    double heuristic_rollout() const override;
-    double evaluate_move(const MCTS_move* move) const override;
-    double evaluate_position() const override;
-};
-
-
-struct TicTacToe_move : public MCTS_move {
-    int x, y;
-    char player;
-    TicTacToe_move(int x, int y, char p) : x(x), y(y), player(p) {}
-    bool operator==(const MCTS_move& other) const override;
-    std::string sprint() const override;
-    std::vector<double> to_numpy() const override;
-    std::vector<int> to_env_action() const override;
-};
-
-#endif
+#ifndef MCTS_TICTACTOE_H
+#define MCTS_TICTACTOE_H
+
+#include "../../mcts/include/state.h"
+#include <cstdint>
+
+using namespace std;
+
+
+struct TicTacToe_move;
+
+class TicTacToe_state : public MCTS_state {
+    /** One bitboard per player, bit (3 * x + y) set if that player occupies square (x, y) */
+    uint16_t xbits, obits;
+    char turn, winner;
+    char square(int i) const { return ((xbits >> i) & 1) ? 'x' : ((obits >> i) & 1) ? 'o' : ' '; }
+    uint16_t empty_squares() const { return (uint16_t) (~(xbits | obits) & FULL_BOARD); }
+    char calculate_winner() const;
+    void change_turn();
+    
+    // Heuristic helper methods
+    static int find_best_heuristic_move(uint16_t own, uint16_t other);     // square for the owner of own to play
+    
+public:
+    static const uint16_t FULL_BOARD = 0x1FF;
+    static const int ROLLOUT_LANES = 16;                    // games rollout_n() simulates side by side
+    TicTacToe_state();
+    TicTacToe_state(const TicTacToe_state &other);
+    char get_turn() const;
+    char get_winner() const;
+    bool is_terminal() const override;
+    MCTS_state *next_state(const MCTS_move *move) const override;
+    queue<MCTS_move *> *actions_to_try() const override;
+    double rollout() const override;                        // the rollout simulation in MCTS
+    double rollout_n(int count) const override;             // count random games simulated in parallel lanes
+    int rollout_batch_size() const override { return ROLLOUT_LANES; }
+    void print() const override;
+    bool is_self_side_turn() const override { return turn == 'x'; }
+    MCTS_state* clone() const override { return new TicTacToe_state(*this); }
+    
+    // Heuristic rollout methods
+    double heuristic_rollout() const override;
+    double evaluate_move(const MCTS_move* move) const override;
+    double evaluate_position() const override;              // exact, see exact_value()
+    MCTS_move *winning_move() const override;
+    MCTS_move *blocking_move() const override;
+
+    // Perfect play oracle (minimax over every legal position, solved once on first use)
+    double exact_value() const;             // 1.0 if x wins, 0.5 if draw, 0.0 if o wins with perfect play from here
+    bool is_optimal_move(const TicTacToe_move *move) const;
+    static int number_of_solved_positions();
+
+    // Symmetries: the 8 rotations/reflections of the board (transform = 4 * mirrored + quarter turns)
+    bool canonical_form(unsigned long long &key, int &transform) const override;
+    MCTS_move *transform_move(const MCTS_move *move, int transform) const override;
+    int compose_transforms(int first, int second) const override;
+    int inverse_transform(int transform) const override;
+
+    // Training data: the 9 squares (1 own, -1 opponent's, 0 empty for the side to move), moves indexed 3 * x + y
+    vector<double> to_numpy() const override;
+    int action_space_size() const override { return 9; }
+    int action_index(const MCTS_move *move) const override;
+
+    // Saved trees (MCTS_tree::save() with states): the two bitboards, the turn and the winner
+    bool serialize(string &out) const override;
+    MCTS_state *deserialize(const char *data, size_t size) const override;
+};
+
+
+struct TicTacToe_move : public MCTS_move {
+    int x, y;
+    char player;
+    TicTacToe_move(int x, int y, char p) : x(x), y(y), player(p) {}
+    bool operator==(const MCTS_move& other) const override;
+    std::string sprint() const override;
+    std::vector<double> to_numpy() const override;
+    std::vector<int> to_env_action() const override;
+};
+
+#endif
@@ -0,0 +1,158 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <numeric>
+#include <cstdlib>
+#include <ctime>
+#include <chrono>
+#include "TicTacToe.h"
+#include "../../mcts/include/mcts.h"
+
+/** Measures how many iterations the engine needs to pick a perfect-play move, using TicTacToe_state's exact
+ * minimax oracle as ground truth. Every non-terminal position (up to symmetry) where some legal move is a mistake
+ * is searched from scratch with each rollout strategy; the tree is grown in steps and the first checkpoint at which
+ * the best root child (as picked by select_best_child()) is an optimal move is recorded, as well as the checkpoint
+ * after which the best child did not change any more. Random simulations are run with and without decisive moves
+ * (MCTS_node::set_decisive_moves()) to see how much playing immediate wins and blocking immediate losses helps.
+ *
+ * Before that, the raw speed of every strategy is reported as rollouts per second from the empty board, both one
+ * simulation per call and in batches of ROLLOUT_BATCH (how the engine runs rollouts_per_leaf simulations).
+ *
+ * Usage: tictactoe_bench [max_iterations (default 1000)] [repetitions per position (default 3)]
+ */
+
+const int CHECKPOINTS[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000};
+const int NUMBER_OF_CHECKPOINTS = sizeof(CHECKPOINTS) / sizeof(CHECKPOINTS[0]);
+const int ROLLOUT_BATCH = 64;
+const double SECONDS_PER_MEASUREMENT = 0.5;
+
+
+/** Simulations per second when calling MCTS_node::simulate() with batches of the given size **/
+double rollouts_per_second(const MCTS_state *state, RolloutStrategy strategy, int batch) {
+    typedef chrono::steady_clock clock;
+    long long games = 0;
+    double sink = 0.0;
+    clock::time_point start = clock::now();
+    double elapsed = 0.0;
+    while (elapsed < SECONDS_PER_MEASUREMENT) {
+        for (int i = 0 ; i < 1000 ; i++) sink += MCTS_node::simulate(state, strategy, batch);
+        games += 1000LL * batch;
+        elapsed = chrono::duration<double>(clock::now() - start).count();
+    }
+    if (sink < 0) cout << sink;              // keep the simulations from being optimized away
+    return games / elapsed;
+}
+
+
+void collect_positions(const TicTacToe_state *state, vector<unsigned long long> &seen, vector<TicTacToe_state *> &positions) {
+    unsigned long long key;
+    int transform;
+    state->canonical_form(key, transform);
+    if (find(seen.begin(), seen.end(), key) != seen.end()) return;
+    seen.push_back(key);
+    if (state->is_terminal()) return;
+    queue<MCTS_move *> *actions = state->actions_to_try();
+    bool has_mistake = false;
+    while (!actions->empty()) {
+        TicTacToe_move *move = (TicTacToe_move *) actions->front();
+        actions->pop();
+        if (!state->is_optimal_move(move)) has_mistake = true;
+        TicTacToe_state *child = (TicTacToe_state *) state->next_state(move);
+        collect_positions(child, seen, positions);
+        delete child;
+        delete move;
+    }
+    delete actions;
+    if (has_mistake) positions.push_back(new TicTacToe_state(*state));
+}
+
+
+int main(int argc, char **argv) {
+    int max_iter = (argc > 1) ? atoi(argv[1]) : 1000;
+    int repetitions = (argc > 2) ? atoi(argv[2]) : 3;
+    srand(time(NULL));
+
+    vector<unsigned long long> seen;
+    vector<TicTacToe_state *> positions;
+    TicTacToe_state start;
+    collect_positions(&start, seen, positions);
+    cout << "Oracle: " << TicTacToe_state::number_of_solved_positions() << " legal positions solved, value of the empty board: "
+         << start.exact_value() << endl
+         << "Benchmark: " << positions.size() << " positions (up to symmetry) with at least one losing move, "
+         << repetitions << " searches each, up to " << max_iter << " iterations" << endl << endl;
+
+    const RolloutStrategy strategies[] = {RolloutStrategy::RANDOM, RolloutStrategy::HEURISTIC, RolloutStrategy::MIXED};
+    const char *names[] = {"RANDOM", "HEURISTIC", "MIXED"};
+    cout << left << setw(12) << "strategy" << right << setw(16) << "rollouts/s" << setw(16)
+         << ("batch of " + to_string(ROLLOUT_BATCH)) << endl;
+    for (int s = 0 ; s < 3 ; s++) {
+        cout << left << setw(12) << names[s] << right << fixed << setprecision(0)
+             << setw(16) << rollouts_per_second(&start, strategies[s], 1)
+             << setw(16) << rollouts_per_second(&start, strategies[s], ROLLOUT_BATCH) << endl;
+    }
+    cout << endl;
+
+    // decisive rollouts only change the random simulations so HEURISTIC (which already wins and blocks) is left out
+    struct Configuration { const char *name; RolloutStrategy strategy; bool decisive; };
+    const Configuration configurations[] = {
+        {"RANDOM", RolloutStrategy::RANDOM, false},
+        {"RANDOM+D", RolloutStrategy::RANDOM, true},
+        {"HEURISTIC", RolloutStrategy::HEURISTIC, false},
+        {"MIXED", RolloutStrategy::MIXED, false},
+        {"MIXED+D", RolloutStrategy::MIXED, true}
+    };
+    const int NUMBER_OF_CONFIGURATIONS = sizeof(configurations) / sizeof(configurations[0]);
+    cout << left << setw(12) << "strategy";
+    for (int c = 0 ; c < NUMBER_OF_CHECKPOINTS && CHECKPOINTS[c] <= max_iter ; c++) cout << right << setw(8) << CHECKPOINTS[c];
+    cout << right << setw(10) << "median" << setw(14) << "mean stable" << endl;
+
+    // the engine reports on every grow_tree() call so keep it quiet while searching
+    streambuf *console = cout.rdbuf();
+    ostringstream sink;
+    for (int s = 0 ; s < NUMBER_OF_CONFIGURATIONS ; s++) {
+        MCTS_node::set_rollout_strategy(configurations[s].strategy);
+        MCTS_node::set_decisive_moves(configurations[s].decisive);
+        vector<int> solved_at(NUMBER_OF_CHECKPOINTS, 0);
+        vector<int> needed;                  // iterations needed per search (max_iter + 1 if never found)
+        vector<int> stable;                  // checkpoint from which the best move no longer changed
+        for (auto *position : positions) {
+            for (int r = 0 ; r < repetitions ; r++) {
+                cout.rdbuf(sink.rdbuf());
+                MCTS_tree tree(new TicTacToe_state(*position));
+                int done = 0, found = max_iter + 1, stable_since = 0;
+                string previous_best;
+                for (int c = 0 ; c < NUMBER_OF_CHECKPOINTS && CHECKPOINTS[c] <= max_iter ; c++) {
+                    tree.grow_tree(CHECKPOINTS[c] - done, 1e9);
+                    done = CHECKPOINTS[c];
+                    MCTS_node *best = tree.select_best_child();
+                    string best_move = (best != NULL) ? best->get_move()->sprint() : "";
+                    if (best_move != previous_best) stable_since = CHECKPOINTS[c];
+                    previous_best = best_move;
+                    if (found > max_iter && best != NULL && position->is_optimal_move((const TicTacToe_move *) best->get_move())) {
+                        found = CHECKPOINTS[c];
+                        for (int k = c ; k < NUMBER_OF_CHECKPOINTS ; k++) solved_at[k]++;
+                    }
+                }
+                sink.str("");
+                cout.rdbuf(console);
+                needed.push_back(found);
+                stable.push_back(stable_since);
+            }
+        }
+        sort(needed.begin(), needed.end());
+        cout << left << setw(12) << configurations[s].name;
+        for (int c = 0 ; c < NUMBER_OF_CHECKPOINTS && CHECKPOINTS[c] <= max_iter ; c++) {
+            cout << right << setw(7) << fixed << setprecision(1) << 100.0 * solved_at[c] / needed.size() << "%";
+        }
+        int median = needed[needed.size() / 2];
+        cout << right << setw(10) << ((median > max_iter) ? string(">") + to_string(max_iter) : to_string(median))
+             << setw(14) << setprecision(1) << accumulate(stable.begin(), stable.end(), 0.0) / stable.size() << endl;
+    }
+    MCTS_node::set_decisive_moves(false);
+    cout << endl << "(% of searches whose best root move is optimal after that many iterations; median iterations until"
+         << endl << " it is optimal and mean iterations after which the best move did not change any more; +D: decisive moves)" << endl;
+
+    for (auto *position : positions) delete position;
+    return 0;
+}
@@ -0,0 +1,70 @@
+#ifndef MCTS_GAME_PLUGIN_H
+#define MCTS_GAME_PLUGIN_H
+
+#include <string>
+#include "state.h"
+
+
+/** Games compiled as shared libraries and loaded at runtime (GamePlugin::load(), pymcts.load_game(path)).
+ * A plugin only needs state.h: it defines a factory of starting states and exports it with MCTS_EXPORT_GAME.
+ * Its states and moves are then searched by the engine like built-in ones, without any Python in between.
+ * Plugin and host must be built by the same compiler against the same state.h (checked through state_abi and
+ * cxx_abi, see MCTS_STATE_ABI_VERSION), since they share the C++ classes and the vtables of MCTS_state/MCTS_move.
+ * See examples/Quoridor/plugin.cpp (make QuoridorPlugin).
+ */
+
+#ifdef __GXX_ABI_VERSION
+#define MCTS_CXX_ABI __GXX_ABI_VERSION
+#else
+#define MCTS_CXX_ABI 0
+#endif
+
+#if defined(_WIN32)
+#define MCTS_PLUGIN_EXPORT __declspec(dllexport)
+#elif defined(__GNUC__)
+#define MCTS_PLUGIN_EXPORT __attribute__((visibility("default")))
+#else
+#define MCTS_PLUGIN_EXPORT
+#endif
+
+#define MCTS_GAME_PLUGIN_ENTRY "mcts_game_plugin"     // name of the exported function
+
+extern "C" {
+struct MCTS_game_plugin {
+    unsigned int state_abi;               // MCTS_STATE_ABI_VERSION of the state.h the plugin was built with
+    unsigned int cxx_abi;                 // MCTS_CXX_ABI of the compiler that built it
+    const char *name;
+    const char *description;              // e.g. the options that create_state() understands
+    MCTS_state *(*create_state)(const char *options);     // new starting state, NULL for invalid options
+};
+
+typedef const MCTS_game_plugin *(*MCTS_game_plugin_entry)();
+}
+
+/** Defines the entry point of a plugin, e.g. MCTS_EXPORT_GAME("Quoridor", "board size 5, 7, 9 or 11", create) */
+#define MCTS_EXPORT_GAME(NAME, DESCRIPTION, CREATE_STATE)                              \
+    extern "C" MCTS_PLUGIN_EXPORT const MCTS_game_plugin *mcts_game_plugin() {         \
+        static const MCTS_game_plugin plugin = {MCTS_STATE_ABI_VERSION, MCTS_CXX_ABI,  \
+                                                NAME, DESCRIPTION, CREATE_STATE};      \
+        return &plugin;                                                                \
+    }
+
+
+/** A loaded game plugin. The library is never unloaded (the states it created may outlive this object) */
+class GamePlugin {
+    std::string path;
+    const MCTS_game_plugin *plugin;
+
+    GamePlugin(const std::string &path, const MCTS_game_plugin *plugin) : path(path), plugin(plugin) {}
+public:
+    // NULL (with the reason in error) if path can't be loaded or isn't a compatible plugin
+    static GamePlugin *load(const std::string &path, std::string &error);
+    const std::string &get_path() const { return path; }
+    std::string get_name() const { return (plugin->name != NULL) ? plugin->name : ""; }
+    std::string get_description() const { return (plugin->description != NULL) ? plugin->description : ""; }
+    // New starting state owned by the caller, NULL if the plugin rejects the options
+    MCTS_state *create_state(const std::string &options = "") const;
+};
+
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef MCTS_OPENING_BOOK_H
+#define MCTS_OPENING_BOOK_H
+
+#include <string>
+#include <map>
+#include <cstdint>
+#include "mcts.h"
+
+
+/** Opening books: the statistics of many saved searches (MCTS_tree::save()) merged by position, so that agents start
+ * known positions from what earlier searches found instead of from scratch (MCTS_agent::set_opening_book()).
+ * Positions are keyed by hash_bytes() of their serialize() and their moves by hash_bytes() of encode_move(), so only
+ * games with a serializer have books. A book file is a sorted array of fixed-size records that OpeningBook maps into
+ * memory read-only: any number of agents and processes share one copy of it through the page cache.
+ * See examples/Quoridor/book.cpp (make QuoridorBook) for a tool that builds one from tree files.
+ */
+
+struct OpeningBookPosition {                 // 24 bytes, as in the file
+    uint64_t key;                            // hash_bytes() of the position's serialize()
+    uint64_t first_move;                     // index of its first OpeningBookMove
+    uint32_t moves;                          // number of its moves, most visited first
+    uint32_t visits;                         // sum of their visits
+};
+
+struct OpeningBookMove {                     // 24 bytes, as in the file
+    uint64_t move;                           // hash_bytes() of encode_move(), in the frame of the position's state
+    double score;                            // sum of the results for the self side, like MCTS_node's score
+    uint32_t visits;
+    uint32_t reserved;
+};
+
+
+/** A book file mapped into memory. Lookups don't modify it, so one book can be used by many agents and threads */
+class OpeningBook {
+    const char *data;                        // the mapping
+    size_t data_size;
+    const OpeningBookPosition *positions;
+    const OpeningBookMove *moves;
+    uint64_t number_of_positions, number_of_moves;
+    OpeningBook() : data(NULL), data_size(0), positions(NULL), moves(NULL), number_of_positions(0), number_of_moves(0) {}
+public:
+    ~OpeningBook();
+    // NULL (with the reason in error) if path can't be mapped or isn't a book file
+    static OpeningBook *open(const std::string &path, std::string &error);
+    size_t get_size() const { return (size_t) number_of_positions; }
+    const OpeningBookPosition *get_positions() const { return positions; }     // sorted by key
+    // The position of state (NULL if the book doesn't have it or the game has no serializer)
+    const OpeningBookPosition *find(const MCTS_state *state) const;
+    const OpeningBookMove *get_moves(const OpeningBookPosition &position) const { return moves + position.first_move; }
+    /** Gives the root's moves that have no child yet the book's statistics for its position: their children are
+     * created with the book's visits and scores (scaled down to at most max_visits in total, 0 -> as they are) and
+     * its visit shares as priors. Returns the root's child of the book's most visited move (NULL if the position
+     * isn't in the book) and its number of book visits in visits */
+    MCTS_node *seed(MCTS_tree &tree, unsigned int max_visits, unsigned int &visits) const;
+};
+
+
+/** Merges trees (and existing books) into a new book file */
+class OpeningBookBuilder {
+    struct MoveStats {
+        uint64_t visits;
+        double score;
+    };
+    std::map<uint64_t, std::map<uint64_t, MoveStats>> positions;     // position key -> move key -> statistics
+    bool add_node(const MCTS_node *node, int depth, int max_depth, unsigned int min_visits, std::string &error);
+public:
+    /** Adds the statistics of the children of every node at most max_depth plies below the root (0 -> the root only)
+     * with at least min_visits simulations. Returns false with the reason in error if the game's states can't be
+     * serialized */
+    bool add_tree(const MCTS_tree &tree, int max_depth, unsigned int min_visits, std::string &error);
+    void add_book(const OpeningBook &book);
+    size_t get_size() const { return positions.size(); }
+    bool write(const std::string &path, std::string &error) const;
+};
+
+
+#endif
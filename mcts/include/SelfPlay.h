@@ -0,0 +1,79 @@
+#ifndef SELFPLAY_H
+#define SELFPLAY_H
+
+#include "mcts.h"
+#include <cstdio>
+#include <atomic>
+
+
+/** Self-play: games of the tree against itself (one MCTS_tree per game) played concurrently on a thread pool.
+ * Every position of a finished game becomes a record (state encoding, root visit distribution, outcome) through the
+ * state's training data methods (to_numpy(), action_space_size(), action_index()). */
+
+
+struct SelfPlayRecord {
+    vector<double> state;                    // to_numpy() of the position
+    vector<double> policy;                   // root visits per action_index(), normalized to sum 1
+    double outcome;                          // final result for the side to move at the position: 1 win, 0.5 draw, 0 loss
+};
+
+
+class SelfPlayWriter {                       // extend this to store records somewhere else
+public:
+    virtual ~SelfPlayWriter() {}
+    // Called (never concurrently) with the records of every finished game. Return false once full to stop playing
+    virtual bool write(const vector<SelfPlayRecord> &game) = 0;
+};
+
+
+class SelfPlayBufferWriter : public SelfPlayWriter {     // preallocated row-major arrays, e.g. NumPy buffers
+    double *states, *policies, *outcomes;    // capacity x state_size, capacity x action_size and capacity values
+    size_t capacity, state_size, action_size, count;
+public:
+    SelfPlayBufferWriter(double *states, double *policies, double *outcomes, size_t capacity,
+                         size_t state_size, size_t action_size);
+    bool write(const vector<SelfPlayRecord> &game) override;         // records past the capacity are dropped
+    size_t get_count() const { return count; }
+};
+
+
+/** Binary file: a 16-byte header ("MCTSSP1\0", then uint32 state_size and action_size) followed by the records,
+ * each one state_size + action_size + 1 native doubles (state, policy, outcome). With numpy:
+ * np.fromfile(path, dtype=[("state", "<f8", S), ("policy", "<f8", A), ("outcome", "<f8")], offset=16) */
+class SelfPlayFileWriter : public SelfPlayWriter {
+    FILE *file;
+    size_t state_size, action_size;
+public:
+    SelfPlayFileWriter(const string &path, size_t state_size, size_t action_size, bool append = false);
+    ~SelfPlayFileWriter();
+    bool is_open() const { return file != NULL; }
+    bool write(const vector<SelfPlayRecord> &game) override;
+};
+
+
+struct SelfPlayConfig {
+    int games;
+    int max_iter;                            // grow_tree() limits of every move
+    double max_seconds;
+    unsigned int threads;                    // games played at the same time (0 -> MCTS_node::get_rollout_thread_count())
+    int temperature_moves;                   // moves of each game sampled proportionally to the visits (then the best)
+    unsigned int seed;
+    SelfPlayConfig(int games = 1, int max_iter = 1000, double max_seconds = 10)
+        : games(games), max_iter(max_iter), max_seconds(max_seconds), threads(0), temperature_moves(0), seed(0) {}
+};
+
+
+struct SelfPlayResult {
+    unsigned int games;                      // games played to the end and written
+    size_t records;
+    double seconds;
+    double games_per_hour() const { return (seconds > 0) ? 3600.0 * games / seconds : 0.0; }
+    SelfPlayResult() : games(0), records(0), seconds(0) {}
+};
+
+
+// Plays config.games games from (clones of) starting_state and writes each one to writer as soon as it is over
+SelfPlayResult self_play(const MCTS_state *starting_state, const SelfPlayConfig &config, SelfPlayWriter &writer);
+
+
+#endif
@@ -1,147 +1,262 @@
-#ifndef MCTS_H
-#define MCTS_H
-
-#include "state.h"
-#include <vector>
-#include <queue>
-#include <iomanip>
-
-#define STARTING_NUMBER_OF_CHILDREN 32   // expected number so that we can preallocate this many pointers
-#define PARALLEL_ROLLOUTS                // whether or not to do multiple parallel rollouts
-
-#ifdef PARALLEL_ROLLOUTS
-#include "JobScheduler.h"
-#endif
-
-using namespace std;
-
-// Rollout strategy enumeration
-enum class RolloutStrategy {
-    RANDOM,           // Pure random rollouts (default)
-    HEURISTIC,        // Use heuristic_rollout() method
-    MIXED,            // Mix of random and heuristic (configurable ratio)
-    HEAVY             // Deeper heuristic evaluation
-};
-
-/** Ideas for improvements:
- * - state should probably be const like move is (currently problematic because of Quoridor's example)
- * - Instead of a FIFO Queue use a Priority Queue with priority on most probable (better) actions to be explored first
-  or maybe this should just be an iterable and we let the implementation decide but these have no superclasses in C++ it seems
- * - vectors, queues and these structures allocate data on the heap anyway so there is little point in using the heap for them
- * so use stack instead?
- */
-
-
-class MCTS_node {
-    bool terminal;
-    unsigned int size;
-    unsigned int number_of_simulations;
-    double score;                       // e.g. number of wins (could be int but double is more general if we use evaluation functions)
-    double prior_probability;           // prior probability for PUCT
-    MCTS_state *state;                  // current state
-    const MCTS_move *move;              // move to get here from parent node's state
-    mutable vector<MCTS_node *> children;
-    MCTS_node *parent;
-    queue<MCTS_move *> untried_actions;
-    vector<double> action_probabilities; // stored probabilities for untried actions
-    void backpropagate(double w, int n);
-    
-    // Static rollout configuration
-    static RolloutStrategy rollout_strategy;
-    static double heuristic_ratio;      // For MIXED strategy: ratio of heuristic vs random rollouts
-    
-public:
-    MCTS_node(MCTS_node *parent, MCTS_state *state, const MCTS_move *move, double prior_probability = 1.0);
-    ~MCTS_node();
-    bool is_fully_expanded() const;
-    bool is_terminal() const;
-    const MCTS_move *get_move() const;
-    unsigned int get_size() const;
-    double get_prior_probability() const { return prior_probability; }
-    void expand();
-    void rollout();
-    void rollout_with_strategy(RolloutStrategy strategy);
-    MCTS_node *select_best_child(double c) const;
-    MCTS_node *advance_tree(const MCTS_move *m);
-    const MCTS_state *get_current_state() const;
-    void print_stats() const;
-    double calculate_winrate(bool self_side_turn) const;
-    
-    // Static configuration methods
-    static void set_rollout_strategy(RolloutStrategy strategy);
-    static RolloutStrategy get_rollout_strategy();
-    static void set_heuristic_ratio(double ratio);
-    static double get_heuristic_ratio();
-};
-
-
-
-class MCTS_tree {
-    MCTS_node *root;
-public:
-    MCTS_tree(MCTS_state *starting_state);
-    ~MCTS_tree();
-    MCTS_node *select(double c=1.41);        // select child node to expand according to tree policy (UCT)
-    MCTS_node *select_best_child();          // select the most promising child of the root node
-    void grow_tree(int max_iter, double max_time_in_seconds);
-    void advance_tree(const MCTS_move *move);      // if the move is applicable advance the tree, else start over
-    unsigned int get_size() const;
-    const MCTS_state *get_current_state() const;
-    void print_stats() const;
-};
-
-
-class MCTS_agent {                           // example of an agent based on the MCTS_tree. One can also use the tree directly.
-    MCTS_tree *tree;
-    int max_iter, max_seconds;
-public:
-    MCTS_agent(MCTS_state *starting_state, int max_iter = 100000, int max_seconds = 30);
-    ~MCTS_agent();
-    const MCTS_move *genmove(const MCTS_move *enemy_move);
-    const MCTS_state *get_current_state() const;
-    void feedback() const { tree->print_stats(); }
-    
-    // Rollout strategy configuration
-    void set_rollout_strategy(RolloutStrategy strategy);
-    RolloutStrategy get_rollout_strategy() const;
-    void set_heuristic_ratio(double ratio);
-    double get_heuristic_ratio() const;
-};
-
-
-#ifdef PARALLEL_ROLLOUTS
-class RolloutJob : public Job {             // class for performing parallel simulations using a thread pool
-    double *score;
-    const MCTS_state *state;
-    RolloutStrategy strategy;
-public:
-    RolloutJob(const MCTS_state *state, double *score, RolloutStrategy strat = RolloutStrategy::RANDOM) 
-        : Job(), state(state), score(score), strategy(strat) {}
-    void run() override {
-        // Execute rollout based on strategy
-        switch (strategy) {
-            case RolloutStrategy::HEURISTIC:
-                *score = state->heuristic_rollout();
-                break;
-            case RolloutStrategy::MIXED:
-                // Use heuristic_ratio to decide which rollout to use
-                if (static_cast<double>(rand()) / RAND_MAX < MCTS_node::get_heuristic_ratio()) {
-                    *score = state->heuristic_rollout();
-                } else {
-                    *score = state->rollout();
-                }
-                break;
-            case RolloutStrategy::HEAVY:
-                *score = state->heuristic_rollout();
-                break;
-            case RolloutStrategy::RANDOM:
-            default:
-                *score = state->rollout();
-                break;
-        }
-    }
-};
-#endif
-
-
-#endif
+#ifndef MCTS_H
+#define MCTS_H
+
+#include "state.h"
+#include <vector>
+#include <queue>
+#include <iomanip>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <cstdint>
+
+#define STARTING_NUMBER_OF_CHILDREN 32   // expected number so that we can preallocate this many pointers
+#define MAX_DECISIVE_ROLLOUT_DEPTH 1000  // decisive moves in a row after which a rollout returns evaluate_position()
+#define PARALLEL_ROLLOUTS                // whether or not to do multiple parallel rollouts
+
+#ifdef PARALLEL_ROLLOUTS
+#include "JobScheduler.h"
+#endif
+
+using namespace std;
+
+// Rollout strategy enumeration
+enum class RolloutStrategy {
+    RANDOM,           // Pure random rollouts (default)
+    HEURISTIC,        // Use heuristic_rollout() method
+    MIXED,            // Mix of random and heuristic (configurable ratio)
+    HEAVY             // Deeper heuristic evaluation
+};
+
+// What MCTS_tree does with the starting state it is given (every other state is created and owned by the tree's nodes)
+enum class StateOwnership {
+    TAKE,             // the tree takes ownership and deletes it when done (default)
+    COPY              // the state stays with the caller, the tree works on a clone() of it (e.g. for Python-owned states)
+};
+
+/** Ideas for improvements:
+ * - state should probably be const like move is (currently problematic because of Quoridor's example)
+ * - Instead of a FIFO Queue use a Priority Queue with priority on most probable (better) actions to be explored first
+  or maybe this should just be an iterable and we let the implementation decide but these have no superclasses in C++ it seems
+ * - vectors, queues and these structures allocate data on the heap anyway so there is little point in using the heap for them
+ * so use stack instead?
+ */
+
+
+struct MCTS_root_stats {                     // statistics of the root's children in one pass, e.g. as training targets
+    vector<unsigned int> visits;             // simulations run through every child
+    vector<double> values;                   // every child's winrate for the side to move at the root (Q)
+    vector<double> priors;                   // prior probabilities the children were created with
+    vector<double> encodings;                // the children's moves (in the actual game's frame) as to_numpy(), row by row
+    size_t encoding_size;                    // length of a row (0 if the moves' encodings are empty or differ in length)
+    MCTS_root_stats() : encoding_size(0) {}
+};
+
+
+/** Evaluates leaves in batches instead of simulating them, e.g. with a policy/value network (see
+ * MCTS_node::set_evaluator()). It may be called from several searches at once (e.g. self_play() threads). */
+class MCTS_evaluator {
+public:
+    virtual ~MCTS_evaluator() = default;
+    // Fills in one prior vector (empty -> all 1.0) and one value in [0, 1] for the self side (like rollout()) per
+    // state. Returns false if the evaluation failed: the leaves are then simulated instead
+    virtual bool evaluate(const vector<const MCTS_state *> &states, vector<vector<double>> &priors,
+                          vector<double> &values) = 0;
+    // Whether priors are indexed by the states' action_index() (a policy over action_space_size() entries) instead
+    // of following the order of actions_to_try(). Games without an action space always use the latter
+    virtual bool indexed_priors() const { return false; }
+};
+
+
+class MCTS_tree_io;                         // save()/load() of trees (TreeIO.cpp)
+class MCTS_book_io;                         // opening books (OpeningBook.cpp)
+class OpeningBook;
+
+// Bytes that identify a move in tree files and opening books: its to_numpy() encoding, else its sprint()
+string encode_move(const MCTS_move *move);
+// 64-bit FNV-1a hash, e.g. of a state's serialize() (the root key of tree files, the positions of opening books)
+uint64_t hash_bytes(const string &bytes);
+
+
+class MCTS_node {
+    friend class MCTS_tree_io;
+    friend class MCTS_book_io;
+    bool terminal;
+    bool awaiting_evaluation;           // created while an evaluator was set: its priors come with its evaluation
+    unsigned int size;
+    unsigned int number_of_simulations;
+    double score;                       // e.g. number of wins (could be int but double is more general if we use evaluation functions)
+    double prior_probability;           // prior probability for PUCT
+    MCTS_state *state;                  // current state
+    const MCTS_move *move;              // move to get here from parent node's state
+    mutable vector<MCTS_node *> children;
+    MCTS_node *parent;
+    queue<MCTS_move *> untried_actions;
+    queue<double> action_probabilities; // priors of the untried actions in the same order (empty -> all 1.0)
+    vector<unsigned long long> child_keys; // canonical keys of children (only for states with symmetries)
+    void backpropagate(double w, int n);
+    MCTS_node *add_child();             // node for the next untried action (NULL if the rest were all symmetric)
+    void virtual_visit(bool add);       // a draw counted along the path while this node's rollouts are pending
+    void set_priors(const vector<double> &priors, bool indexed);    // orders the untried actions by them
+    
+    // Static rollout configuration
+    static RolloutStrategy rollout_strategy;
+    static double heuristic_ratio;      // For MIXED strategy: ratio of heuristic vs random rollouts
+    static int rollouts_per_leaf;       // simulations run (and backpropagated together) for every new node
+    static bool decisive_moves;         // random simulations take immediate wins and block immediate losses
+    static int leaf_batch_size;         // leaves selected before their rollouts are run together (1 -> no batching)
+    static unsigned int rollout_thread_limit;   // threads of the pool a node's rollouts are split over (0 -> all)
+    static shared_ptr<MCTS_evaluator> evaluator;   // accessed through atomic_load/atomic_store
+    
+public:
+    // Takes ownership of state and move (a freshly created next_state() is moved in, never copied)
+    MCTS_node(MCTS_node *parent, MCTS_state *state, const MCTS_move *move, double prior_probability = 1.0);
+    ~MCTS_node();
+    bool is_fully_expanded() const;
+    bool is_terminal() const;
+    bool is_awaiting_evaluation() const { return awaiting_evaluation; }
+    const MCTS_move *get_move() const;
+    unsigned int get_size() const;
+    double get_prior_probability() const { return prior_probability; }
+    unsigned int get_number_of_simulations() const { return number_of_simulations; }
+    const vector<MCTS_node *> &get_children() const { return children; }
+    void expand();
+    MCTS_node *expand_pending();        // like expand() but leaves the rollout to rollout_pending()
+    void evaluate(MCTS_evaluator &evaluator);   // evaluates this node on its own (e.g. a new root awaiting evaluation)
+    void rollout();
+    void rollout_with_strategy(RolloutStrategy strategy);
+    MCTS_node *select_best_child(double c) const;
+    MCTS_node *advance_tree(const MCTS_move *m, int *transform = NULL);   // transform: symmetry from the played to the returned state
+    const MCTS_state *get_current_state() const;
+    void print_stats() const;
+    double calculate_winrate(bool self_side_turn) const;
+    
+    // Static configuration methods
+    static void set_rollout_strategy(RolloutStrategy strategy);
+    static RolloutStrategy get_rollout_strategy();
+    static void set_heuristic_ratio(double ratio);
+    static double get_heuristic_ratio();
+    static void set_rollouts_per_leaf(int count);
+    static int get_rollouts_per_leaf();
+    static void set_decisive_moves(bool enabled);
+    static bool get_decisive_moves();
+    static void set_leaf_batch_size(int size);
+    static int get_leaf_batch_size();
+    // Simulates leaves returned by expand_pending() in one batch (MCTS_state::rollout_many()) and backpropagates
+    static void rollout_pending(const vector<MCTS_node *> &leaves);
+    // Same with an evaluator: one evaluate() call for the leaves awaiting evaluation, which also sets their priors
+    static void evaluate_pending(const vector<MCTS_node *> &leaves, MCTS_evaluator &evaluator);
+    // Replaces rollouts by the evaluator (NULL -> back to rollouts) for searches starting from now on. Its batches
+    // are the leaf batches (set_leaf_batch_size()); states created meanwhile skip get_action_probabilities()
+    static void set_evaluator(shared_ptr<MCTS_evaluator> evaluator);
+    static shared_ptr<MCTS_evaluator> get_evaluator();
+    // Plays the state's winning_move() or else blocking_move() for as long as it has one, then its own rollout()
+    static double decisive_rollout(const MCTS_state *state);
+    // Runs count simulations from state with the given strategy and returns the sum of their results
+    static double simulate(const MCTS_state *state, RolloutStrategy strategy, int count);
+    // Number of threads the parallel rollouts run on (based on the hardware, 1 without PARALLEL_ROLLOUTS)
+    static unsigned int get_rollout_thread_count();
+    // Splits a node's rollouts over at most limit threads of that pool (0 -> all of them, 1 -> the searching thread)
+    static void set_rollout_thread_limit(unsigned int limit);
+    static unsigned int get_rollout_thread_limit();
+};
+
+
+
+class MCTS_tree {
+    friend class MCTS_tree_io;
+    friend class MCTS_book_io;
+    MCTS_node *root;
+    /** Symmetry handling: after advancing into a child that is only symmetric to the actual game state, the tree
+     * keeps playing in the child's frame. frame maps the actual game onto the tree (0 -> identity), moves are mapped
+     * through it on the way in and out and actual_state holds the real game state while frame != 0. */
+    int frame;
+    MCTS_state *actual_state;
+    MCTS_move *actual_move;                  // last move mapped out of the tree's frame (owned)
+    MCTS_tree() : root(NULL), frame(0), actual_state(NULL), actual_move(NULL) {}     // for load()
+public:
+    MCTS_tree(MCTS_state *starting_state, StateOwnership ownership = StateOwnership::TAKE);
+    ~MCTS_tree();
+    MCTS_node *select(double c=1.41);        // select child node to expand according to tree policy (UCT)
+    MCTS_node *select_best_child();          // select the most promising child of the root node
+    // stop (optional) may be set from another thread to end the search early, after at least one iteration
+    void grow_tree(int max_iter, double max_time_in_seconds, const atomic<bool> *stop = NULL);
+    void advance_tree(const MCTS_move *move);      // if the move is applicable advance the tree, else start over
+    const MCTS_move *to_game_move(const MCTS_move *tree_move);   // maps a move of the tree (e.g. of a root child) to the actual game
+    unsigned int get_size() const;
+    const MCTS_state *get_current_state() const;
+    void get_root_stats(MCTS_root_stats &stats);   // fills stats in with the root's children
+    const vector<MCTS_node *> &get_root_children() const { return root->get_children(); }   // moves in the tree's frame
+    void print_stats() const;
+    // Compact binary snapshot of the tree: statistics, structure and moves (see TreeIO.cpp). with_states also stores
+    // every node's state (MCTS_state::serialize()). Returns false with the reason in error
+    bool save(const string &path, bool with_states, string &error) const;
+    // Tree saved by save(). Moves are matched against actions_to_try() so starting_state (taken over as by the
+    // constructor) must be the saved root's state, or any state of the game if the states were saved. NULL with the
+    // reason in error
+    static MCTS_tree *load(const string &path, MCTS_state *starting_state, string &error,
+                           StateOwnership ownership = StateOwnership::TAKE);
+};
+
+
+class MCTS_agent {                           // example of an agent based on the MCTS_tree. One can also use the tree directly.
+    MCTS_tree *tree;
+    int max_iter, max_seconds;
+    MCTS_root_stats last_search_stats;       // root stats of the last genmove() search, before advancing the tree
+    shared_ptr<const OpeningBook> book;      // see set_opening_book()
+    unsigned int book_seed_visits, book_play_visits;
+public:
+    MCTS_agent(MCTS_state *starting_state, int max_iter = 100000, int max_seconds = 30,
+               StateOwnership ownership = StateOwnership::TAKE);
+    ~MCTS_agent();
+    const MCTS_move *genmove(const MCTS_move *enemy_move, const atomic<bool> *stop = NULL);  // stop: see grow_tree()
+    const MCTS_state *get_current_state() const;
+    void feedback() const { tree->print_stats(); }
+    const MCTS_root_stats &get_last_search_stats() const { return last_search_stats; }
+    // The agent's tree (see MCTS_tree::save()/load()). load_tree() replaces it, and with it the current state if the
+    // file has states (else it must be a tree of the current state)
+    bool save_tree(const string &path, bool with_states, string &error) const {
+        return tree->save(path, with_states, error);
+    }
+    bool load_tree(const string &path, string &error);
+    // Opening book consulted before every search (NULL -> none, see OpeningBook::seed()): the root's moves without a
+    // child yet start from the book's statistics, scaled down to at most seed_visits in total (0 -> as they are).
+    // Positions with at least play_visits book visits are played with the book's most visited move without searching
+    // (0 -> always search)
+    void set_opening_book(shared_ptr<const OpeningBook> book, unsigned int seed_visits = 1000, unsigned int play_visits = 0);
+    
+    // Rollout strategy configuration
+    void set_rollout_strategy(RolloutStrategy strategy);
+    RolloutStrategy get_rollout_strategy() const;
+    void set_heuristic_ratio(double ratio);
+    double get_heuristic_ratio() const;
+    void set_rollouts_per_leaf(int count);
+    int get_rollouts_per_leaf() const;
+    void set_decisive_moves(bool enabled);
+    bool get_decisive_moves() const;
+    void set_leaf_batch_size(int size);
+    int get_leaf_batch_size() const;
+};
+
+
+#ifdef PARALLEL_ROLLOUTS
+class RolloutJob : public Job {             // class for performing parallel simulations using a thread pool
+    double *score;                          // sum of the results of count simulations (left untouched on failure)
+    const MCTS_state *state;
+    RolloutStrategy strategy;
+    int count;
+public:
+    RolloutJob(const MCTS_state *state, double *score, RolloutStrategy strat = RolloutStrategy::RANDOM, int count = 1, int tag = 0)
+        : Job(tag), score(score), state(state), strategy(strat), count(count) {}
+    void run() override {
+        try {
+            *score = MCTS_node::simulate(state, strategy, count);
+        } catch (const std::exception &e) {      // e.g. a Python rollout raising: must not escape the worker thread
+            cerr << "Warning: Rollout threw exception: " << e.what() << endl;
+        }
+    }
+};
+#endif
+
+
+#endif
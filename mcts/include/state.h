@@ -1,71 +1,151 @@
-#ifndef MCTS_STATE_H
-#define MCTS_STATE_H
-
-#include <stdexcept>
-#include <queue>
-#include <iostream>
-#include <string>
-#include <vector>
-
-
-using namespace std;
-
-
-struct MCTS_move {
-    virtual ~MCTS_move() = default;
-    virtual bool operator==(const MCTS_move& other) const = 0;             // implement this!
-    virtual string sprint() const { return "Not implemented"; }   // and optionally this
-
-    // Virtual methods for Python integration
-    virtual vector<double> to_numpy() const = 0;                          // Convert move to numpy array
-    virtual vector<int> to_env_action() const = 0;                        // Convert to environment action format
-    
-};
-
-
-/** Implement all pure virtual methods. Notes:
- * - rollout() must return something in [0, 1] for UCT to work as intended and specifically
- * the winning chance of the self side (the side making decisions).
- * - self side is determined by is_self_side_turn()
- * - supports 1 vs N player scenarios where self_side competes against other_side(s)
- * - minimal interface: only requires is_self_side_turn() for turn determination
- */
-class MCTS_state {
-public:
-    // Implement these:
-    virtual ~MCTS_state() = default;
-    virtual queue<MCTS_move *> *actions_to_try() const = 0;
-    virtual MCTS_state *next_state(const MCTS_move *move) const = 0;
-    virtual double rollout() const = 0;
-    virtual bool is_terminal() const = 0;
-    virtual void print() const {
-        cout << "Printing not implemented" << endl;
-    }
-    virtual bool is_self_side_turn() const = 0;     // true if it's the self side's turn
-    
-    // Deep copy method for C++ ownership transfer
-    virtual MCTS_state* clone() const = 0;
-    
-    // Heuristic rollout support (optional override)
-    virtual double heuristic_rollout() const {
-        return rollout();  // Default to random rollout
-    }
-    
-    // Move evaluation heuristic (optional override)
-    virtual double evaluate_move(const MCTS_move* move) const {
-        return 0.0;  // Default: no preference
-    }
-    
-    // Position evaluation heuristic (optional override)
-    virtual double evaluate_position() const {
-        return 0.5;  // Default: neutral position
-    }
-
-    // Action probabilities for PUCT (optional override)
-    virtual vector<double> get_action_probabilities() const {
-        return vector<double>(); // Default empty
-    }
-};
-
-
-#endif
+#ifndef MCTS_STATE_H
+#define MCTS_STATE_H
+
+#include <stdexcept>
+#include <queue>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+using namespace std;
+
+
+// Layout of the virtual methods below. Bump it whenever they change: game plugins (GamePlugin.h) built against
+// another layout are refused instead of calling the wrong methods
+#define MCTS_STATE_ABI_VERSION 2
+
+
+struct MCTS_move {
+    virtual ~MCTS_move() = default;
+    virtual bool operator==(const MCTS_move& other) const = 0;             // implement this!
+    virtual string sprint() const { return "Not implemented"; }   // and optionally this
+    // Optional: set h to a hash of the move (equal moves must get equal hashes) and return true.
+    // The tree then only calls operator== on children whose moves hash the same (e.g. for moves defined in Python)
+    virtual bool get_hash(size_t &h) const { return false; }
+
+    // Virtual methods for Python integration
+    virtual vector<double> to_numpy() const = 0;                          // Convert move to numpy array
+    virtual vector<int> to_env_action() const = 0;                        // Convert to environment action format
+    
+};
+
+
+/** Implement all pure virtual methods. Notes:
+ * - rollout() must return something in [0, 1] for UCT to work as intended and specifically
+ * the winning chance of the self side (the side making decisions).
+ * - self side is determined by is_self_side_turn()
+ * - supports 1 vs N player scenarios where self_side competes against other_side(s)
+ * - minimal interface: only requires is_self_side_turn() for turn determination
+ */
+class MCTS_state {
+public:
+    // Implement these:
+    virtual ~MCTS_state() = default;
+    virtual queue<MCTS_move *> *actions_to_try() const = 0;
+    virtual MCTS_state *next_state(const MCTS_move *move) const = 0;
+    virtual double rollout() const = 0;
+    // Batched rollouts (optional override): sum of count rollout() results, e.g. to simulate many games at once
+    virtual double rollout_n(int count) const {
+        double sum = 0.0;
+        for (int i = 0 ; i < count ; i++) {
+            sum += rollout();
+        }
+        return sum;
+    }
+    // Number of games rollout_n() simulates at once (optional override): rollout jobs get at least this many
+    virtual int rollout_batch_size() const {
+        return 1;
+    }
+    // Rollouts of several leaves at once (optional override), called on one of them (all of the same game) when the
+    // tree simulates leaves in batches: one rollout_n(count) result per state, in order
+    virtual vector<double> rollout_many(const vector<const MCTS_state *> &states, int count) const {
+        vector<double> results;
+        results.reserve(states.size());
+        for (const MCTS_state *state : states) {
+            results.push_back(state->rollout_n(count));
+        }
+        return results;
+    }
+    virtual bool is_terminal() const = 0;
+    virtual void print() const {
+        cout << "Printing not implemented" << endl;
+    }
+    virtual bool is_self_side_turn() const = 0;     // true if it's the self side's turn
+    
+    // Deep copy method for C++ ownership transfer
+    virtual MCTS_state* clone() const = 0;
+    
+    // Heuristic rollout support (optional override)
+    virtual double heuristic_rollout() const {
+        return rollout();  // Default to random rollout
+    }
+    
+    // Move evaluation heuristic (optional override)
+    virtual double evaluate_move(const MCTS_move* move) const {
+        return 0.0;  // Default: no preference
+    }
+    
+    // Position evaluation heuristic (optional override)
+    virtual double evaluate_position() const {
+        return 0.5;  // Default: neutral position
+    }
+
+    // Decisive moves (optional override, used by rollouts when MCTS_node::set_decisive_moves(true)): a new move for the
+    // side to move that wins on the spot, or that stops the opponent from winning on its next move. NULL if none.
+    virtual MCTS_move *winning_move() const {
+        return NULL;
+    }
+    virtual MCTS_move *blocking_move() const {
+        return NULL;
+    }
+
+    // Action probabilities for PUCT (optional override)
+    virtual vector<double> get_action_probabilities() const {
+        return vector<double>(); // Default empty
+    }
+
+    // Training data (optional override, used by self_play()): a fixed-size encoding of the state and a flat index in
+    // [0, action_space_size()) for every move of it, so that visit distributions of different positions line up
+    virtual vector<double> to_numpy() const {
+        return vector<double>();
+    }
+    virtual int action_space_size() const {
+        return 0;
+    }
+    virtual int action_index(const MCTS_move *move) const {
+        return -1;
+    }
+
+    // Serialization (optional override, used by MCTS_tree::save() with states): append a self-contained encoding of
+    // the state to out and return true. deserialize() is called on any state of the same game and returns a new state
+    // from such an encoding, NULL if it is invalid
+    virtual bool serialize(string &out) const {
+        return false;
+    }
+    virtual MCTS_state *deserialize(const char *data, size_t size) const {
+        return NULL;
+    }
+
+    // Symmetry support (optional override). Transforms are game-defined ids with 0 as the identity.
+    // Return true and set key to a value shared by all symmetric variants of this state (and only them)
+    // and transform to the symmetry that maps this state onto its canonical variant.
+    // The tree then merges symmetric children and plays in the frame of the states it kept.
+    virtual bool canonical_form(unsigned long long &key, int &transform) const {
+        return false;  // Default: no symmetries
+    }
+    // New move equal to move (a move of this state) seen through transform. Needed if canonical_form() is implemented.
+    virtual MCTS_move *transform_move(const MCTS_move *move, int transform) const {
+        return NULL;
+    }
+    // Transform equivalent to applying first and then second
+    virtual int compose_transforms(int first, int second) const {
+        return 0;
+    }
+    virtual int inverse_transform(int transform) const {
+        return 0;
+    }
+};
+
+
+#endif
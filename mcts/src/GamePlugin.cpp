@@ -0,0 +1,51 @@
+#include "../include/GamePlugin.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+
+using namespace std;
+
+
+GamePlugin *GamePlugin::load(const string &path, string &error) {
+#ifdef _WIN32
+    HMODULE library = LoadLibraryA(path.c_str());
+    if (library == NULL) {
+        error = "Could not load " + path;
+        return NULL;
+    }
+    MCTS_game_plugin_entry entry = (MCTS_game_plugin_entry) GetProcAddress(library, MCTS_GAME_PLUGIN_ENTRY);
+#else
+    // RTLD_LOCAL: each plugin keeps its own symbols, so plugins of the same game (or of a built-in one) can't clash
+    void *library = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (library == NULL) {
+        const char *reason = dlerror();
+        error = (reason != NULL) ? reason : "Could not load " + path;     // dlerror() names the file already
+        return NULL;
+    }
+    MCTS_game_plugin_entry entry = (MCTS_game_plugin_entry) dlsym(library, MCTS_GAME_PLUGIN_ENTRY);
+#endif
+    // like accepted plugins, rejected libraries are never unloaded
+    if (entry == NULL) {
+        error = path + " is not a game plugin (it does not export " MCTS_GAME_PLUGIN_ENTRY "())";
+        return NULL;
+    }
+    const MCTS_game_plugin *plugin = entry();
+    if (plugin == NULL || plugin->create_state == NULL) {
+        error = path + " does not provide a game";
+        return NULL;
+    }
+    if (plugin->state_abi != MCTS_STATE_ABI_VERSION || plugin->cxx_abi != MCTS_CXX_ABI) {
+        error = path + " was built against another state.h or compiler (state ABI " + to_string(plugin->state_abi)
+                + ", C++ ABI " + to_string(plugin->cxx_abi) + " instead of " + to_string(MCTS_STATE_ABI_VERSION)
+                + " and " + to_string(MCTS_CXX_ABI) + ")";
+        return NULL;
+    }
+    return new GamePlugin(path, plugin);
+}
+
+MCTS_state *GamePlugin::create_state(const string &options) const {
+    return plugin->create_state(options.c_str());
+}
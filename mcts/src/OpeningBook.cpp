@@ -0,0 +1,304 @@
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+#include "../include/OpeningBook.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+using namespace std;
+
+
+/** Book files, in native byte order: header "MCTSBK1\0", uint32 version, uint32 reserved, uint64 number of positions
+ * and uint64 number of moves, followed by the OpeningBookPosition records sorted by key and the OpeningBookMove
+ * records of every position in a row. All records are 8-byte aligned so the mapped file is used as it is. */
+#define BOOK_MAGIC "MCTSBK1"
+#define BOOK_VERSION 1
+
+struct BookHeader {
+    char magic[8];
+    uint32_t version, reserved;
+    uint64_t positions, moves;
+};
+
+static_assert(sizeof(BookHeader) == 32 && sizeof(OpeningBookPosition) == 24 && sizeof(OpeningBookMove) == 24,
+              "book records must have the layout of the file");
+
+
+class MCTS_book_io {
+public:
+    static MCTS_node *root(const MCTS_tree &tree) { return tree.root; }
+
+    // see OpeningBook::seed()
+    static MCTS_node *seed(MCTS_node *root, const OpeningBookPosition &position, const OpeningBookMove *moves,
+                           unsigned int max_visits) {
+        if (position.moves == 0 || position.visits == 0) return NULL;
+        const double scale = (max_visits > 0 && position.visits > max_visits) ? (double) max_visits / position.visits : 1.0;
+        const uint64_t best_key = moves[0].move;     // most visited first
+        MCTS_node *best = NULL;
+        for (MCTS_node *child : root->children) {   // these keep their own statistics
+            if (best == NULL && hash_bytes(encode_move(child->move)) == best_key) best = child;
+        }
+        unordered_map<uint64_t, uint32_t> book_moves;
+        for (uint32_t i = 0 ; i < position.moves ; i++) book_moves[moves[i].move] = i;
+        vector<MCTS_move *> actions;
+        vector<double> priors;
+        while (!root->untried_actions.empty()) {
+            actions.push_back(root->untried_actions.front());
+            root->untried_actions.pop();
+        }
+        while (!root->action_probabilities.empty()) {
+            priors.push_back(root->action_probabilities.front());
+            root->action_probabilities.pop();
+        }
+        for (size_t j = 0 ; j < actions.size() ; j++) {
+            auto found = book_moves.find(hash_bytes(encode_move(actions[j])));
+            if (found == book_moves.end() || moves[found->second].visits == 0) continue;
+            const OpeningBookMove &book_move = moves[found->second];
+            MCTS_state *next_state = root->state->next_state(actions[j]);
+            if (next_state == NULL) continue;
+            unsigned long long key;
+            int transform;
+            if (next_state->canonical_form(key, transform)) {
+                if (find(root->child_keys.begin(), root->child_keys.end(), key) != root->child_keys.end()) {
+                    // symmetric to an existing child, as add_child() would skip it
+                    delete next_state;
+                    delete actions[j];
+                    actions[j] = NULL;
+                    continue;
+                }
+                root->child_keys.push_back(key);
+            }
+            const unsigned int visits = max(1u, (unsigned int) (book_move.visits * scale + 0.5));
+            MCTS_node *child = new MCTS_node(root, next_state, actions[j], (double) book_move.visits / position.visits);
+            child->number_of_simulations = visits;
+            child->score = book_move.score * visits / book_move.visits;
+            root->number_of_simulations += visits;
+            root->score += child->score;
+            root->size++;
+            root->children.push_back(child);
+            if (best == NULL && book_move.move == best_key) best = child;
+            actions[j] = NULL;                       // owned by the child
+        }
+        for (size_t j = 0 ; j < actions.size() ; j++) {
+            if (actions[j] == NULL) continue;
+            root->untried_actions.push(actions[j]);
+            if (j < priors.size()) root->action_probabilities.push(priors[j]);
+        }
+        return best;
+    }
+};
+
+
+OpeningBook::~OpeningBook() {
+    if (data == NULL) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+#else
+    munmap((void *) data, data_size);
+#endif
+}
+
+OpeningBook *OpeningBook::open(const string &path, string &error) {
+    OpeningBook *book = new OpeningBook();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        error = "Could not open " + path;
+        delete book;
+        return NULL;
+    }
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+    if (GetFileSizeEx(file, &size) && size.QuadPart >= (LONGLONG) sizeof(BookHeader)) {
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping != NULL) {
+            book->data = (const char *) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            book->data_size = (size_t) size.QuadPart;
+            CloseHandle(mapping);            // the view keeps the mapping and the file alive
+        }
+    }
+    CloseHandle(file);
+    if (book->data == NULL) {
+        error = (mapping == NULL) ? path + " is not a book file" : "Could not map " + path;
+        delete book;
+        return NULL;
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "Could not open " + path;
+        delete book;
+        return NULL;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t) sizeof(BookHeader)) {
+        close(fd);
+        error = path + " is not a book file";
+        delete book;
+        return NULL;
+    }
+    void *mapped = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);                               // the mapping stays valid
+    if (mapped == MAP_FAILED) {
+        error = "Could not map " + path;
+        delete book;
+        return NULL;
+    }
+    book->data = (const char *) mapped;
+    book->data_size = (size_t) info.st_size;
+#endif
+    const BookHeader *header = (const BookHeader *) book->data;
+    if (memcmp(header->magic, BOOK_MAGIC, 8) != 0) {
+        error = path + " is not a book file";
+        delete book;
+        return NULL;
+    }
+    if (header->version != BOOK_VERSION) {
+        error = path + " has version " + to_string(header->version) + " (expected " + to_string(BOOK_VERSION) + ")";
+        delete book;
+        return NULL;
+    }
+    const uint64_t records = (book->data_size - sizeof(BookHeader)) / sizeof(OpeningBookPosition);
+    if (header->positions > records || header->moves > records - header->positions
+        || book->data_size != sizeof(BookHeader) + (header->positions + header->moves) * sizeof(OpeningBookPosition)) {
+        error = "Truncated or corrupted book file";
+        delete book;
+        return NULL;
+    }
+    book->number_of_positions = header->positions;
+    book->number_of_moves = header->moves;
+    book->positions = (const OpeningBookPosition *) (book->data + sizeof(BookHeader));
+    book->moves = (const OpeningBookMove *) (book->positions + header->positions);
+    // one pass over the (small) index so that lookups can trust it
+    for (uint64_t i = 0 ; i < book->number_of_positions ; i++) {
+        const OpeningBookPosition &position = book->positions[i];
+        if (position.first_move > book->number_of_moves || position.moves > book->number_of_moves - position.first_move
+            || (i > 0 && position.key <= book->positions[i - 1].key)) {
+            error = "Truncated or corrupted book file";
+            delete book;
+            return NULL;
+        }
+    }
+    return book;
+}
+
+const OpeningBookPosition *OpeningBook::find(const MCTS_state *state) const {
+    string serialized;
+    if (number_of_positions == 0 || !state->serialize(serialized)) return NULL;
+    const uint64_t key = hash_bytes(serialized);
+    const OpeningBookPosition *end = positions + number_of_positions;
+    const OpeningBookPosition *position = lower_bound(positions, end, key,
+        [](const OpeningBookPosition &p, uint64_t k) { return p.key < k; });
+    return (position != end && position->key == key) ? position : NULL;
+}
+
+MCTS_node *OpeningBook::seed(MCTS_tree &tree, unsigned int max_visits, unsigned int &visits) const {
+    MCTS_node *root = MCTS_book_io::root(tree);
+    const OpeningBookPosition *position = find(root->get_current_state());     // in the tree's frame, like its moves
+    visits = 0;
+    if (position == NULL) return NULL;
+    visits = position->visits;
+    return MCTS_book_io::seed(root, *position, get_moves(*position), max_visits);
+}
+
+
+bool OpeningBookBuilder::add_node(const MCTS_node *node, int depth, int max_depth, unsigned int min_visits,
+                                  string &error) {
+    if (node->get_children().empty() || node->get_number_of_simulations() < min_visits) return true;
+    string state;
+    if (!node->get_current_state()->serialize(state)) {
+        error = "The game's states can't be serialized (MCTS_state::serialize())";
+        return false;
+    }
+    map<uint64_t, MoveStats> &moves = positions[hash_bytes(state)];
+    for (const MCTS_node *child : node->get_children()) {
+        const unsigned int n = child->get_number_of_simulations();
+        if (n == 0) continue;
+        MoveStats &stats = moves[hash_bytes(encode_move(child->get_move()))];
+        stats.visits += n;
+        stats.score += child->calculate_winrate(true) * n;
+        if (depth < max_depth && !add_node(child, depth + 1, max_depth, min_visits, error)) return false;
+    }
+    return true;
+}
+
+bool OpeningBookBuilder::add_tree(const MCTS_tree &tree, int max_depth, unsigned int min_visits, string &error) {
+    return add_node(MCTS_book_io::root(tree), 0, max_depth, min_visits, error);
+}
+
+void OpeningBookBuilder::add_book(const OpeningBook &book) {
+    for (size_t i = 0 ; i < book.get_size() ; i++) {
+        const OpeningBookPosition &position = book.get_positions()[i];
+        const OpeningBookMove *moves = book.get_moves(position);
+        map<uint64_t, MoveStats> &merged = positions[position.key];
+        for (uint32_t j = 0 ; j < position.moves ; j++) {
+            MoveStats &stats = merged[moves[j].move];
+            stats.visits += moves[j].visits;
+            stats.score += moves[j].score;
+        }
+    }
+}
+
+bool OpeningBookBuilder::write(const string &path, string &error) const {
+    vector<OpeningBookPosition> index;
+    vector<OpeningBookMove> records;
+    for (const auto &position : positions) {             // sorted by key
+        const size_t first = records.size();
+        uint64_t visits = 0;
+        for (const auto &move : position.second) {
+            if (move.second.visits == 0) continue;
+            OpeningBookMove record;
+            record.move = move.first;
+            record.visits = (uint32_t) min<uint64_t>(move.second.visits, UINT32_MAX);
+            record.score = move.second.score * record.visits / move.second.visits;
+            record.reserved = 0;
+            records.push_back(record);
+            visits += record.visits;
+        }
+        if (records.size() == first) continue;
+        sort(records.begin() + first, records.end(), [](const OpeningBookMove &a, const OpeningBookMove &b) {
+            return a.visits > b.visits || (a.visits == b.visits && a.move < b.move);
+        });
+        OpeningBookPosition record;
+        record.key = position.first;
+        record.first_move = first;
+        record.moves = (uint32_t) (records.size() - first);
+        record.visits = (uint32_t) min<uint64_t>(visits, UINT32_MAX);
+        index.push_back(record);
+    }
+    BookHeader header;
+    memcpy(header.magic, BOOK_MAGIC, 8);
+    header.version = BOOK_VERSION;
+    header.reserved = 0;
+    header.positions = index.size();
+    header.moves = records.size();
+    // written next to it and renamed over it: processes that have the old book mapped keep their copy
+    const string temporary = path + ".tmp";
+    FILE *file = fopen(temporary.c_str(), "wb");
+    if (file == NULL) {
+        error = "Could not open " + temporary + " for writing";
+        return false;
+    }
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+                   && fwrite(index.data(), sizeof(OpeningBookPosition), index.size(), file) == index.size()
+                   && fwrite(records.data(), sizeof(OpeningBookMove), records.size(), file) == records.size();
+    written = (fclose(file) == 0) && written;
+#ifdef _WIN32
+    if (written) remove(path.c_str());      // rename() doesn't replace files there
+#endif
+    if (!written || rename(temporary.c_str(), path.c_str()) != 0) {
+        remove(temporary.c_str());
+        error = "Could not write " + path;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,190 @@
+#include <iostream>
+#include <cstring>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <mutex>
+#include "../include/SelfPlay.h"
+#include "../include/JobScheduler.h"
+
+
+using namespace std;
+
+
+/*** Writers ***/
+SelfPlayBufferWriter::SelfPlayBufferWriter(double *states, double *policies, double *outcomes, size_t capacity,
+                                           size_t state_size, size_t action_size)
+        : states(states), policies(policies), outcomes(outcomes), capacity(capacity),
+          state_size(state_size), action_size(action_size), count(0) {}
+
+bool SelfPlayBufferWriter::write(const vector<SelfPlayRecord> &game) {
+    if (count + game.size() > capacity) return false;     // only whole games are kept
+    for (const SelfPlayRecord &record : game) {
+        memcpy(states + count * state_size, record.state.data(), state_size * sizeof(double));
+        memcpy(policies + count * action_size, record.policy.data(), action_size * sizeof(double));
+        outcomes[count] = record.outcome;
+        count++;
+    }
+    return true;
+}
+
+SelfPlayFileWriter::SelfPlayFileWriter(const string &path, size_t state_size, size_t action_size, bool append)
+        : file(NULL), state_size(state_size), action_size(action_size) {
+    file = fopen(path.c_str(), append ? "a+b" : "wb");     // "a+": reads anywhere, writes always at the end
+    if (file == NULL) {
+        cerr << "Warning: Could not open self-play file " << path << endl;
+        return;
+    }
+    uint32_t sizes[2] = {(uint32_t) state_size, (uint32_t) action_size};
+    fseek(file, 0, SEEK_END);
+    if (ftell(file) == 0) {            // new file (or an empty one to append to)
+        fwrite("MCTSSP1", 1, 8, file);
+        fwrite(sizes, sizeof(uint32_t), 2, file);
+        return;
+    }
+    // appending: the records must have the sizes of the existing ones
+    char magic[8];
+    uint32_t existing[2];
+    rewind(file);
+    if (fread(magic, 1, 8, file) != 8 || memcmp(magic, "MCTSSP1", 8) != 0
+        || fread(existing, sizeof(uint32_t), 2, file) != 2 || existing[0] != sizes[0] || existing[1] != sizes[1]) {
+        cerr << "Warning: " << path << " is not a self-play file with records of the same sizes" << endl;
+        fclose(file);
+        file = NULL;
+    }
+}
+
+SelfPlayFileWriter::~SelfPlayFileWriter() {
+    if (file != NULL) fclose(file);
+}
+
+bool SelfPlayFileWriter::write(const vector<SelfPlayRecord> &game) {
+    if (file == NULL) return false;
+    for (const SelfPlayRecord &record : game) {
+        if (fwrite(record.state.data(), sizeof(double), state_size, file) != state_size
+            || fwrite(record.policy.data(), sizeof(double), action_size, file) != action_size
+            || fwrite(&record.outcome, sizeof(double), 1, file) != 1) {
+            cerr << "Warning: Could not write self-play record" << endl;
+            return false;
+        }
+    }
+    fflush(file);                      // readers may follow the file while games are still being played
+    return true;
+}
+
+
+/*** Self-play ***/
+struct SelfPlayContext {
+    const MCTS_state *starting_state;
+    const SelfPlayConfig *config;
+    SelfPlayWriter *writer;
+    size_t state_size;
+    int action_size;
+    unsigned int seed;
+    atomic<bool> done;                 // the writer is full (searches of the games still running stop early)
+    mutex lock;                        // protects writer and result
+    SelfPlayResult result;
+};
+
+// Plays one game to the end and fills in its records, false if it was abandoned
+static bool play_game(SelfPlayContext &ctx, int game, vector<SelfPlayRecord> &records) {
+    mt19937 gen(ctx.seed + game);
+    MCTS_tree tree(ctx.starting_state->clone());
+    vector<bool> self_side;
+    for (int ply = 0 ; !tree.get_current_state()->is_terminal() ; ply++) {
+        tree.grow_tree(ctx.config->max_iter, ctx.config->max_seconds, &ctx.done);
+        if (ctx.done) return false;
+        const vector<MCTS_node *> &children = tree.get_root_children();
+        if (children.empty()) {
+            cerr << "Warning: Self-play root has no children! Abandoning game." << endl;
+            return false;
+        }
+        const MCTS_state *state = tree.get_current_state();
+        SelfPlayRecord record;
+        record.state = state->to_numpy();
+        if (record.state.size() != ctx.state_size) {
+            cerr << "Warning: to_numpy() of a self-play position has size " << record.state.size() << " instead of "
+                 << ctx.state_size << ". Abandoning game." << endl;
+            return false;
+        }
+        record.policy.assign(ctx.action_size, 0.0);
+        vector<double> visits;
+        double total = 0.0;
+        for (auto *child : children) {
+            double n = child->get_number_of_simulations();
+            int action = state->action_index(tree.to_game_move(child->get_move()));
+            if (action >= 0 && action < ctx.action_size) record.policy[action] += n;
+            visits.push_back(n);
+            total += n;
+        }
+        if (total > 0) {
+            for (double &p : record.policy) p /= total;
+        }
+        records.push_back(std::move(record));
+        self_side.push_back(state->is_self_side_turn());
+        // play the best child or, early in the game, one sampled proportionally to its visits
+        MCTS_node *chosen;
+        if (ply < ctx.config->temperature_moves && total > 0) {
+            discrete_distribution<int> dis(visits.begin(), visits.end());
+            chosen = children[dis(gen)];
+        } else {
+            chosen = tree.select_best_child();
+        }
+        tree.advance_tree(tree.to_game_move(chosen->get_move()));
+    }
+    double result = tree.get_current_state()->rollout();      // exact at terminal states
+    for (size_t i = 0 ; i < records.size() ; i++) {
+        records[i].outcome = self_side[i] ? result : 1.0 - result;
+    }
+    return true;
+}
+
+class SelfPlayJob : public Job {
+    SelfPlayContext *ctx;
+    int game;
+public:
+    SelfPlayJob(SelfPlayContext *ctx, int game) : ctx(ctx), game(game) {}
+    void run() override {
+        if (ctx->done) return;
+        vector<SelfPlayRecord> records;
+        try {
+            if (!play_game(*ctx, game, records)) return;
+        } catch (const std::exception &e) {
+            cerr << "Warning: Self-play game threw exception: " << e.what() << endl;
+            return;
+        }
+        lock_guard<mutex> guard(ctx->lock);
+        if (ctx->done) return;
+        if (!ctx->writer->write(records)) {
+            ctx->done = true;
+            return;
+        }
+        ctx->result.games++;
+        ctx->result.records += records.size();
+    }
+};
+
+SelfPlayResult self_play(const MCTS_state *starting_state, const SelfPlayConfig &config, SelfPlayWriter &writer) {
+    SelfPlayContext ctx;
+    ctx.starting_state = starting_state;
+    ctx.config = &config;
+    ctx.writer = &writer;
+    ctx.state_size = starting_state->to_numpy().size();
+    ctx.action_size = starting_state->action_space_size();
+    ctx.seed = (config.seed != 0) ? config.seed : random_device()();
+    ctx.done = false;
+    if (ctx.state_size == 0 || ctx.action_size <= 0) {
+        cerr << "Warning: Self-play needs a state with to_numpy() and action_space_size()" << endl;
+        return ctx.result;
+    }
+    auto start = chrono::steady_clock::now();
+    {
+        unsigned int threads = (config.threads > 0) ? config.threads : MCTS_node::get_rollout_thread_count();
+        JobScheduler pool(min(threads, (unsigned int) max(config.games, 1)));
+        for (int game = 0 ; game < config.games ; game++) {
+            pool.schedule(new SelfPlayJob(&ctx, game));
+        }
+    }   // the pool's destructor waits for every game
+    ctx.result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return ctx.result;
+}
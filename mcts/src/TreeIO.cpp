@@ -0,0 +1,324 @@
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include "../include/mcts.h"
+
+
+using namespace std;
+
+
+/** Tree files (MCTS_tree::save()/load()), in native byte order:
+ *   header  "MCTSTR1\0", uint32 version, uint32 flags (TREE_WITH_STATES), uint32 number of nodes, int32 frame and
+ *           uint64 root key (hash_bytes() of the root's serialize(), 0 if the game has no serializer), followed for trees
+ *           in a symmetric frame (frame != 0, only saved with states) by uint32 length + serialize() of the game state
+ *   nodes   in preorder, each one uint32 children, uint32 simulations, uint32 size, double score, double prior, its
+ *           move ('n' + uint32 count + to_numpy() doubles, 's' + uint32 length + sprint() for moves without an
+ *           encoding, nothing but a 0 byte for the root) and, with TREE_WITH_STATES, uint32 length + serialize()
+ * The whole file is written and read with one call and parsed in memory. */
+#define TREE_MAGIC "MCTSTR1"
+#define TREE_VERSION 1
+#define TREE_WITH_STATES 1u
+
+
+uint64_t hash_bytes(const string &bytes) {
+    uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : bytes) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+template <typename T>
+static void put(string &out, const T &value) {
+    out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+// (see mcts.h) loaded moves are matched by it as well
+string encode_move(const MCTS_move *move) {
+    string out;
+    vector<double> encoding;
+    try {
+        encoding = move->to_numpy();
+    } catch (const std::exception &) {}       // e.g. a Python move without to_numpy(): identified by sprint()
+    if (!encoding.empty()) {
+        out += 'n';
+        put(out, (uint32_t) encoding.size());
+        out.append(reinterpret_cast<const char *>(encoding.data()), encoding.size() * sizeof(double));
+    } else {
+        string text = move->sprint();
+        out += 's';
+        put(out, (uint32_t) text.size());
+        out += text;
+    }
+    return out;
+}
+
+
+struct TreeReader {
+    const char *p, *end;
+    template <typename T>
+    bool get(T &value) {
+        if ((size_t) (end - p) < sizeof(T)) return false;
+        memcpy(&value, p, sizeof(T));
+        p += sizeof(T);
+        return true;
+    }
+    bool get_bytes(size_t n, const char *&data) {
+        if ((size_t) (end - p) < n) return false;
+        data = p;
+        p += n;
+        return true;
+    }
+};
+
+struct NodeRecord {
+    uint32_t children, simulations, size;
+    double score, prior;
+    string move;                             // as encode_move(), empty for the root
+    const char *state;                       // serialize() bytes in the file (NULL without TREE_WITH_STATES)
+    uint32_t state_size;
+};
+
+
+class MCTS_tree_io {
+public:
+    static bool write_node(const MCTS_node *node, bool root, bool with_states, string &out, uint32_t &count,
+                           string &error) {
+        put(out, (uint32_t) node->children.size());
+        put(out, (uint32_t) node->number_of_simulations);
+        put(out, (uint32_t) node->size);
+        put(out, node->score);
+        put(out, node->prior_probability);
+        if (!root) out += encode_move(node->move);
+        else out += '\0';                       // an advanced root keeps the move that led to it: not needed
+        if (with_states) {
+            string state;
+            if (!node->state->serialize(state)) {
+                error = "The game's states can't be serialized (MCTS_state::serialize())";
+                return false;
+            }
+            put(out, (uint32_t) state.size());
+            out += state;
+        }
+        count++;
+        for (const MCTS_node *child : node->children) {
+            if (!write_node(child, false, with_states, out, count, error)) return false;
+        }
+        return true;
+    }
+
+    static bool read_record(TreeReader &in, bool with_states, bool root, NodeRecord &record) {
+        char kind;
+        if (!in.get(record.children) || !in.get(record.simulations) || !in.get(record.size)
+            || !in.get(record.score) || !in.get(record.prior) || !in.get(kind)) return false;
+        record.move.clear();
+        if (root != (kind == '\0')) return false;
+        if (kind == 'n' || kind == 's') {
+            uint32_t length;
+            const char *data;
+            if (!in.get(length)) return false;
+            const size_t bytes = (kind == 'n') ? (size_t) length * sizeof(double) : length;
+            if (!in.get_bytes(bytes, data)) return false;
+            record.move += kind;
+            put(record.move, length);
+            record.move.append(data, bytes);
+        } else if (kind != '\0') {
+            return false;
+        }
+        record.state = NULL;
+        record.state_size = 0;
+        if (with_states) {
+            if (!in.get(record.state_size) || !in.get_bytes(record.state_size, record.state)) return false;
+        }
+        return true;
+    }
+
+    /** Node of record with its subtree, which follows in the file. The node takes over state and move, even on
+     * failure (NULL with the reason in error) */
+    static MCTS_node *read_node(TreeReader &in, MCTS_node *parent, MCTS_state *state, MCTS_move *move,
+                                const NodeRecord &record, const MCTS_state *prototype, uint32_t &count, string &error) {
+        MCTS_node *node = new MCTS_node(parent, state, move, record.prior);
+        node->number_of_simulations = record.simulations;
+        node->size = record.size;
+        node->score = record.score;
+        count++;
+        if (record.children == 0) return node;
+        node->awaiting_evaluation = false;       // its children carry their priors
+        // the saved children are taken out of the untried actions, the rest stay in their order
+        vector<MCTS_move *> actions;
+        vector<double> priors;
+        vector<string> keys;
+        while (!node->untried_actions.empty()) {
+            actions.push_back(node->untried_actions.front());
+            keys.push_back(encode_move(actions.back()));
+            node->untried_actions.pop();
+        }
+        while (!node->action_probabilities.empty()) {
+            priors.push_back(node->action_probabilities.front());
+            node->action_probabilities.pop();
+        }
+        bool ok = true;
+        for (uint32_t c = 0 ; c < record.children && ok ; c++) {
+            NodeRecord child;
+            if (!read_record(in, prototype != NULL, false, child)) {
+                error = "Truncated or corrupted tree file";
+                ok = false;
+                break;
+            }
+            size_t j = 0;
+            while (j < actions.size() && (actions[j] == NULL || keys[j] != child.move)) j++;
+            if (j == actions.size()) {
+                error = "A move of the saved tree isn't among the actions of its state (not the saved root state?)";
+                ok = false;
+                break;
+            }
+            MCTS_move *child_move = actions[j];
+            actions[j] = NULL;                   // from now on owned by the child
+            MCTS_state *child_state = (prototype != NULL) ? prototype->deserialize(child.state, child.state_size)
+                                                          : node->state->next_state(child_move);
+            if (child_state == NULL) {
+                error = "A saved state could not be restored";
+                delete child_move;
+                ok = false;
+                break;
+            }
+            unsigned long long key;
+            int transform;
+            if (child_state->canonical_form(key, transform)) node->child_keys.push_back(key);
+            MCTS_node *child_node = read_node(in, node, child_state, child_move, child, prototype, count, error);
+            if (child_node == NULL) {
+                ok = false;
+                break;
+            }
+            node->children.push_back(child_node);
+        }
+        for (size_t j = 0 ; j < actions.size() ; j++) {
+            if (actions[j] == NULL) continue;
+            node->untried_actions.push(actions[j]);          // deleted with the node on failure
+            if (ok && j < priors.size()) node->action_probabilities.push(priors[j]);
+        }
+        if (!ok) {
+            delete node;
+            return NULL;
+        }
+        return node;
+    }
+};
+
+
+bool MCTS_tree::save(const string &path, bool with_states, string &error) const {
+    if (frame != 0 && !with_states) {
+        // its states are symmetric to the game's: only a tree with states can be loaded again
+        error = "The tree plays in a symmetric frame of the game, save it with states";
+        return false;
+    }
+    string root_state;
+    const uint64_t root_key = root->get_current_state()->serialize(root_state) ? hash_bytes(root_state) : 0;
+    string out(TREE_MAGIC, 8);
+    put(out, (uint32_t) TREE_VERSION);
+    put(out, with_states ? TREE_WITH_STATES : 0u);
+    const size_t count_offset = out.size();
+    put(out, (uint32_t) 0);
+    put(out, (int32_t) frame);
+    put(out, root_key);
+    if (frame != 0) {
+        string game_state;
+        actual_state->serialize(game_state);
+        put(out, (uint32_t) game_state.size());
+        out += game_state;
+    }
+    uint32_t count = 0;
+    if (!MCTS_tree_io::write_node(root, true, with_states, out, count, error)) return false;
+    memcpy(&out[count_offset], &count, sizeof(count));
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file == NULL) {
+        error = "Could not open " + path + " for writing";
+        return false;
+    }
+    const bool written = fwrite(out.data(), 1, out.size(), file) == out.size();
+    if (fclose(file) != 0 || !written) {
+        error = "Could not write " + path;
+        return false;
+    }
+    return true;
+}
+
+MCTS_tree *MCTS_tree::load(const string &path, MCTS_state *starting_state, string &error, StateOwnership ownership) {
+    // starting_state is handled as by the constructor whatever happens
+    MCTS_state *state = (ownership == StateOwnership::COPY) ? starting_state->clone() : starting_state;
+    vector<char> bytes;
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file == NULL) {
+        error = "Could not open " + path;
+        delete state;
+        return NULL;
+    }
+    if (fseek(file, 0, SEEK_END) == 0) {
+        long size = ftell(file);
+        if (size > 0 && fseek(file, 0, SEEK_SET) == 0) {
+            bytes.resize((size_t) size);
+            if (fread(bytes.data(), 1, bytes.size(), file) != bytes.size()) bytes.clear();
+        }
+    }
+    fclose(file);
+    TreeReader in = {bytes.data(), bytes.data() + bytes.size()};
+    const char *magic;
+    uint32_t version = 0, flags = 0, nodes = 0;
+    int32_t frame = 0;
+    uint64_t root_key = 0;
+    if (!in.get_bytes(8, magic) || memcmp(magic, TREE_MAGIC, 8) != 0 || !in.get(version)) {
+        error = path + " is not a tree file";
+        delete state;
+        return NULL;
+    }
+    if (version != TREE_VERSION) {
+        error = path + " has version " + to_string(version) + " (expected " + to_string(TREE_VERSION) + ")";
+        delete state;
+        return NULL;
+    }
+    NodeRecord record;
+    uint32_t game_state_size = 0;
+    const char *game_state = NULL;
+    if (!in.get(flags) || !in.get(nodes) || !in.get(frame) || !in.get(root_key)
+        || (frame != 0 && (!in.get(game_state_size) || !in.get_bytes(game_state_size, game_state)))
+        || !MCTS_tree_io::read_record(in, (flags & TREE_WITH_STATES) != 0, true, record)) {
+        error = "Truncated or corrupted tree file";
+        delete state;
+        return NULL;
+    }
+    const bool with_states = (flags & TREE_WITH_STATES) != 0;
+    MCTS_state *root_state = state, *actual_state = NULL;
+    if (with_states) {
+        // the game's states come from the file and state is only used to restore them
+        root_state = state->deserialize(record.state, record.state_size);
+        if (frame != 0) actual_state = state->deserialize(game_state, game_state_size);
+        if (root_state == NULL || (frame != 0 && actual_state == NULL)) {
+            error = "A saved state could not be restored";
+            delete root_state;
+            delete actual_state;
+            delete state;
+            return NULL;
+        }
+    } else {
+        string serialized;
+        if (frame != 0 || (root_key != 0 && state->serialize(serialized) && hash_bytes(serialized) != root_key)) {
+            error = (frame != 0) ? "Truncated or corrupted tree file" : "The starting state is not the saved tree's root state";
+            delete state;
+            return NULL;
+        }
+    }
+    MCTS_tree *tree = new MCTS_tree();
+    tree->frame = frame;
+    tree->actual_state = actual_state;
+    uint32_t count = 0;
+    tree->root = MCTS_tree_io::read_node(in, NULL, root_state, NULL, record, with_states ? state : NULL, count, error);
+    if (with_states) delete state;       // else the root took it over
+    if (tree->root == NULL || count != nodes || in.p != in.end) {
+        if (tree->root != NULL) error = "Truncated or corrupted tree file";
+        delete tree;
+        return NULL;
+    }
+    return tree;
+}
@@ -1,419 +1,850 @@
-#include <iostream>
-#include <cassert>
-#include <cmath>
-#include <ctime>
-#include <algorithm>
-#include <random>
-#include "../include/mcts.h"
-
-#define DEBUG
-
-
-using namespace std;
-
-/*** STATIC MEMBER DEFINITIONS ***/
-RolloutStrategy MCTS_node::rollout_strategy = RolloutStrategy::RANDOM;
-double MCTS_node::heuristic_ratio = 0.5;
-
-/*** MCTS NODE ***/
-MCTS_node::MCTS_node(MCTS_node *parent, MCTS_state *state, const MCTS_move *move, double prior_probability)
-        : terminal(false), size(0), number_of_simulations(0), score(0.0), 
-          prior_probability(prior_probability), state(state), move(move), 
-          parent(parent) {
-    terminal = this->state->is_terminal();
-    children.reserve(STARTING_NUMBER_OF_CHILDREN);
-    auto* tmp = state->actions_to_try();
-    untried_actions.swap(*tmp);
-    delete tmp;
-    
-    if (!untried_actions.empty()) {
-        vector<double> probs = this->state->get_action_probabilities();
-        if (!probs.empty()) {
-            // Sort untried actions by probability
-            vector<pair<double, MCTS_move*>> paired;
-            size_t i = 0;
-            while (!untried_actions.empty()) {
-                double p = (i < probs.size()) ? probs[i] : 1.0;
-                paired.push_back({p, untried_actions.front()});
-                untried_actions.pop();
-                i++;
-            }
-            
-            sort(paired.begin(), paired.end(), [](const pair<double, MCTS_move*>& a, const pair<double, MCTS_move*>& b) {
-                return a.first > b.first;
-            });
-            
-            for (auto& item : paired) {
-                untried_actions.push(item.second);
-                action_probabilities.push_back(item.first);
-            }
-        } else {
-            // Fill probabilities with 1.0 for each action
-            while (!untried_actions.empty()) {
-                MCTS_move *m = untried_actions.front();
-                untried_actions.pop();
-                action_probabilities.push_back(1.0);
-            }
-        }
-    }
-}
-}
-
-MCTS_node::~MCTS_node() {
-    delete state;
-    delete move;
-    for (auto *child : children) {
-        delete child;
-    }
-    while (!untried_actions.empty()) {
-        delete untried_actions.front();
-        untried_actions.pop();
-    }
-}
-void MCTS_node::expand() {
-    if (is_terminal()) {              // can legitimately happen in end-game situations
-        rollout();                    // keep rolling out, eventually causing UCT to pick another node to expand due to exploration
-        return;
-    } else if (is_fully_expanded()) {
-        cerr << "Warning: Cannot expanded this node any more!" << endl;
-        return;
-    }
-    // get next untried action
-    MCTS_move *next_move = untried_actions.front();
-    untried_actions.pop();
-    
-    // get corresponding probability
-    double prob = 1.0;
-    if (!action_probabilities.empty()) {
-        prob = action_probabilities[0];
-        action_probabilities.erase(action_probabilities.begin());
-    }
-    
-    MCTS_state *next_state = state->next_state(next_move);
-    // build a new MCTS node from it
-    MCTS_node *new_node = new MCTS_node(this, next_state, next_move, prob);
-    // rollout, updating its stats
-    new_node->rollout();
-    // add new node to tree
-    children.push_back(new_node);
-}
-
-void MCTS_node::rollout() {
-    rollout_with_strategy(rollout_strategy);
-}
-
-void MCTS_node::rollout_with_strategy(RolloutStrategy strategy) {
-#ifdef PARALLEL_ROLLOUTS
-    // schedule Jobs with the specified strategy
-    static JobScheduler scheduler;               // static so that we don't create new threads every time (!)
-    double results[NUMBER_OF_THREADS]{-1};
-    for (int i = 0 ; i < NUMBER_OF_THREADS ; i++) {
-        scheduler.schedule(new RolloutJob(state, &results[i], strategy));
-    }
-    // wait for all simulations to finish
-    scheduler.waitUntilJobsHaveFinished();
-    // aggregate results
-    double score_sum = 0.0;
-    for (int i = 0 ; i < NUMBER_OF_THREADS ; i++) {
-        if (results[i] >= 0.0 && results[i] <= 1.0){
-            score_sum += results[i];
-        } else {    // should not happen
-            cerr << "Warning: Invalid result when aggregating parallel rollouts" << endl;
-        }
-    }
-    backpropagate(score_sum, NUMBER_OF_THREADS);
-#else
-    double w;
-    switch (strategy) {
-        case RolloutStrategy::HEURISTIC:
-            w = state->heuristic_rollout();
-            break;
-        case RolloutStrategy::MIXED:
-            // Use heuristic_ratio to decide which rollout to use
-            if (static_cast<double>(rand()) / RAND_MAX < heuristic_ratio) {
-                w = state->heuristic_rollout();
-            } else {
-                w = state->rollout();
-            }
-            break;
-        case RolloutStrategy::HEAVY:
-            w = state->heuristic_rollout();
-            break;
-        case RolloutStrategy::RANDOM:
-        default:
-            w = state->rollout();
-            break;
-    }
-    backpropagate(w, 1);
-#endif
-}
-
-void MCTS_node::backpropagate(double w, int n) {
-    score += w;
-    number_of_simulations += n;
-    if (parent != NULL) {
-        parent->size++;
-        parent->backpropagate(w, n);
-    }
-}
-
-bool MCTS_node::is_fully_expanded() const {
-    return is_terminal() || untried_actions.empty();
-}
-
-bool MCTS_node::is_terminal() const {
-    return terminal;
-}
-
-unsigned int MCTS_node::get_size() const {
-    return size;
-}
-
-MCTS_node *MCTS_node::select_best_child(double c) const {
-    /** selects best child based on the winrate of whose turn it is to play */
-    if (children.empty()) return NULL;
-    else if (children.size() == 1) return children[0];
-    else {
-        double score, max = -1e20;
-        MCTS_node *argmax = NULL;
-        for (auto *child : children) {
-            double winrate = child->score / ((double) child->number_of_simulations);
-            // If it's not the self side's turn, apply UCT based on opponent winrate (our loss rate)
-            if (!state->is_self_side_turn()){
-                winrate = 1.0 - winrate;
-            }
-            if (c > 0) {
-                // PUCT formula: Q + C * P * sqrt(ParentN) / (1 + ChildN)
-                double exploration = c * child->prior_probability * sqrt((double)this->number_of_simulations) / (1.0 + (double)child->number_of_simulations);
-                score = winrate + exploration;
-            } else {
-                score = winrate;
-            }
-            if (score > max) {
-                max = score;
-                argmax = child;
-            }
-        }
-        return argmax;
-    }
-}
-
-MCTS_node *MCTS_node::advance_tree(const MCTS_move *m) {
-    // Find child with this m and delete all others
-    MCTS_node *next = NULL;
-    for (auto *child: children) {
-        if (*(child->move) == *(m)) {
-            next = child;
-        } else {
-            delete child;
-        }
-    }
-    // remove children from queue so that they won't be re-deleted by the destructor when this node dies (!)
-    children.clear();
-    // if not found then we have to create a new node
-    if (next == NULL) {
-        // Note: UCT may lead to not fully explored tree even for short-term children due to terminal nodes being chosen
-        cout << "INFO: Didn't find child node. Had to start over." << endl;
-        MCTS_state *next_state = state->next_state(m);
-        next = new MCTS_node(NULL, next_state, NULL, 1.0);
-    } else {
-        next->parent = NULL;     // make parent NULL
-        // IMPORTANT: m and next->move can be the same here if we pass the move from select_best_child()
-        // (which is what we will typically be doing). If not then it's the caller's responsibility to delete m (!)
-    }
-    // return the next root
-    return next;
-}
-
-
-/*** MCTS TREE ***/
-MCTS_node *MCTS_tree::select(double c) {
-    MCTS_node *node = root;
-    while (!node->is_terminal()) {
-        if (!node->is_fully_expanded()) {
-            return node;
-        } else {
-            node = node->select_best_child(c);
-        }
-    }
-    return node;
-}
-
-MCTS_tree::MCTS_tree(MCTS_state *starting_state) {
-    assert(starting_state != NULL);
-    root = new MCTS_node(NULL, starting_state, NULL);
-}
-
-MCTS_tree::~MCTS_tree() {
-    delete root;
-}
-
-void MCTS_tree::grow_tree(int max_iter, double max_time_in_seconds) {
-    MCTS_node *node;
-    double dt;
-    #ifdef DEBUG
-    cout << "Growing tree..." << endl;
-    #endif
-    time_t start_t, now_t;
-    time(&start_t);
-    for (int i = 0 ; i < max_iter ; i++){
-        // select node to expand according to tree policy
-        node = select();
-        // expand it (this will perform a rollout and backpropagate the results)
-        node->expand();
-        // check if we need to stop
-        time(&now_t);
-        dt = difftime(now_t, start_t);
-        if (dt > max_time_in_seconds) {
-            #ifdef DEBUG
-            cout << "Early stopping: Made " << (i + 1) << " iterations in " << dt << " seconds." << endl;
-            #endif
-            break;
-        }
-    }
-    #ifdef DEBUG
-    time(&now_t);
-    dt = difftime(now_t, start_t);
-    cout << "Finished in " << dt << " seconds." << endl;
-    #endif
-}
-
-unsigned int MCTS_tree::get_size() const {
-    return root->get_size();
-}
-
-const MCTS_move *MCTS_node::get_move() const {
-    return move;
-}
-
-const MCTS_state *MCTS_node::get_current_state() const { return state; }
-
-void MCTS_node::print_stats() const {
-    #define TOPK 10
-    if (number_of_simulations == 0) {
-        cout << "Tree not expanded yet" << endl;
-        return;
-    }
-    cout << "___ INFO _______________________" << endl
-         << "Tree size: " << size << endl
-         << "Number of simulations: " << number_of_simulations << endl
-         << "Branching factor at root: " << children.size() << endl
-         << "Chances of self side winning: " << setprecision(4) << 100.0 * (score / number_of_simulations) << "%" << endl;
-    // sort children based on winrate of current player's turn for this node
-    if (state->is_self_side_turn()) {
-        std::sort(children.begin(), children.end(), [](const MCTS_node *n1, const MCTS_node *n2){
-            return n1->calculate_winrate(true) > n2->calculate_winrate(true);
-        });
-    } else {
-        std::sort(children.begin(), children.end(), [](const MCTS_node *n1, const MCTS_node *n2){
-            return n1->calculate_winrate(false) > n2->calculate_winrate(false);
-        });
-    }
-    // print TOPK of them along with their winrates
-    cout << "Best moves:" << endl;
-    for (int i = 0 ; i < children.size() && i < TOPK ; i++) {
-        cout << "  " << i + 1 << ". " << children[i]->move->sprint() << "  -->  "
-             << setprecision(4) << 100.0 * children[i]->calculate_winrate(state->is_self_side_turn()) << "%" << endl;
-    }
-    cout << "________________________________" << endl;
-}
-
-double MCTS_node::calculate_winrate(bool self_side_turn) const {
-    if (self_side_turn) {
-        return score / number_of_simulations;
-    } else {
-        return 1.0 - score / number_of_simulations;
-    }
-}
-
-// Static configuration methods
-void MCTS_node::set_rollout_strategy(RolloutStrategy strategy) {
-    rollout_strategy = strategy;
-}
-
-RolloutStrategy MCTS_node::get_rollout_strategy() {
-    return rollout_strategy;
-}
-
-void MCTS_node::set_heuristic_ratio(double ratio) {
-    if (ratio >= 0.0 && ratio <= 1.0) {
-        heuristic_ratio = ratio;
-    } else {
-        cerr << "Warning: Heuristic ratio must be between 0.0 and 1.0" << endl;
-    }
-}
-
-double MCTS_node::get_heuristic_ratio() {
-    return heuristic_ratio;
-}
-
-void MCTS_tree::advance_tree(const MCTS_move *move) {
-    MCTS_node *old_root = root;
-    root = root->advance_tree(move);
-    delete old_root;       // this won't delete the new root since we have emptied old_root's children
-}
-
-const MCTS_state *MCTS_tree::get_current_state() const { return root->get_current_state(); }
-
-MCTS_node *MCTS_tree::select_best_child() {
-    return root->select_best_child(0.0);
-}
-
-void MCTS_tree::print_stats() const { root->print_stats(); }
-
-
-/*** MCTS agent ***/
-MCTS_agent::MCTS_agent(MCTS_state *starting_state, int max_iter, int max_seconds)
-: max_iter(max_iter), max_seconds(max_seconds) {
-    tree = new MCTS_tree(starting_state);
-}
-
-const MCTS_move *MCTS_agent::genmove(const MCTS_move *enemy_move) {
-    if (enemy_move != NULL) {
-        tree->advance_tree(enemy_move);
-    }
-    // If game ended from opponent move, we can't do anything
-    if (tree->get_current_state()->is_terminal()) {
-        return NULL;
-    }
-    #ifdef DEBUG
-    cout << "___ DEBUG ______________________" << endl
-         << "Growing tree..." << endl;
-    #endif
-    tree->grow_tree(max_iter, max_seconds);
-    #ifdef DEBUG
-    cout << "Tree size: " << tree->get_size() << endl
-         << "________________________________" << endl;
-    #endif
-    MCTS_node *best_child = tree->select_best_child();
-    if (best_child == NULL) {
-        cerr << "Warning: Tree root has no children! Possibly terminal node!" << endl;
-        return NULL;
-    }
-    const MCTS_move *best_move = best_child->get_move();
-    tree->advance_tree(best_move);
-    return best_move;
-}
-
-MCTS_agent::~MCTS_agent() {
-    delete tree;
-}
-
-const MCTS_state *MCTS_agent::get_current_state() const { return tree->get_current_state(); }
-
-// Rollout strategy configuration methods
-void MCTS_agent::set_rollout_strategy(RolloutStrategy strategy) {
-    MCTS_node::set_rollout_strategy(strategy);
-}
-
-RolloutStrategy MCTS_agent::get_rollout_strategy() const {
-    return MCTS_node::get_rollout_strategy();
-}
-
-void MCTS_agent::set_heuristic_ratio(double ratio) {
-    MCTS_node::set_heuristic_ratio(ratio);
-}
-
-double MCTS_agent::get_heuristic_ratio() const {
-    return MCTS_node::get_heuristic_ratio();
-}
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <ctime>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <functional>
+#include "../include/mcts.h"
+#include "../include/OpeningBook.h"
+
+#define DEBUG
+
+
+using namespace std;
+
+/*** STATIC MEMBER DEFINITIONS ***/
+RolloutStrategy MCTS_node::rollout_strategy = RolloutStrategy::RANDOM;
+double MCTS_node::heuristic_ratio = 0.5;
+bool MCTS_node::decisive_moves = false;
+int MCTS_node::leaf_batch_size = 1;
+unsigned int MCTS_node::rollout_thread_limit = 0;
+shared_ptr<MCTS_evaluator> MCTS_node::evaluator;
+#ifdef PARALLEL_ROLLOUTS
+int MCTS_node::rollouts_per_leaf = NUMBER_OF_THREADS;
+#else
+int MCTS_node::rollouts_per_leaf = 1;
+#endif
+
+/*** MCTS NODE ***/
+MCTS_node::MCTS_node(MCTS_node *parent, MCTS_state *state, const MCTS_move *move, double prior_probability)
+        : terminal(false), awaiting_evaluation(false), size(0), number_of_simulations(0), score(0.0), 
+          prior_probability(prior_probability), state(state), move(move), 
+          parent(parent) {
+    terminal = this->state->is_terminal();
+    children.reserve(STARTING_NUMBER_OF_CHILDREN);
+    auto* tmp = state->actions_to_try();
+    untried_actions.swap(*tmp);
+    delete tmp;
+    
+    if (!untried_actions.empty()) {
+        // with an evaluator the priors come later, in a batch with other leaves
+        awaiting_evaluation = !terminal && get_evaluator() != nullptr;
+        if (!awaiting_evaluation) set_priors(this->state->get_action_probabilities(), false);
+    }
+}
+
+void MCTS_node::set_priors(const vector<double> &priors, bool indexed) {
+    if (priors.empty()) return;
+    indexed = indexed && state->action_space_size() > 0;     // else the game has no action_index()
+    vector<pair<double, MCTS_move*>> paired;
+    size_t i = 0;
+    while (!untried_actions.empty()) {
+        MCTS_move *m = untried_actions.front();
+        double p;
+        if (indexed) {
+            int index = state->action_index(m);
+            p = (index >= 0 && (size_t) index < priors.size()) ? priors[index] : 0.0;
+        } else {
+            p = (i < priors.size()) ? priors[i] : 1.0;
+        }
+        paired.push_back({p, m});
+        untried_actions.pop();
+        i++;
+    }
+    // most probable actions are expanded first (ties keep the order of actions_to_try())
+    stable_sort(paired.begin(), paired.end(), [](const pair<double, MCTS_move*>& a, const pair<double, MCTS_move*>& b) {
+        return a.first > b.first;
+    });
+    for (auto& item : paired) {
+        untried_actions.push(item.second);
+        action_probabilities.push(item.first);
+    }
+}
+
+MCTS_node::~MCTS_node() {
+    delete state;
+    delete move;
+    for (auto *child : children) {
+        delete child;
+    }
+    while (!untried_actions.empty()) {
+        delete untried_actions.front();
+        untried_actions.pop();
+    }
+}
+void MCTS_node::expand() {
+    if (is_terminal()) {              // can legitimately happen in end-game situations
+        rollout();                    // keep rolling out, eventually causing UCT to pick another node to expand due to exploration
+        return;
+    } else if (is_fully_expanded()) {
+        cerr << "Warning: Cannot expanded this node any more!" << endl;
+        return;
+    }
+    MCTS_node *new_node = add_child();
+    if (new_node != NULL) {
+        // rollout, updating its stats
+        new_node->rollout();
+    } else {
+        // all the remaining actions were symmetric to existing children, so this node is now fully expanded
+        rollout();
+    }
+}
+
+MCTS_node *MCTS_node::expand_pending() {
+    MCTS_node *leaf = this;
+    if (!is_terminal()) {
+        if (is_fully_expanded()) {
+            cerr << "Warning: Cannot expanded this node any more!" << endl;
+            return NULL;
+        }
+        MCTS_node *new_node = add_child();
+        if (new_node != NULL) leaf = new_node;
+    }
+    // until its rollouts are in, count the leaf as a draw so that select() sees it visited and moves on
+    leaf->virtual_visit(true);
+    return leaf;
+}
+
+MCTS_node *MCTS_node::add_child() {
+    while (!untried_actions.empty()) {
+        // get next untried action
+        MCTS_move *next_move = untried_actions.front();
+        untried_actions.pop();
+
+        // get corresponding probability
+        double prob = 1.0;
+        if (!action_probabilities.empty()) {
+            prob = action_probabilities.front();
+            action_probabilities.pop();
+        }
+
+        MCTS_state *next_state = state->next_state(next_move);
+        // skip actions leading to a state symmetric to an existing child's: its stats would be the same
+        unsigned long long key;
+        int transform;
+        if (next_state->canonical_form(key, transform)) {
+            if (find(child_keys.begin(), child_keys.end(), key) != child_keys.end()) {
+                delete next_state;
+                delete next_move;
+                continue;
+            }
+            child_keys.push_back(key);
+        }
+        // build a new MCTS node from it (the node takes over next_state: one state allocation per expansion)
+        MCTS_node *new_node = new MCTS_node(this, next_state, next_move, prob);
+        // add new node to tree
+        children.push_back(new_node);
+        return new_node;
+    }
+    return NULL;
+}
+
+void MCTS_node::virtual_visit(bool add) {
+    for (MCTS_node *node = this ; node != NULL ; node = node->parent) {
+        if (add) {
+            node->score += 0.5;
+            node->number_of_simulations++;
+        } else {
+            node->score -= 0.5;
+            node->number_of_simulations--;
+        }
+    }
+}
+
+void MCTS_node::rollout_pending(const vector<MCTS_node *> &leaves) {
+    if (leaves.empty()) return;
+    const int count = rollouts_per_leaf;
+    vector<double> results;
+    if (rollout_strategy == RolloutStrategy::RANDOM && !decisive_moves) {
+        // one call for the whole batch: lets the game simulate all the leaves at once
+        vector<const MCTS_state *> states;
+        states.reserve(leaves.size());
+        for (auto *leaf : leaves) states.push_back(leaf->state);
+        results = states[0]->rollout_many(states, count);
+        if (results.size() != leaves.size()) {
+            cerr << "Warning: rollout_many() returned " << results.size() << " results for " << leaves.size() << " states" << endl;
+            results.clear();
+        }
+    }
+    for (size_t i = 0 ; i < leaves.size() ; i++) {
+        double w = (i < results.size()) ? results[i] : simulate(leaves[i]->state, rollout_strategy, count);
+        if (w < 0.0 || w > count) {     // should not happen
+            cerr << "Warning: Invalid result when aggregating batched rollouts" << endl;
+            w = 0.5 * count;
+        }
+        leaves[i]->virtual_visit(false);
+        leaves[i]->backpropagate(w, count);
+    }
+}
+
+void MCTS_node::evaluate(MCTS_evaluator &evaluator) {
+    virtual_visit(true);
+    evaluate_pending(vector<MCTS_node *>(1, this), evaluator);
+}
+
+void MCTS_node::evaluate_pending(const vector<MCTS_node *> &leaves, MCTS_evaluator &evaluator) {
+    if (leaves.empty()) return;
+    // terminal leaves (and any other leaf evaluated before) are simulated: exact for terminal states
+    vector<const MCTS_state *> states;
+    for (auto *leaf : leaves) {
+        if (leaf->awaiting_evaluation) states.push_back(leaf->state);
+    }
+    vector<vector<double>> priors;
+    vector<double> values;
+    if (!states.empty()) {
+        bool ok = false;
+        try {
+            ok = evaluator.evaluate(states, priors, values);
+        } catch (const std::exception &e) {
+            cerr << "Warning: Evaluator threw exception: " << e.what() << endl;
+        }
+        if (ok && (priors.size() != states.size() || values.size() != states.size())) {
+            cerr << "Warning: The evaluator returned " << priors.size() << " priors and " << values.size()
+                 << " values for " << states.size() << " states" << endl;
+            ok = false;
+        }
+        if (!ok) {                      // fall back to rollouts with uniform priors
+            for (auto *leaf : leaves) leaf->awaiting_evaluation = false;
+            rollout_pending(leaves);
+            return;
+        }
+    }
+    size_t next = 0;
+    for (auto *leaf : leaves) {
+        double w;
+        if (leaf->awaiting_evaluation) {
+            leaf->set_priors(priors[next], evaluator.indexed_priors());
+            w = values[next++];
+            leaf->awaiting_evaluation = false;
+            if (!(w >= 0.0 && w <= 1.0)) {
+                cerr << "Warning: Invalid value returned by the evaluator" << endl;
+                w = 0.5;
+            }
+        } else {
+            w = simulate(leaf->state, rollout_strategy, 1);
+        }
+        leaf->virtual_visit(false);
+        leaf->backpropagate(w, 1);
+    }
+}
+
+void MCTS_node::rollout() {
+    rollout_with_strategy(rollout_strategy);
+}
+
+#ifdef PARALLEL_ROLLOUTS
+/** The pool is sized for the hardware once and never destroyed: its workers may be running (or, for Python states,
+ * waiting on the GIL) when static destructors run at exit, so joining them there could hang. **/
+static JobScheduler &rollout_pool() {
+    static JobScheduler *pool = new JobScheduler(MCTS_node::get_rollout_thread_count());
+    return *pool;
+}
+
+/** Jobs are tagged by the thread that scheduled them so that searches running concurrently (e.g. from different
+ * Python threads) only wait for their own rollouts **/
+static int rollout_tag() {
+    return (int) (std::hash<std::thread::id>()(std::this_thread::get_id()) & 0x3FFFFFFF);
+}
+#endif
+
+void MCTS_node::rollout_with_strategy(RolloutStrategy strategy) {
+    const int count = rollouts_per_leaf;
+#ifdef PARALLEL_ROLLOUTS
+    // split the simulations among (at most) one job per thread, each running its share as a single batch that
+    // is no smaller than what the state's rollout_n() simulates at once (only RANDOM rollouts go through it)
+    unsigned int threads = get_rollout_thread_count();
+    if (rollout_thread_limit > 0) threads = min(threads, rollout_thread_limit);
+    const int batch = (strategy == RolloutStrategy::RANDOM && !decisive_moves) ? max(1, state->rollout_batch_size()) : 1;
+    const int jobs = min(max(1, count / batch), (int) threads);
+    if (jobs <= 1) {                             // nothing to split: don't pay for the hand-off to the pool
+        backpropagate(simulate(state, strategy, count), count);
+        return;
+    }
+    const int tag = rollout_tag();
+    vector<double> results(jobs, -1.0);
+    vector<int> shares(jobs);
+    for (int i = 0 ; i < jobs ; i++) {
+        shares[i] = count / jobs + ((i < count % jobs) ? 1 : 0);
+        rollout_pool().schedule(new RolloutJob(state, &results[i], strategy, shares[i], tag));
+    }
+    // wait for all simulations to finish
+    rollout_pool().waitUntilJobsHaveFinished(tag);
+    // aggregate results
+    double score_sum = 0.0;
+    int simulations = 0;
+    for (int i = 0 ; i < jobs ; i++) {
+        if (results[i] >= 0.0 && results[i] <= shares[i]){
+            score_sum += results[i];
+            simulations += shares[i];
+        } else {    // should not happen unless the state's rollout failed
+            cerr << "Warning: Invalid result when aggregating parallel rollouts" << endl;
+        }
+    }
+    if (simulations == 0) {
+        cerr << "Warning: All parallel rollouts failed, falling back to a single rollout" << endl;
+        backpropagate(simulate(state, strategy, 1), 1);
+    } else {
+        backpropagate(score_sum, simulations);
+    }
+#else
+    backpropagate(simulate(state, strategy, count), count);
+#endif
+}
+
+double MCTS_node::simulate(const MCTS_state *state, RolloutStrategy strategy, int count) {
+    double w = 0.0;
+    switch (strategy) {
+        case RolloutStrategy::HEURISTIC:
+        case RolloutStrategy::HEAVY:
+            for (int i = 0 ; i < count ; i++) {
+                w += state->heuristic_rollout();
+            }
+            break;
+        case RolloutStrategy::MIXED:
+            // Use heuristic_ratio to decide which rollout to use for every simulation
+            for (int i = 0 ; i < count ; i++) {
+                if (static_cast<double>(rand()) / RAND_MAX < heuristic_ratio) {
+                    w += state->heuristic_rollout();
+                } else {
+                    w += decisive_moves ? decisive_rollout(state) : state->rollout();
+                }
+            }
+            break;
+        case RolloutStrategy::RANDOM:
+        default:
+            if (decisive_moves) {
+                for (int i = 0 ; i < count ; i++) {
+                    w += decisive_rollout(state);
+                }
+            } else {
+                w = state->rollout_n(count);     // one batch: lets the state simulate several games at once
+            }
+            break;
+    }
+    return w;
+}
+
+double MCTS_node::decisive_rollout(const MCTS_state *state) {
+    // decisive moves for as long as there are any, then the game's own rollout() from there
+    MCTS_state *s = state->clone();
+    for (int depth = 0 ; !s->is_terminal() ; depth++) {
+        if (depth == MAX_DECISIVE_ROLLOUT_DEPTH) {
+            double eval = s->evaluate_position();
+            delete s;
+            return eval;
+        }
+        MCTS_move *m = s->winning_move();
+        if (m == NULL) m = s->blocking_move();
+        if (m == NULL) break;
+        MCTS_state *next = s->next_state(m);
+        delete m;
+        if (next == NULL) {     // should not happen
+            cerr << "Warning: Decisive rollout could not play a decisive move" << endl;
+            break;
+        }
+        delete s;
+        s = next;
+    }
+    double result = s->rollout();   // of a terminal state: its outcome
+    delete s;
+    return result;
+}
+
+void MCTS_node::backpropagate(double w, int n) {
+    score += w;
+    number_of_simulations += n;
+    if (parent != NULL) {
+        parent->size++;
+        parent->backpropagate(w, n);
+    }
+}
+
+bool MCTS_node::is_fully_expanded() const {
+    return is_terminal() || untried_actions.empty();
+}
+
+bool MCTS_node::is_terminal() const {
+    return terminal;
+}
+
+unsigned int MCTS_node::get_size() const {
+    return size;
+}
+
+MCTS_node *MCTS_node::select_best_child(double c) const {
+    /** selects best child based on the winrate of whose turn it is to play */
+    if (children.empty()) return NULL;
+    else if (children.size() == 1) return children[0];
+    else {
+        double score, max = -1e20;
+        MCTS_node *argmax = NULL;
+        for (auto *child : children) {
+            double winrate = child->score / ((double) child->number_of_simulations);
+            // If it's not the self side's turn, apply UCT based on opponent winrate (our loss rate)
+            if (!state->is_self_side_turn()){
+                winrate = 1.0 - winrate;
+            }
+            if (c > 0) {
+                // PUCT formula: Q + C * P * sqrt(ParentN) / (1 + ChildN)
+                double exploration = c * child->prior_probability * sqrt((double)this->number_of_simulations) / (1.0 + (double)child->number_of_simulations);
+                score = winrate + exploration;
+            } else {
+                score = winrate;
+            }
+            if (score > max) {
+                max = score;
+                argmax = child;
+            }
+        }
+        return argmax;
+    }
+}
+
+MCTS_node *MCTS_node::advance_tree(const MCTS_move *m, int *transform) {
+    // Find child with this m
+    MCTS_node *next = NULL;
+    MCTS_state *next_state = NULL;
+    if (transform != NULL) *transform = 0;
+    size_t hash, child_hash;
+    const bool hashed = m->get_hash(hash);
+    for (auto *child: children) {
+        if (hashed && child->move->get_hash(child_hash) && child_hash != hash) continue;    // can't be equal
+        if (*(child->move) == *(m)) {
+            next = child;
+            break;
+        }
+    }
+    // if m's child was merged into a symmetric one then continue from that one instead
+    unsigned long long key;
+    int t;
+    if (next == NULL && transform != NULL && !child_keys.empty()) {
+        next_state = state->next_state(m);
+        if (next_state != NULL && next_state->canonical_form(key, t)) {
+            for (auto *child: children) {
+                unsigned long long child_key;
+                int child_t;
+                if (child->state->canonical_form(child_key, child_t) && child_key == key) {
+                    next = child;
+                    // m's state -> canonical -> child's state
+                    *transform = state->compose_transforms(t, state->inverse_transform(child_t));
+                    break;
+                }
+            }
+        }
+    }
+    // delete all others
+    for (auto *child: children) {
+        if (child != next) delete child;
+    }
+    // remove children from queue so that they won't be re-deleted by the destructor when this node dies (!)
+    children.clear();
+    // if not found then we have to create a new node
+    if (next == NULL) {
+        // Note: UCT may lead to not fully explored tree even for short-term children due to terminal nodes being chosen
+        cout << "INFO: Didn't find child node. Had to start over." << endl;
+        if (next_state == NULL) next_state = state->next_state(m);
+        next = new MCTS_node(NULL, next_state, NULL, 1.0);
+    } else {
+        delete next_state;
+        next->parent = NULL;     // make parent NULL
+        // IMPORTANT: m and next->move can be the same here if we pass the move from select_best_child()
+        // (which is what we will typically be doing). If not then it's the caller's responsibility to delete m (!)
+    }
+    // return the next root
+    return next;
+}
+
+
+/*** MCTS TREE ***/
+MCTS_node *MCTS_tree::select(double c) {
+    MCTS_node *node = root;
+    while (!node->is_terminal()) {
+        if (!node->is_fully_expanded()) {
+            return node;
+        } else {
+            node = node->select_best_child(c);
+        }
+    }
+    return node;
+}
+
+MCTS_tree::MCTS_tree(MCTS_state *starting_state, StateOwnership ownership) : frame(0), actual_state(NULL), actual_move(NULL) {
+    assert(starting_state != NULL);
+    // from here on every state in the tree is owned by its node
+    root = new MCTS_node(NULL, (ownership == StateOwnership::COPY) ? starting_state->clone() : starting_state, NULL);
+}
+
+MCTS_tree::~MCTS_tree() {
+    delete root;
+    delete actual_state;
+    delete actual_move;
+}
+
+void MCTS_tree::grow_tree(int max_iter, double max_time_in_seconds, const atomic<bool> *stop) {
+    MCTS_node *node;
+    double dt;
+    #ifdef DEBUG
+    cout << "Growing tree..." << endl;
+    #endif
+    time_t start_t, now_t;
+    time(&start_t);
+    vector<MCTS_node *> leaves;
+    shared_ptr<MCTS_evaluator> evaluator = MCTS_node::get_evaluator();     // the same one for the whole search
+    if (evaluator && root->is_awaiting_evaluation()) {
+        root->evaluate(*evaluator);     // its priors order the first expansions
+    }
+    for (int i = 0 ; i < max_iter ; ){
+        if (MCTS_node::get_leaf_batch_size() <= 1 && !evaluator) {
+            // select node to expand according to tree policy
+            node = select();
+            // expand it (this will perform a rollout and backpropagate the results)
+            node->expand();
+            i++;
+        } else {
+            // select and expand up to a batch of leaves, then simulate them all at once
+            leaves.clear();
+            while ((int) leaves.size() < MCTS_node::get_leaf_batch_size() && i < max_iter) {
+                node = select();
+                // reached a leaf of this batch that still waits for its priors: evaluate the batch before going on
+                if (node->is_awaiting_evaluation() && !leaves.empty()) break;
+                node = node->expand_pending();
+                i++;
+                if (node == NULL) break;
+                leaves.push_back(node);
+            }
+            if (evaluator) {
+                MCTS_node::evaluate_pending(leaves, *evaluator);
+            } else {
+                MCTS_node::rollout_pending(leaves);
+            }
+        }
+        // check if we need to stop
+        if (stop != NULL && stop->load(memory_order_relaxed)) {
+            #ifdef DEBUG
+            cout << "Stopped: Made " << i << " iterations." << endl;
+            #endif
+            break;
+        }
+        time(&now_t);
+        dt = difftime(now_t, start_t);
+        if (dt > max_time_in_seconds) {
+            #ifdef DEBUG
+            cout << "Early stopping: Made " << i << " iterations in " << dt << " seconds." << endl;
+            #endif
+            break;
+        }
+    }
+    #ifdef DEBUG
+    time(&now_t);
+    dt = difftime(now_t, start_t);
+    cout << "Finished in " << dt << " seconds." << endl;
+    #endif
+}
+
+unsigned int MCTS_tree::get_size() const {
+    return root->get_size();
+}
+
+const MCTS_move *MCTS_node::get_move() const {
+    return move;
+}
+
+const MCTS_state *MCTS_node::get_current_state() const { return state; }
+
+void MCTS_node::print_stats() const {
+    #define TOPK 10
+    if (number_of_simulations == 0) {
+        cout << "Tree not expanded yet" << endl;
+        return;
+    }
+    cout << "___ INFO _______________________" << endl
+         << "Tree size: " << size << endl
+         << "Number of simulations: " << number_of_simulations << endl
+         << "Branching factor at root: " << children.size() << endl
+         << "Chances of self side winning: " << setprecision(4) << 100.0 * (score / number_of_simulations) << "%" << endl;
+    // sort children based on winrate of current player's turn for this node
+    if (state->is_self_side_turn()) {
+        std::sort(children.begin(), children.end(), [](const MCTS_node *n1, const MCTS_node *n2){
+            return n1->calculate_winrate(true) > n2->calculate_winrate(true);
+        });
+    } else {
+        std::sort(children.begin(), children.end(), [](const MCTS_node *n1, const MCTS_node *n2){
+            return n1->calculate_winrate(false) > n2->calculate_winrate(false);
+        });
+    }
+    // print TOPK of them along with their winrates
+    cout << "Best moves:" << endl;
+    for (int i = 0 ; i < children.size() && i < TOPK ; i++) {
+        cout << "  " << i + 1 << ". " << children[i]->move->sprint() << "  -->  "
+             << setprecision(4) << 100.0 * children[i]->calculate_winrate(state->is_self_side_turn()) << "%" << endl;
+    }
+    cout << "________________________________" << endl;
+}
+
+double MCTS_node::calculate_winrate(bool self_side_turn) const {
+    if (self_side_turn) {
+        return score / number_of_simulations;
+    } else {
+        return 1.0 - score / number_of_simulations;
+    }
+}
+
+// Static configuration methods
+void MCTS_node::set_rollout_strategy(RolloutStrategy strategy) {
+    rollout_strategy = strategy;
+}
+
+RolloutStrategy MCTS_node::get_rollout_strategy() {
+    return rollout_strategy;
+}
+
+void MCTS_node::set_heuristic_ratio(double ratio) {
+    if (ratio >= 0.0 && ratio <= 1.0) {
+        heuristic_ratio = ratio;
+    } else {
+        cerr << "Warning: Heuristic ratio must be between 0.0 and 1.0" << endl;
+    }
+}
+
+double MCTS_node::get_heuristic_ratio() {
+    return heuristic_ratio;
+}
+
+void MCTS_node::set_rollouts_per_leaf(int count) {
+    if (count >= 1) {
+        rollouts_per_leaf = count;
+    } else {
+        cerr << "Warning: Rollouts per leaf must be at least 1" << endl;
+    }
+}
+
+int MCTS_node::get_rollouts_per_leaf() {
+    return rollouts_per_leaf;
+}
+
+void MCTS_node::set_rollout_thread_limit(unsigned int limit) {
+    rollout_thread_limit = limit;
+}
+
+unsigned int MCTS_node::get_rollout_thread_limit() {
+    return rollout_thread_limit;
+}
+
+void MCTS_node::set_decisive_moves(bool enabled) {
+    decisive_moves = enabled;
+}
+
+bool MCTS_node::get_decisive_moves() {
+    return decisive_moves;
+}
+
+void MCTS_node::set_leaf_batch_size(int size) {
+    if (size >= 1) {
+        leaf_batch_size = size;
+    } else {
+        cerr << "Warning: Leaf batch size must be at least 1" << endl;
+    }
+}
+
+int MCTS_node::get_leaf_batch_size() {
+    return leaf_batch_size;
+}
+
+void MCTS_node::set_evaluator(shared_ptr<MCTS_evaluator> new_evaluator) {
+    atomic_store(&evaluator, new_evaluator);
+}
+
+shared_ptr<MCTS_evaluator> MCTS_node::get_evaluator() {
+    return atomic_load(&evaluator);
+}
+
+unsigned int MCTS_node::get_rollout_thread_count() {
+#ifdef PARALLEL_ROLLOUTS
+    // asked on every rollout so only query the hardware (a system call) once
+    static const unsigned int hw_threads = std::thread::hardware_concurrency();
+    if (hw_threads == 0) return NUMBER_OF_THREADS;      // detection failed
+    return min(hw_threads, 2u * NUMBER_OF_THREADS);      // more threads rarely help with rollouts this short
+#else
+    return 1;
+#endif
+}
+
+void MCTS_tree::advance_tree(const MCTS_move *move) {
+    // bring the move into the tree's frame
+    const MCTS_state *game_state = get_current_state();
+    MCTS_move *tree_move = (frame != 0) ? root->get_current_state()->transform_move(move, frame) : NULL;
+    int transform;
+    MCTS_node *old_root = root;
+    root = root->advance_tree((tree_move != NULL) ? tree_move : move, &transform);
+    if (transform != 0 || frame != 0) {
+        // the tree's states differ from the game's by a symmetry so keep track of the actual game state as well
+        frame = old_root->get_current_state()->compose_transforms(frame, transform);
+        MCTS_state *next_actual = (frame != 0) ? game_state->next_state(move) : NULL;
+        delete actual_state;
+        actual_state = next_actual;
+    }
+    delete tree_move;      // the tree's nodes hold their own moves
+    delete old_root;       // this won't delete the new root since we have emptied old_root's children
+}
+
+const MCTS_move *MCTS_tree::to_game_move(const MCTS_move *tree_move) {
+    if (frame == 0) return tree_move;
+    delete actual_move;
+    actual_move = root->get_current_state()->transform_move(tree_move, root->get_current_state()->inverse_transform(frame));
+    return actual_move;
+}
+
+const MCTS_state *MCTS_tree::get_current_state() const { return (actual_state != NULL) ? actual_state : root->get_current_state(); }
+
+MCTS_node *MCTS_tree::select_best_child() {
+    return root->select_best_child(0.0);
+}
+
+void MCTS_tree::print_stats() const { root->print_stats(); }
+
+void MCTS_tree::get_root_stats(MCTS_root_stats &stats) {
+    const vector<MCTS_node *> &children = root->get_children();
+    const bool self_side_turn = root->get_current_state()->is_self_side_turn();
+    stats.visits.clear();
+    stats.values.clear();
+    stats.priors.clear();
+    stats.encodings.clear();
+    stats.encoding_size = 0;
+    bool same_size = true;
+    for (auto *child : children) {
+        stats.visits.push_back(child->get_number_of_simulations());
+        stats.values.push_back(child->calculate_winrate(self_side_turn));
+        stats.priors.push_back(child->get_prior_probability());
+        vector<double> encoding;
+        try {
+            encoding = to_game_move(child->get_move())->to_numpy();
+        } catch (const std::exception &) {        // e.g. a Python move without to_numpy(): stats without encodings
+            same_size = false;
+        }
+        if (child == children[0]) stats.encoding_size = encoding.size();
+        same_size = same_size && encoding.size() == stats.encoding_size;
+        stats.encodings.insert(stats.encodings.end(), encoding.begin(), encoding.end());
+    }
+    if (!same_size) {
+        stats.encodings.clear();
+        stats.encoding_size = 0;
+    }
+}
+
+
+/*** MCTS agent ***/
+MCTS_agent::MCTS_agent(MCTS_state *starting_state, int max_iter, int max_seconds, StateOwnership ownership)
+: max_iter(max_iter), max_seconds(max_seconds), book_seed_visits(0), book_play_visits(0) {
+    tree = new MCTS_tree(starting_state, ownership);
+}
+
+const MCTS_move *MCTS_agent::genmove(const MCTS_move *enemy_move, const atomic<bool> *stop) {
+    last_search_stats = MCTS_root_stats();
+    if (enemy_move != NULL) {
+        tree->advance_tree(enemy_move);
+    }
+    // If game ended from opponent move, we can't do anything
+    if (tree->get_current_state()->is_terminal()) {
+        return NULL;
+    }
+    MCTS_node *best_child = NULL;
+    if (book) {
+        unsigned int book_visits;
+        MCTS_node *book_child = book->seed(*tree, book_seed_visits, book_visits);
+        // positions the book knows well enough are played without searching
+        if (book_play_visits > 0 && book_visits >= book_play_visits) best_child = book_child;
+    }
+    if (best_child == NULL) {
+        #ifdef DEBUG
+        cout << "___ DEBUG ______________________" << endl
+             << "Growing tree..." << endl;
+        #endif
+        tree->grow_tree(max_iter, max_seconds, stop);
+        #ifdef DEBUG
+        cout << "Tree size: " << tree->get_size() << endl
+             << "________________________________" << endl;
+        #endif
+        best_child = tree->select_best_child();
+    }
+    if (best_child == NULL) {
+        cerr << "Warning: Tree root has no children! Possibly terminal node!" << endl;
+        return NULL;
+    }
+    tree->get_root_stats(last_search_stats);
+    const MCTS_move *best_move = tree->to_game_move(best_child->get_move());
+    tree->advance_tree(best_move);
+    return best_move;
+}
+
+MCTS_agent::~MCTS_agent() {
+    delete tree;
+}
+
+bool MCTS_agent::load_tree(const string &path, string &error) {
+    MCTS_tree *loaded = MCTS_tree::load(path, tree->get_current_state()->clone(), error);
+    if (loaded == NULL) return false;
+    delete tree;
+    tree = loaded;
+    return true;
+}
+
+void MCTS_agent::set_opening_book(shared_ptr<const OpeningBook> book, unsigned int seed_visits, unsigned int play_visits) {
+    this->book = book;
+    book_seed_visits = seed_visits;
+    book_play_visits = play_visits;
+}
+
+const MCTS_state *MCTS_agent::get_current_state() const { return tree->get_current_state(); }
+
+// Rollout strategy configuration methods
+void MCTS_agent::set_rollout_strategy(RolloutStrategy strategy) {
+    MCTS_node::set_rollout_strategy(strategy);
+}
+
+RolloutStrategy MCTS_agent::get_rollout_strategy() const {
+    return MCTS_node::get_rollout_strategy();
+}
+
+void MCTS_agent::set_heuristic_ratio(double ratio) {
+    MCTS_node::set_heuristic_ratio(ratio);
+}
+
+double MCTS_agent::get_heuristic_ratio() const {
+    return MCTS_node::get_heuristic_ratio();
+}
+
+void MCTS_agent::set_rollouts_per_leaf(int count) {
+    MCTS_node::set_rollouts_per_leaf(count);
+}
+
+int MCTS_agent::get_rollouts_per_leaf() const {
+    return MCTS_node::get_rollouts_per_leaf();
+}
+
+void MCTS_agent::set_decisive_moves(bool enabled) {
+    MCTS_node::set_decisive_moves(enabled);
+}
+
+bool MCTS_agent::get_decisive_moves() const {
+    return MCTS_node::get_decisive_moves();
+}
+
+void MCTS_agent::set_leaf_batch_size(int size) {
+    MCTS_node::set_leaf_batch_size(size);
+}
+
+int MCTS_agent::get_leaf_batch_size() const {
+    return MCTS_node::get_leaf_batch_size();
+}
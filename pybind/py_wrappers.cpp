@@ -1,182 +1,873 @@
-#include "py_wrappers.h"
-#include <iostream>
-#include <stdexcept>
-
-// SerializedPythonState implementation
-SerializedPythonState::SerializedPythonState(py::object python_state) 
-    : python_state(python_state) {
-    // Simple approach: just store the Python object directly
-    // C++ owns this object and will manage its lifetime
-}
-
-std::queue<MCTS_move*>* SerializedPythonState::actions_to_try() const {
-    try {
-        py::list py_moves = python_state.attr("actions_to_try")();
-        
-        // Clear previous cache and rebuild it
-        cached_python_moves.clear();
-        
-        std::queue<MCTS_move*>* queue = new std::queue<MCTS_move*>();
-        for (auto item : py_moves) {
-            // Create C++ wrapper for each Python move
-            PythonMoveWrapper* cpp_move = new PythonMoveWrapper(py::reinterpret_borrow<py::object>(item));
-            queue->push(cpp_move);
-            // Cache the Python object to keep it alive
-            cached_python_moves.push_back(py::reinterpret_borrow<py::object>(item));
-        }
-        return queue;
-    } catch (const std::exception& e) {
-        std::cerr << "Error in SerializedPythonState::actions_to_try: " << e.what() << std::endl;
-        return new std::queue<MCTS_move*>();
-    }
-}
-
-MCTS_state* SerializedPythonState::next_state(const MCTS_move* move) const {
-    try {
-        // Extract the Python move from the wrapper
-        const PythonMoveWrapper* wrapper = dynamic_cast<const PythonMoveWrapper*>(move);
-        py::object py_move;
-        
-        if (wrapper) {
-            py_move = wrapper->get_python_move();
-        } else {
-            // Fallback for non-wrapper moves (shouldn't happen in normal usage)
-            py_move = py::cast(move, py::return_value_policy::reference);
-        }
-        
-        py::object new_py_state = python_state.attr("next_state")(py_move);
-        return new SerializedPythonState(new_py_state);
-    } catch (const std::exception& e) {
-        std::cerr << "Error in SerializedPythonState::next_state: " << e.what() << std::endl;
-        return new SerializedPythonState(python_state);
-    }
-}
-
-double SerializedPythonState::rollout() const {
-    try {
-        return python_state.attr("rollout")().cast<double>();
-    } catch (const std::exception& e) {
-        std::cerr << "Error in SerializedPythonState::rollout: " << e.what() << std::endl;
-        return 0.5;
-    }
-}
-
-bool SerializedPythonState::is_terminal() const {
-    try {
-        return python_state.attr("is_terminal")().cast<bool>();
-    } catch (const std::exception& e) {
-        std::cerr << "Error in SerializedPythonState::is_terminal: " << e.what() << std::endl;
-        return true;
-    }
-}
-
-void SerializedPythonState::print() const {
-    try {
-        python_state.attr("print")();
-    } catch (const std::exception& e) {
-        std::cout << "SerializedPythonState (print error: " << e.what() << ")" << std::endl;
-    }
-}
-
-bool SerializedPythonState::is_self_side_turn() const {
-    try {
-        return python_state.attr("is_self_side_turn")().cast<bool>();
-    } catch (const std::exception& e) {
-        std::cerr << "Error in SerializedPythonState::is_self_side_turn: " << e.what() << std::endl;
-        return true;
-    }
-}
-
-MCTS_state* SerializedPythonState::clone() const {
-    try {
-        // Try to create a proper copy using the Python object's own state
-        // We'll use the object's current state to recreate it
-        
-        // For now, return a simple shallow copy since the Python objects
-        // in our demos don't modify their state in place during MCTS rollouts
-        // (they create new objects via next_state)
-        return new SerializedPythonState(python_state);
-    } catch (const std::exception& e) {
-        std::cerr << "Error in SerializedPythonState::clone: " << e.what() << std::endl;
-        // Fallback: return a copy with the same object
-        return new SerializedPythonState(python_state);
-    }
-}
-
-std::vector<double> SerializedPythonState::get_action_probabilities() const {
-    try {
-        if (py::hasattr(python_state, "get_action_probabilities")) {
-            py::list py_probs = python_state.attr("get_action_probabilities")();
-            std::vector<double> result;
-            for (auto item : py_probs) {
-                result.push_back(item.cast<double>());
-            }
-            return result;
-        }
-    } catch (const std::exception& e) {
-        std::cerr << "Error in SerializedPythonState::get_action_probabilities: " << e.what() << std::endl;
-    }
-    return std::vector<double>();
-}
-
-py::object SerializedPythonState::find_python_move(const MCTS_move* cpp_move) const {
-    // Search through cached Python moves to find the one that matches using value comparison
-    for (const auto& py_move : cached_python_moves) {
-        try {
-            MCTS_move* cached_cpp_move = py_move.cast<MCTS_move*>();
-            // Use the move's operator== for value comparison instead of pointer comparison
-            if (cached_cpp_move && cpp_move && *cached_cpp_move == *cpp_move) {
-                return py_move;
-            }
-        } catch (const std::exception& e) {
-            // Skip this move if casting fails
-            continue;
-        }
-    }
-    
-    // Fallback: try to convert the C++ pointer directly (risky but better than crashing)
-    std::cerr << "Warning: Could not find cached Python move, attempting direct conversion" << std::endl;
-    return py::cast(cpp_move, py::return_value_policy::reference);
-}
-
-std::vector<MCTS_move*> queue_to_vector(std::queue<MCTS_move*>* q) {
-    std::vector<MCTS_move*> result;
-    if (q == nullptr) {
-        return result;
-    }
-    
-    while (!q->empty()) {
-        result.push_back(q->front());
-        q->pop();
-    }
-    delete q;  // Clean up the queue
-    return result;
-}
-
-std::queue<MCTS_move*>* vector_to_queue(const std::vector<MCTS_move*>& vec) {
-    auto* q = new std::queue<MCTS_move*>();
-    for (MCTS_move* move : vec) {
-        q->push(move);
-    }
-    return q;
-}
-
-SafeMCTS_agent::SafeMCTS_agent(MCTS_state* starting_state, int max_iter, int max_seconds) {
-    agent = new MCTS_agent(starting_state, max_iter, max_seconds);
-}
-
-SafeMCTS_agent::~SafeMCTS_agent() {
-    delete agent;
-}
-
-const MCTS_move* SafeMCTS_agent::genmove(const MCTS_move* enemy_move) {
-    return agent->genmove(enemy_move);
-}
-
-const MCTS_state* SafeMCTS_agent::get_current_state() const {
-    return agent->get_current_state();
-}
-
-void SafeMCTS_agent::feedback() const {
-    agent->feedback();
-}
\ No newline at end of file
+#include "py_wrappers.h"
+#include <iostream>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+// SerializedPythonState implementation
+SerializedPythonState::SerializedPythonState(py::object python_state) 
+    : python_state(python_state), has_move_index(false) {
+    // Simple approach: just store the Python object directly
+    // C++ owns this object and will manage its lifetime
+}
+
+SerializedPythonState::~SerializedPythonState() {
+    py::gil_scoped_acquire gil;      // may be deleted by a search running without the GIL
+    cached_python_moves.clear();
+    cached_move_index.clear();
+    python_state = py::object();
+}
+
+std::queue<MCTS_move*>* SerializedPythonState::actions_to_try() const {
+    py::gil_scoped_acquire gil;
+    try {
+        py::list py_moves = python_state.attr("actions_to_try")();
+        
+        // Clear previous cache and rebuild it
+        cached_python_moves.clear();
+        cached_move_index.clear();
+        has_move_index = false;
+        
+        std::queue<MCTS_move*>* queue = new std::queue<MCTS_move*>();
+        for (auto item : py_moves) {
+            // Create C++ wrapper for each Python move
+            PythonMoveWrapper* cpp_move = new PythonMoveWrapper(py::reinterpret_borrow<py::object>(item));
+            queue->push(cpp_move);
+            // Cache the Python object to keep it alive
+            cached_python_moves.push_back(py::reinterpret_borrow<py::object>(item));
+        }
+        return queue;
+    } catch (const std::exception& e) {
+        std::cerr << "Error in SerializedPythonState::actions_to_try: " << e.what() << std::endl;
+        return new std::queue<MCTS_move*>();
+    }
+}
+
+MCTS_state* SerializedPythonState::next_state(const MCTS_move* move) const {
+    py::gil_scoped_acquire gil;
+    try {
+        // Extract the Python move from the wrapper
+        const PythonMoveWrapper* wrapper = dynamic_cast<const PythonMoveWrapper*>(move);
+        py::object py_move;
+        
+        if (wrapper) {
+            py_move = wrapper->get_python_move();
+        } else {
+            // Fallback for non-wrapper moves (shouldn't happen in normal usage)
+            py_move = py::cast(move, py::return_value_policy::reference);
+        }
+        
+        py::object new_py_state = python_state.attr("next_state")(py_move);
+        return new SerializedPythonState(new_py_state);
+    } catch (const std::exception& e) {
+        std::cerr << "Error in SerializedPythonState::next_state: " << e.what() << std::endl;
+        return new SerializedPythonState(python_state);
+    }
+}
+
+double SerializedPythonState::rollout() const {
+    py::gil_scoped_acquire gil;
+    try {
+        return python_state.attr("rollout")().cast<double>();
+    } catch (const std::exception& e) {
+        std::cerr << "Error in SerializedPythonState::rollout: " << e.what() << std::endl;
+        return 0.5;
+    }
+}
+
+/** Reads a 1-D buffer of numbers (any NumPy int, uint, float or bool dtype) into values, false if it isn't one */
+template <typename T>
+static bool read_buffer(const py::buffer_info& info, std::vector<T>& values) {
+    if (info.ndim != 1 || info.format.empty()) return false;
+    const char kind = info.format.back();        // skips byte order prefixes like '<' or '='
+    const char* data = static_cast<const char*>(info.ptr);
+    values.reserve(info.shape[0]);
+    for (py::ssize_t i = 0; i < info.shape[0]; i++) {
+        const char* p = data + i * info.strides[0];
+        switch (kind) {
+            case 'd': values.push_back((T) *reinterpret_cast<const double*>(p)); break;
+            case 'f': values.push_back((T) *reinterpret_cast<const float*>(p)); break;
+            case '?': values.push_back((T) *reinterpret_cast<const bool*>(p)); break;
+            case 'b': case 'h': case 'i': case 'l': case 'q':
+                switch (info.itemsize) {
+                    case 1: values.push_back((T) *reinterpret_cast<const int8_t*>(p)); break;
+                    case 2: values.push_back((T) *reinterpret_cast<const int16_t*>(p)); break;
+                    case 4: values.push_back((T) *reinterpret_cast<const int32_t*>(p)); break;
+                    case 8: values.push_back((T) *reinterpret_cast<const int64_t*>(p)); break;
+                    default: values.clear(); return false;
+                }
+                break;
+            case 'B': case 'H': case 'I': case 'L': case 'Q':
+                switch (info.itemsize) {
+                    case 1: values.push_back((T) *reinterpret_cast<const uint8_t*>(p)); break;
+                    case 2: values.push_back((T) *reinterpret_cast<const uint16_t*>(p)); break;
+                    case 4: values.push_back((T) *reinterpret_cast<const uint32_t*>(p)); break;
+                    case 8: values.push_back((T) *reinterpret_cast<const uint64_t*>(p)); break;
+                    default: values.clear(); return false;
+                }
+                break;
+            default:
+                values.clear();
+                return false;
+        }
+    }
+    return true;
+}
+
+/** Numbers returned by Python: read straight from the memory of 1-D buffers (e.g. NumPy arrays), anything else is
+ * iterated. The GIL must be held */
+template <typename T>
+static std::vector<T> python_numbers(const py::object& numbers) {
+    std::vector<T> values;
+    if (py::isinstance<py::buffer>(numbers) && read_buffer(numbers.cast<py::buffer>().request(), values)) {
+        return values;
+    }
+    for (auto item : numbers) {
+        values.push_back(item.cast<T>());
+    }
+    return values;
+}
+
+bool python_hash(py::handle obj, size_t &h) {
+    Py_hash_t value = PyObject_Hash(obj.ptr());
+    if (value == -1 && PyErr_Occurred()) {
+        PyErr_Clear();
+        return false;
+    }
+    h = (size_t) value;
+    return true;
+}
+
+bool PythonMoveWrapper::operator==(const MCTS_move& other) const {
+    py::gil_scoped_acquire gil;
+    try {
+        const PythonMoveWrapper* other_wrapper = dynamic_cast<const PythonMoveWrapper*>(&other);
+        py::object other_move = other_wrapper ? other_wrapper->python_move
+                                              : py::cast(&other, py::return_value_policy::reference);
+        // Use Python's __eq__ method for comparison
+        return python_move.equal(other_move);
+    } catch (const std::exception& e) {
+        return false;
+    }
+}
+
+bool PythonMoveWrapper::get_hash(size_t &h) const {
+    py::gil_scoped_acquire gil;      // also guards the cache against concurrent first calls
+    if (hash_known == 0) {
+        hash_known = python_hash(python_move, move_hash) ? 1 : -1;
+    }
+    h = move_hash;
+    return hash_known == 1;
+}
+
+std::string PythonMoveWrapper::sprint() const {
+    py::gil_scoped_acquire gil;      // also guards the cache against concurrent first calls
+    if (!has_move_string) {
+        try {
+            move_string = python_move.attr("sprint")().cast<std::string>();
+        } catch (const std::exception& e) {
+            move_string = "PythonMove";
+        }
+        has_move_string = true;
+    }
+    return move_string;
+}
+
+std::vector<double> PythonMoveWrapper::to_numpy() const {
+    py::gil_scoped_acquire gil;
+    try {
+        return python_numbers<double>(python_move.attr("to_numpy")());
+    } catch (const std::exception& e) {
+        // Fallback to empty vector if method fails
+        return std::vector<double>();
+    }
+}
+
+std::vector<int> PythonMoveWrapper::to_env_action() const {
+    py::gil_scoped_acquire gil;
+    try {
+        return python_numbers<int>(python_move.attr("to_env_action")());
+    } catch (const std::exception& e) {
+        // Fallback to empty vector if method fails
+        return std::vector<int>();
+    }
+}
+
+double SerializedPythonState::rollout_n(int count) const {
+    py::gil_scoped_acquire gil;
+    if (count <= 0 || !py::hasattr(python_state, "rollout_batch")) {
+        return MCTS_state::rollout_n(count);
+    }
+    try {
+        py::object results = python_state.attr("rollout_batch")(count);
+        if (py::isinstance<py::float_>(results) || py::isinstance<py::int_>(results)) {
+            return results.cast<double>();      // already summed up
+        }
+        std::vector<double> values = python_numbers<double>(results);
+        if ((int) values.size() != count) {
+            std::cerr << "Error in SerializedPythonState::rollout_n: rollout_batch(" << count << ") returned "
+                      << values.size() << " results" << std::endl;
+            return 0.5 * count;
+        }
+        double sum = 0.0;
+        for (double value : values) sum += value;
+        return sum;
+    } catch (const std::exception& e) {
+        std::cerr << "Error in SerializedPythonState::rollout_n: " << e.what() << std::endl;
+        return 0.5 * count;
+    }
+}
+
+std::vector<double> SerializedPythonState::rollout_many(const std::vector<const MCTS_state*>& states, int count) const {
+    py::gil_scoped_acquire gil;
+    if (count <= 0 || !py::hasattr(python_state, "rollout_many")) {
+        return MCTS_state::rollout_many(states, count);
+    }
+    // every state is passed count times in a row so that one call covers all the simulations
+    py::list batch;
+    for (const MCTS_state* state : states) {
+        const SerializedPythonState* wrapped = dynamic_cast<const SerializedPythonState*>(state);
+        if (wrapped == nullptr) {
+            return MCTS_state::rollout_many(states, count);
+        }
+        for (int i = 0; i < count; i++) {
+            batch.append(wrapped->python_state);
+        }
+    }
+    try {
+        std::vector<double> values = python_numbers<double>(python_state.attr("rollout_many")(batch));
+        if (values.size() != batch.size()) {
+            std::cerr << "Error in SerializedPythonState::rollout_many: returned " << values.size() << " results for "
+                      << batch.size() << " states" << std::endl;
+            return std::vector<double>();        // the engine falls back to one rollout_n() per state
+        }
+        std::vector<double> results(states.size(), 0.0);
+        for (size_t i = 0; i < values.size(); i++) {
+            results[i / count] += values[i];
+        }
+        return results;
+    } catch (const std::exception& e) {
+        std::cerr << "Error in SerializedPythonState::rollout_many: " << e.what() << std::endl;
+        return std::vector<double>();
+    }
+}
+
+bool SerializedPythonState::is_terminal() const {
+    py::gil_scoped_acquire gil;
+    try {
+        return python_state.attr("is_terminal")().cast<bool>();
+    } catch (const std::exception& e) {
+        std::cerr << "Error in SerializedPythonState::is_terminal: " << e.what() << std::endl;
+        return true;
+    }
+}
+
+void SerializedPythonState::print() const {
+    py::gil_scoped_acquire gil;
+    try {
+        python_state.attr("print")();
+    } catch (const std::exception& e) {
+        std::cout << "SerializedPythonState (print error: " << e.what() << ")" << std::endl;
+    }
+}
+
+bool SerializedPythonState::is_self_side_turn() const {
+    py::gil_scoped_acquire gil;
+    try {
+        return python_state.attr("is_self_side_turn")().cast<bool>();
+    } catch (const std::exception& e) {
+        std::cerr << "Error in SerializedPythonState::is_self_side_turn: " << e.what() << std::endl;
+        return true;
+    }
+}
+
+MCTS_state* SerializedPythonState::clone() const {
+    py::gil_scoped_acquire gil;
+    try {
+        // Try to create a proper copy using the Python object's own state
+        // We'll use the object's current state to recreate it
+        
+        // For now, return a simple shallow copy since the Python objects
+        // in our demos don't modify their state in place during MCTS rollouts
+        // (they create new objects via next_state)
+        return new SerializedPythonState(python_state);
+    } catch (const std::exception& e) {
+        std::cerr << "Error in SerializedPythonState::clone: " << e.what() << std::endl;
+        // Fallback: return a copy with the same object
+        return new SerializedPythonState(python_state);
+    }
+}
+
+std::vector<double> SerializedPythonState::get_action_probabilities() const {
+    py::gil_scoped_acquire gil;
+    try {
+        if (py::hasattr(python_state, "get_action_probabilities")) {
+            py::list py_probs = python_state.attr("get_action_probabilities")();
+            std::vector<double> result;
+            for (auto item : py_probs) {
+                result.push_back(item.cast<double>());
+            }
+            return result;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error in SerializedPythonState::get_action_probabilities: " << e.what() << std::endl;
+    }
+    return std::vector<double>();
+}
+
+bool SerializedPythonState::serialize(std::string& out) const {
+    py::gil_scoped_acquire gil;
+    try {
+        out += py::module_::import("pickle").attr("dumps")(python_state).cast<std::string>();
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Error in SerializedPythonState::serialize: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+MCTS_state* SerializedPythonState::deserialize(const char* data, size_t size) const {
+    py::gil_scoped_acquire gil;
+    try {
+        return new SerializedPythonState(py::module_::import("pickle").attr("loads")(py::bytes(data, size)));
+    } catch (const std::exception& e) {
+        std::cerr << "Error in SerializedPythonState::deserialize: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+static bool same_move(const py::object& py_move, const MCTS_move* cpp_move) {
+    try {
+        MCTS_move* cached_cpp_move = py_move.cast<MCTS_move*>();
+        // Use the move's operator== for value comparison instead of pointer comparison
+        return cached_cpp_move && cpp_move && *cached_cpp_move == *cpp_move;
+    } catch (const std::exception& e) {
+        // Skip this move if casting fails
+        return false;
+    }
+}
+
+py::object SerializedPythonState::find_python_move(const MCTS_move* cpp_move) const {
+    py::gil_scoped_acquire gil;
+    // Moves generated by this wrapper already carry their Python object
+    const PythonMoveWrapper* wrapper = dynamic_cast<const PythonMoveWrapper*>(cpp_move);
+    if (wrapper) {
+        return wrapper->get_python_move();
+    }
+    size_t h;
+    if (cpp_move && cpp_move->get_hash(h)) {
+        if (!has_move_index) {
+            for (size_t i = 0; i < cached_python_moves.size(); i++) {
+                size_t cached_hash;
+                if (python_hash(cached_python_moves[i], cached_hash)) cached_move_index.emplace(cached_hash, i);
+            }
+            has_move_index = true;
+        }
+        auto range = cached_move_index.equal_range(h);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (same_move(cached_python_moves[it->second], cpp_move)) {
+                return cached_python_moves[it->second];
+            }
+        }
+    }
+    // Search through cached Python moves to find the one that matches using value comparison
+    // (unhashable cached moves are not in the index)
+    for (const auto& py_move : cached_python_moves) {
+        if (same_move(py_move, cpp_move)) {
+            return py_move;
+        }
+    }
+    
+    // Fallback: try to convert the C++ pointer directly (risky but better than crashing)
+    std::cerr << "Warning: Could not find cached Python move, attempting direct conversion" << std::endl;
+    return py::cast(cpp_move, py::return_value_policy::reference);
+}
+
+// StateArena implementation
+StateArena::StateArena(size_t state_bytes, size_t slots_per_block)
+    : slot_size(std::max<size_t>((state_bytes + 15) / 16 * 16, 16)), slots_per_block(slots_per_block), slots_in_use(0) {}
+
+unsigned char* StateArena::allocate() {
+    std::lock_guard<std::mutex> guard(lock);
+    if (free_slots.empty()) {
+        blocks.emplace_back(new unsigned char[slot_size * slots_per_block]);
+        unsigned char* block = blocks.back().get();
+        for (size_t i = slots_per_block; i > 0; i--) {
+            free_slots.push_back(block + (i - 1) * slot_size);     // handed out in address order
+        }
+    }
+    unsigned char* slot = free_slots.back();
+    free_slots.pop_back();
+    slots_in_use++;
+    return slot;
+}
+
+void StateArena::release(unsigned char* slot) {
+    if (slot == nullptr) return;
+    std::lock_guard<std::mutex> guard(lock);
+    free_slots.push_back(slot);
+    slots_in_use--;
+}
+
+size_t StateArena::get_slots_in_use() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return slots_in_use;
+}
+
+// ArrayPythonGame implementation
+static py::object game_method(const py::object& game, const char* name, bool required) {
+    if (py::hasattr(game, name)) return game.attr(name);
+    if (required) throw std::invalid_argument(std::string("ArrayPythonState: the game has no ") + name + "()");
+    return py::object();
+}
+
+static py::object state_dtype(const py::object& game) {
+    if (py::hasattr(game, "state_dtype")) return py::dtype::from_args(game.attr("state_dtype"));
+    return py::dtype::of<double>();
+}
+
+ArrayPythonGame::ArrayPythonGame(py::object game)
+    : actions(game_method(game, "actions", true)),
+      next_state(game_method(game, "next_state", true)),
+      is_terminal(game_method(game, "is_terminal", true)),
+      is_self_side_turn(game_method(game, "is_self_side_turn", true)),
+      rollout(game_method(game, "rollout", true)),
+      rollout_many(game_method(game, "rollout_many", false)),
+      print(game_method(game, "print", false)),
+      dtype(state_dtype(game)),
+      format(dtype.attr("char").cast<std::string>()),
+      state_size(game.attr("state_size").cast<size_t>()),
+      state_bytes(state_size * dtype.attr("itemsize").cast<size_t>()),
+      action_space_size(py::hasattr(game, "action_space_size") ? game.attr("action_space_size").cast<int>() : 0),
+      view_base(py::capsule(this)),
+      arena(state_bytes) {
+    if (state_size == 0) throw std::invalid_argument("ArrayPythonState: the game's state_size must be positive");
+}
+
+ArrayPythonGame::~ArrayPythonGame() {
+    py::gil_scoped_acquire gil;      // the last state may be deleted by a search running without the GIL
+    actions = next_state = is_terminal = is_self_side_turn = py::object();
+    rollout = rollout_many = print = py::object();
+    dtype = view_base = py::object();
+}
+
+py::array ArrayPythonGame::view(const unsigned char* state) const {
+    return py::array(py::reinterpret_borrow<py::dtype>(dtype), {(py::ssize_t) state_size}, state, view_base);
+}
+
+// ArrayPythonState implementation
+ArrayPythonState::ArrayPythonState(std::shared_ptr<ArrayPythonGame> game, const unsigned char* source)
+    : game(game), data(game->arena.allocate()), terminal(false), self_side(true) {
+    memcpy(data, source, game->state_bytes);
+}
+
+ArrayPythonState::ArrayPythonState(py::object python_game, py::object state)
+    : game(std::make_shared<ArrayPythonGame>(python_game)), data(nullptr), terminal(false), self_side(true) {
+    py::array converted = py::module_::import("numpy").attr("ascontiguousarray")(state, game->dtype).cast<py::array>();
+    if ((size_t) converted.size() != game->state_size) {
+        throw std::invalid_argument("ArrayPythonState: the state has " + std::to_string(converted.size())
+                                    + " elements instead of the game's state_size " + std::to_string(game->state_size));
+    }
+    data = game->arena.allocate();
+    memcpy(data, converted.data(), game->state_bytes);
+    try {
+        query_flags();
+    } catch (...) {
+        game->arena.release(data);
+        throw;
+    }
+}
+
+ArrayPythonState::~ArrayPythonState() {
+    game->arena.release(data);
+}
+
+void ArrayPythonState::query_flags() {
+    py::array state = game->view(data);
+    terminal = game->is_terminal(state).cast<bool>();
+    self_side = game->is_self_side_turn(state).cast<bool>();
+}
+
+std::queue<MCTS_move*>* ArrayPythonState::actions_to_try() const {
+    std::queue<MCTS_move*>* queue = new std::queue<MCTS_move*>();
+    py::gil_scoped_acquire gil;
+    try {
+        for (int action : python_numbers<int>(game->actions(game->view(data)))) {
+            queue->push(new ArrayPythonMove(action));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error in ArrayPythonState::actions_to_try: " << e.what() << std::endl;
+    }
+    return queue;
+}
+
+MCTS_state* ArrayPythonState::next_state(const MCTS_move* move) const {
+    ArrayPythonState* next = new ArrayPythonState(game, data);    // out starts as a copy of this state
+    const ArrayPythonMove* array_move = dynamic_cast<const ArrayPythonMove*>(move);
+    py::gil_scoped_acquire gil;
+    try {
+        if (array_move == nullptr) throw std::invalid_argument("not an ArrayPythonMove");
+        game->next_state(game->view(data), array_move->action, game->view(next->data));
+        next->query_flags();
+    } catch (const std::exception& e) {
+        std::cerr << "Error in ArrayPythonState::next_state: " << e.what() << std::endl;
+        memcpy(next->data, data, game->state_bytes);
+        next->terminal = terminal;
+        next->self_side = self_side;
+    }
+    return next;
+}
+
+double ArrayPythonState::rollout() const {
+    py::gil_scoped_acquire gil;
+    try {
+        return game->rollout(game->view(data)).cast<double>();
+    } catch (const std::exception& e) {
+        std::cerr << "Error in ArrayPythonState::rollout: " << e.what() << std::endl;
+        return 0.5;
+    }
+}
+
+double ArrayPythonState::rollout_n(int count) const {
+    if (count > 1 && game->rollout_many) {
+        std::vector<double> sums = rollout_many(std::vector<const MCTS_state*>(1, this), count);
+        if (sums.size() == 1) return sums[0];
+    }
+    return MCTS_state::rollout_n(count);
+}
+
+std::vector<double> ArrayPythonState::rollout_many(const std::vector<const MCTS_state*>& states, int count) const {
+    if (count <= 0 || !game->rollout_many) {
+        return MCTS_state::rollout_many(states, count);
+    }
+    std::vector<const ArrayPythonState*> array_states;
+    for (const MCTS_state* state : states) {
+        const ArrayPythonState* array_state = dynamic_cast<const ArrayPythonState*>(state);
+        if (array_state == nullptr || array_state->game != game) {
+            return MCTS_state::rollout_many(states, count);
+        }
+        array_states.push_back(array_state);
+    }
+    py::gil_scoped_acquire gil;
+    try {
+        // one row per simulation, every state count times in a row
+        const size_t rows = states.size() * count;
+        py::array batch(py::reinterpret_borrow<py::dtype>(game->dtype), {(py::ssize_t) rows, (py::ssize_t) game->state_size});
+        unsigned char* out = static_cast<unsigned char*>(batch.mutable_data());
+        for (const ArrayPythonState* array_state : array_states) {
+            for (int i = 0; i < count; i++, out += game->state_bytes) {
+                memcpy(out, array_state->data, game->state_bytes);
+            }
+        }
+        std::vector<double> values = python_numbers<double>(game->rollout_many(batch));
+        if (values.size() != rows) {
+            std::cerr << "Error in ArrayPythonState::rollout_many: returned " << values.size() << " results for "
+                      << rows << " states" << std::endl;
+            return std::vector<double>();        // the engine falls back to one rollout_n() per state
+        }
+        std::vector<double> results(states.size(), 0.0);
+        for (size_t i = 0; i < values.size(); i++) {
+            results[i / count] += values[i];
+        }
+        return results;
+    } catch (const std::exception& e) {
+        std::cerr << "Error in ArrayPythonState::rollout_many: " << e.what() << std::endl;
+        return std::vector<double>();
+    }
+}
+
+void ArrayPythonState::print() const {
+    py::gil_scoped_acquire gil;
+    try {
+        if (game->print) {
+            game->print(game->view(data));
+        } else {
+            py::print(game->view(data));
+        }
+    } catch (const std::exception& e) {
+        std::cout << "ArrayPythonState (print error: " << e.what() << ")" << std::endl;
+    }
+}
+
+MCTS_state* ArrayPythonState::clone() const {
+    ArrayPythonState* copy = new ArrayPythonState(game, data);
+    copy->terminal = terminal;
+    copy->self_side = self_side;
+    return copy;
+}
+
+std::vector<double> ArrayPythonState::to_numpy() const {
+    // read straight from the arena: no GIL needed
+    std::vector<double> values;
+    read_buffer(py::buffer_info(data, (py::ssize_t) (game->state_bytes / game->state_size), game->format,
+                                (py::ssize_t) game->state_size), values);
+    return values;
+}
+
+int ArrayPythonState::action_index(const MCTS_move* move) const {
+    const ArrayPythonMove* array_move = dynamic_cast<const ArrayPythonMove*>(move);
+    return (array_move != nullptr) ? array_move->action : -1;
+}
+
+bool ArrayPythonState::serialize(std::string& out) const {
+    out.append(reinterpret_cast<const char*>(data), game->state_bytes);
+    return true;
+}
+
+MCTS_state* ArrayPythonState::deserialize(const char* bytes, size_t size) const {
+    if (size != game->state_bytes) return nullptr;
+    ArrayPythonState* state = new ArrayPythonState(game, reinterpret_cast<const unsigned char*>(bytes));
+    py::gil_scoped_acquire gil;
+    try {
+        state->query_flags();
+        return state;
+    } catch (const std::exception& e) {
+        std::cerr << "Error in ArrayPythonState::deserialize: " << e.what() << std::endl;
+        delete state;
+        return nullptr;
+    }
+}
+
+py::array ArrayPythonState::get_array() const {
+    return py::array(py::reinterpret_borrow<py::dtype>(game->dtype), {(py::ssize_t) game->state_size}, data);   // copies
+}
+
+bool PythonEvaluator::evaluate(const std::vector<const MCTS_state*>& states, std::vector<std::vector<double>>& priors,
+                               std::vector<double>& values) {
+    std::vector<std::vector<double>> encodings;
+    if (numpy_encoding) {
+        // native states encode themselves without the GIL
+        for (const MCTS_state* state : states) {
+            encodings.push_back(state->to_numpy());
+            if (encodings.back().empty() || encodings.back().size() != encodings[0].size()) {
+                std::cerr << "Error in PythonEvaluator::evaluate: the states' to_numpy() encodings are empty or differ "
+                          << "in length (use encoding=\"states\")" << std::endl;
+                return false;
+            }
+        }
+    }
+    py::gil_scoped_acquire gil;
+    try {
+        py::object batch;
+        if (numpy_encoding) {
+            const size_t width = encodings[0].size();
+            py::array_t<double> array({(py::ssize_t) states.size(), (py::ssize_t) width});
+            double* out = array.mutable_data();
+            for (const std::vector<double>& encoding : encodings) {
+                std::copy(encoding.begin(), encoding.end(), out);
+                out += width;
+            }
+            batch = array;
+        } else {
+            py::list list;
+            for (const MCTS_state* state : states) {
+                const SerializedPythonState* wrapped = dynamic_cast<const SerializedPythonState*>(state);
+                const ArrayPythonState* array_state = dynamic_cast<const ArrayPythonState*>(state);
+                if (wrapped != nullptr) {
+                    list.append(wrapped->get_python_state());
+                } else if (array_state != nullptr) {
+                    list.append(array_state->get_array());
+                } else {
+                    list.append(py::cast(state, py::return_value_policy::reference));
+                }
+            }
+            batch = list;
+        }
+        py::sequence result = function(batch).cast<py::sequence>();
+        if (result.size() != 2) {
+            std::cerr << "Error in PythonEvaluator::evaluate: expected (priors, values), got " << result.size()
+                      << " items" << std::endl;
+            return false;
+        }
+        values = python_numbers<double>(result[1]);
+        if (result[0].is_none()) {
+            priors.assign(states.size(), std::vector<double>());
+        } else {
+            priors.clear();
+            for (auto row : result[0]) {
+                priors.push_back(python_numbers<double>(py::reinterpret_borrow<py::object>(row)));
+            }
+        }
+        return true;                     // the engine checks that there is one row and one value per state
+    } catch (const std::exception& e) {
+        std::cerr << "Error in PythonEvaluator::evaluate: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+std::vector<MCTS_move*> queue_to_vector(std::queue<MCTS_move*>* q) {
+    std::vector<MCTS_move*> result;
+    if (q == nullptr) {
+        return result;
+    }
+    
+    while (!q->empty()) {
+        result.push_back(q->front());
+        q->pop();
+    }
+    delete q;  // Clean up the queue
+    return result;
+}
+
+std::queue<MCTS_move*>* vector_to_queue(const std::vector<MCTS_move*>& vec) {
+    auto* q = new std::queue<MCTS_move*>();
+    for (MCTS_move* move : vec) {
+        q->push(move);
+    }
+    return q;
+}
+
+SafeMCTS_agent::SafeMCTS_agent(MCTS_state* starting_state, int max_iter, int max_seconds) : searching(false) {
+    agent = new MCTS_agent(starting_state, max_iter, max_seconds, StateOwnership::COPY);
+}
+
+SafeMCTS_agent::~SafeMCTS_agent() {
+    if (search_thread.joinable()) {
+        stop();
+        py::gil_scoped_release release;  // the worker takes the GIL to resolve its future
+        search_thread.join();
+    }
+    delete agent;
+}
+
+std::unique_lock<std::mutex> SafeMCTS_agent::lock_idle(const char* what) const {
+    std::unique_lock<std::mutex> guard(lock, std::try_to_lock);
+    if (searching || !guard.owns_lock()) {
+        throw std::runtime_error(std::string(what) + ": a search of this agent is still running");
+    }
+    return guard;
+}
+
+const MCTS_move* SafeMCTS_agent::genmove(const MCTS_move* enemy_move) {
+    bool idle = false;
+    if (!searching.compare_exchange_strong(idle, true)) {
+        throw std::runtime_error("genmove: a search of this agent is still running");
+    }
+    const MCTS_move* move;
+    try {
+        std::lock_guard<std::mutex> guard(lock);      // waits for a short call of another thread, if any
+        move = agent->genmove(enemy_move);
+    } catch (...) {
+        searching = false;
+        throw;
+    }
+    searching = false;
+    return move;
+}
+
+void SafeMCTS_agent::stop() {
+    std::shared_ptr<std::atomic<bool>> flag = stop_search;
+    if (flag) *flag = true;
+}
+
+py::object SafeMCTS_agent::genmove_async(py::object enemy_move) {
+    bool idle = false;
+    if (!searching.compare_exchange_strong(idle, true)) {
+        throw std::runtime_error("genmove_async: a search of this agent is still running");
+    }
+    try {
+        return start_search(enemy_move);
+    } catch (...) {
+        searching = false;
+        throw;
+    }
+}
+
+py::object SafeMCTS_agent::start_search(py::object enemy_move) {
+    if (search_thread.joinable()) {
+        py::gil_scoped_release release;
+        search_thread.join();            // already done with the previous future, just not joined yet
+    }
+    const MCTS_move* enemy = enemy_move.is_none() ? nullptr : enemy_move.cast<const MCTS_move*>();
+
+    py::object loop = py::none();
+    try {
+        loop = py::module_::import("asyncio").attr("get_running_loop")();
+    } catch (py::error_already_set& e) {
+        // not called from a coroutine
+    }
+    py::object future = loop.is_none() ? py::module_::import("concurrent.futures").attr("Future")()
+                                       : loop.attr("create_future")();
+    std::shared_ptr<std::atomic<bool>> flag = std::make_shared<std::atomic<bool>>(false);
+    future.attr("add_done_callback")(py::cpp_function([flag](py::object done) {
+        if (done.attr("cancelled")().cast<bool>()) *flag = true;
+    }));
+
+    stop_search = flag;
+    // The worker keeps the enemy move, the future and the loop alive and drops them while holding the GIL
+    search_thread = std::thread([this, enemy, flag, enemy_move, future, loop]() mutable {
+        const MCTS_move* move = nullptr;
+        std::string error;
+        try {
+            std::lock_guard<std::mutex> guard(lock);
+            move = agent->genmove(enemy, flag.get());
+        } catch (const std::exception& e) {
+            error = e.what();
+        }
+        py::gil_scoped_acquire gil;
+        try {
+            py::object result = py::cast(move, py::return_value_policy::reference);
+            py::object exception = error.empty() ? py::none()
+                                                 : py::module_::import("builtins").attr("RuntimeError")(error);
+            searching = false;           // before resolving: whoever waits for the move may use the agent right away
+            py::cpp_function resolve([future, result, exception]() {
+                if (future.attr("done")().cast<bool>()) return;        // cancelled meanwhile
+                if (exception.is_none()) future.attr("set_result")(result);
+                else future.attr("set_exception")(exception);
+            });
+            if (loop.is_none()) resolve();
+            else loop.attr("call_soon_threadsafe")(resolve);
+        } catch (const std::exception& e) {
+            std::cerr << "Error in SafeMCTS_agent::genmove_async: " << e.what() << std::endl;
+        }
+        searching = false;
+        enemy_move = py::object();
+        future = py::object();
+        loop = py::object();
+    });
+    return future;
+}
+
+const MCTS_state* SafeMCTS_agent::get_current_state() const {
+    std::unique_lock<std::mutex> guard = lock_idle("get_current_state");
+    return agent->get_current_state();
+}
+
+void SafeMCTS_agent::feedback() const {
+    std::unique_lock<std::mutex> guard = lock_idle("feedback");
+    agent->feedback();
+}
+
+MCTS_root_stats SafeMCTS_agent::get_last_search_stats() const {
+    std::unique_lock<std::mutex> guard = lock_idle("last_search_stats");
+    return agent->get_last_search_stats();
+}
+
+void SafeMCTS_agent::save_tree(const std::string& path, bool with_states) const {
+    std::unique_lock<std::mutex> guard = lock_idle("save_tree");
+    std::string error;
+    bool saved;
+    {
+        py::gil_scoped_release release;  // Python states and moves take it back when asked
+        saved = agent->save_tree(path, with_states, error);
+    }
+    if (!saved) throw std::runtime_error(error);
+}
+
+void SafeMCTS_agent::load_tree(const std::string& path) {
+    std::unique_lock<std::mutex> guard = lock_idle("load_tree");
+    std::string error;
+    bool loaded;
+    {
+        py::gil_scoped_release release;
+        loaded = agent->load_tree(path, error);
+    }
+    if (!loaded) throw std::runtime_error(error);
+}
+
+void SafeMCTS_agent::set_opening_book(std::shared_ptr<const OpeningBook> book, unsigned int seed_visits,
+                                      unsigned int play_visits) {
+    std::unique_lock<std::mutex> guard = lock_idle("set_opening_book");
+    agent->set_opening_book(book, seed_visits, play_visits);
+}
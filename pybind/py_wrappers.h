@@ -1,280 +1,437 @@
-#ifndef PY_WRAPPERS_H
-#define PY_WRAPPERS_H
-
-#include <pybind11/pybind11.h>
-#include <pybind11/stl.h>
-#include <pybind11/functional.h>
-#include "../mcts/include/state.h"
-#include "mcts_python.h"  // Use Python-specific header that conditionally includes JobScheduler
-
-#include <vector>
-#include <memory>
-#include <queue>
-
-// Forward declaration of RolloutStrategy
-enum class RolloutStrategy {
-    RANDOM,           // Pure random rollouts (default)
-    HEURISTIC,        // Use heuristic_rollout() method
-    MIXED,            // Mix of random and heuristic (configurable ratio)
-    HEAVY             // Deeper heuristic evaluation
-};
-
-namespace py = pybind11;
-
-/**
- * Internal C++ move wrapper that stores Python move data
- * This allows C++ MCTS to work with moves without exposing Python objects
- */
-class PythonMoveWrapper : public MCTS_move {
-private:
-    py::object python_move;  // Keep the Python move alive
-    std::string move_string; // Cached string representation
-    
-public:
-    PythonMoveWrapper(py::object py_move) : python_move(py_move) {
-        try {
-            move_string = py_move.attr("sprint")().cast<std::string>();
-        } catch (const std::exception& e) {
-            move_string = "PythonMove";
-        }
-    }
-    
-    bool operator==(const MCTS_move& other) const override {
-        const PythonMoveWrapper* other_wrapper = dynamic_cast<const PythonMoveWrapper*>(&other);
-        if (other_wrapper) {
-            try {
-                // Use Python's __eq__ method for comparison
-                return python_move.attr("__eq__")(other_wrapper->python_move).cast<bool>();
-            } catch (const std::exception& e) {
-                return false;
-            }
-        }
-        return false;
-    }
-    
-    std::string sprint() const override {
-        return move_string;
-    }
-    
-    std::vector<double> to_numpy() const override {
-        try {
-            // Call Python move's to_numpy() method
-            py::list py_result = python_move.attr("to_numpy")();
-            std::vector<double> result;
-            for (auto item : py_result) {
-                result.push_back(item.cast<double>());
-            }
-            return result;
-        } catch (const std::exception& e) {
-            // Fallback to empty vector if method fails
-            return std::vector<double>();
-        }
-    }
-    
-    std::vector<int> to_env_action() const override {
-        try {
-            // Call Python move's to_env_action() method
-            py::list py_result = python_move.attr("to_env_action")();
-            std::vector<int> result;
-            for (auto item : py_result) {
-                result.push_back(item.cast<int>());
-            }
-            return result;
-        } catch (const std::exception& e) {
-            // Fallback to empty vector if method fails
-            return std::vector<int>();
-        }
-    }
-    
-    py::object get_python_move() const {
-        return python_move;
-    }
-};
-
-/**
- * C++ state class that holds a Python game state object
- * This enables full C++ ownership while preserving Python game logic
- */
-class SerializedPythonState : public MCTS_state {
-private:
-    py::object python_state;  // Store the Python state object
-    mutable std::vector<py::object> cached_python_moves; // Keep Python moves alive
-    
-public:
-    SerializedPythonState(py::object python_state);
-    ~SerializedPythonState() override = default;
-    
-    // MCTS_state interface
-    std::queue<MCTS_move*>* actions_to_try() const override;
-    MCTS_state* next_state(const MCTS_move* move) const override;
-    double rollout() const override;
-    bool is_terminal() const override;
-    void print() const override;
-    bool is_self_side_turn() const override;
-    MCTS_state* clone() const override;
-    std::vector<double> get_action_probabilities() const override;
-    
-    // Helper to find original Python move from C++ pointer
-    py::object find_python_move(const MCTS_move* cpp_move) const;
-};
-
-namespace py = pybind11;
-
-/**
- * Trampoline class for MCTS_move to enable Python inheritance
- * Uses py::trampoline_self_life_support for safe lifetime management
- */
-class PyMCTS_move : public MCTS_move, public py::trampoline_self_life_support {
-public:
-    using MCTS_move::MCTS_move;
-
-    bool operator==(const MCTS_move& other) const override {
-        PYBIND11_OVERRIDE_PURE(
-            bool,           /* Return type */
-            MCTS_move,      /* Parent class */
-            operator==,     /* Name of function in C++ (must match Python name) */
-            other           /* Arguments */
-        );
-    }
-
-    std::string sprint() const override {
-        PYBIND11_OVERRIDE_PURE(
-            std::string,    /* Return type */
-            MCTS_move,      /* Parent class */
-            sprint,         /* Name of function in C++ (must match Python name) */
-                            /* No arguments for this function */
-        );
-    }
-
-    std::vector<double> to_numpy() const override {
-        PYBIND11_OVERRIDE_PURE(
-            std::vector<double>, /* Return type */
-            MCTS_move,           /* Parent class */
-            to_numpy,            /* Name of function in C++ (must match Python name) */
-                                 /* No arguments for this function */
-        );
-    }
-
-    std::vector<int> to_env_action() const override {
-        PYBIND11_OVERRIDE_PURE(
-            std::vector<int>,    /* Return type */
-            MCTS_move,           /* Parent class */
-            to_env_action,       /* Name of function in C++ (must match Python name) */
-                                 /* No arguments for this function */
-        );
-    }
-};
-
-/**
- * Trampoline class for MCTS_state to enable Python inheritance
- * Uses py::trampoline_self_life_support for safe lifetime management
- */
-class PyMCTS_state : public MCTS_state, public py::trampoline_self_life_support {
-public:
-    using MCTS_state::MCTS_state;
-
-    ~PyMCTS_state() override = default;
-
-    std::queue<MCTS_move*>* actions_to_try() const override {
-        PYBIND11_OVERRIDE_PURE(
-            std::queue<MCTS_move*>*,  /* Return type */
-            MCTS_state,               /* Parent class */
-            actions_to_try,           /* Name of function in C++ (must match Python name) */
-                                      /* No arguments */
-        );
-    }
-
-    MCTS_state* next_state(const MCTS_move* move) const override {
-        PYBIND11_OVERRIDE_PURE(
-            MCTS_state*,              /* Return type */
-            MCTS_state,               /* Parent class */
-            next_state,               /* Name of function in C++ (must match Python name) */
-            move                      /* Arguments */
-        );
-    }
-    
-    double rollout() const override {
-        PYBIND11_OVERRIDE_PURE(
-            double,                   /* Return type */
-            MCTS_state,               /* Parent class */
-            rollout,                  /* Name of function in C++ (must match Python name) */
-                                      /* No arguments */
-        );
-    }
-
-    bool is_terminal() const override {
-        PYBIND11_OVERRIDE_PURE(
-            bool,                     /* Return type */
-            MCTS_state,               /* Parent class */
-            is_terminal,              /* Name of function in C++ (must match Python name) */
-                                      /* No arguments */
-        );
-    }
-
-    void print() const override {
-        PYBIND11_OVERRIDE_PURE(
-            void,                     /* Return type */
-            MCTS_state,               /* Parent class */
-            print,                    /* Name of function in C++ (must match Python name) */
-                                      /* No arguments */
-        );
-    }
-
-    bool is_self_side_turn() const override {
-        PYBIND11_OVERRIDE_PURE(
-            bool,                     /* Return type */
-            MCTS_state,               /* Parent class */
-            is_self_side_turn,        /* Name of function in C++ (must match Python name) */
-                                      /* No arguments */
-        );
-    }
-
-    MCTS_state* clone() const override {
-        PYBIND11_OVERRIDE_PURE(
-            MCTS_state*,              /* Return type */
-            MCTS_state,               /* Parent class */
-            clone,                    /* Name of function in C++ (must match Python name) */
-                                      /* No arguments */
-        );
-    }
-
-    std::vector<double> get_action_probabilities() const override {
-        PYBIND11_OVERRIDE(
-            std::vector<double>,      /* Return type */
-            MCTS_state,               /* Parent class */
-            get_action_probabilities, /* Name of function in C++ */
-                                      /* No arguments */
-        );
-    }
-};
-
-/**
- * Helper function to convert queue<MCTS_move*>* to vector for Python
- * This takes ownership of the queue and all moves in it
- */
-std::vector<MCTS_move*> queue_to_vector(std::queue<MCTS_move*>* q);
-
-/**
- * Helper function to convert vector to queue<MCTS_move*>*
- * This creates new queue and transfers ownership of moves
- */
-std::queue<MCTS_move*>* vector_to_queue(const std::vector<MCTS_move*>& vec);
-
-/**
- * Safe wrapper for MCTS_agent that handles move ownership
- */
-class SafeMCTS_agent {
-private:
-    MCTS_agent* agent;
-    
-public:
-    SafeMCTS_agent(MCTS_state* starting_state, int max_iter = 100000, int max_seconds = 30);
-    ~SafeMCTS_agent();
-    
-    // Returns nullptr if no move available (game ended)
-    const MCTS_move* genmove(const MCTS_move* enemy_move = nullptr);
-    const MCTS_state* get_current_state() const;
-    void feedback() const;
-};
-
+#ifndef PY_WRAPPERS_H
+#define PY_WRAPPERS_H
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/functional.h>
+#include <pybind11/numpy.h>
+#include "../mcts/include/state.h"
+#include "../mcts/include/mcts.h"
+
+#include <vector>
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <thread>
+#include <atomic>
+#include <mutex>
+
+namespace py = pybind11;
+
+// Python hash() of obj, false if it is unhashable (e.g. defines __eq__ without __hash__). The GIL must be held
+bool python_hash(py::handle obj, size_t &h);
+
+/**
+ * Internal C++ move wrapper that stores Python move data
+ * This allows C++ MCTS to work with moves without exposing Python objects
+ * Searches run without the GIL (see pymcts.cpp) so every method that touches the Python move takes it first
+ * sprint() is only needed for printing so the Python sprint() is called on first use, not for every generated move
+ * Likewise the Python __hash__ is called once per move, the first time the tree looks for it among its children
+ */
+class PythonMoveWrapper : public MCTS_move {
+private:
+    py::object python_move;  // Keep the Python move alive
+    mutable std::string move_string; // Cached string representation (valid once has_move_string is set)
+    mutable bool has_move_string;
+    mutable size_t move_hash;
+    mutable signed char hash_known;  // 0: not asked yet, 1: move_hash is valid, -1: unhashable
+    
+public:
+    PythonMoveWrapper(py::object py_move) : python_move(py_move), has_move_string(false), move_hash(0), hash_known(0) {}
+
+    ~PythonMoveWrapper() override {
+        py::gil_scoped_acquire gil;      // may be deleted by a search running without the GIL
+        python_move = py::object();
+    }
+    
+    // Compares with Python's __eq__, also against moves defined in Python (e.g. the enemy move given to genmove)
+    bool operator==(const MCTS_move& other) const override;
+    bool get_hash(size_t &h) const override;
+    std::string sprint() const override;
+    // The Python methods may return lists, tuples or anything exposing a 1-D buffer (e.g. NumPy arrays)
+    std::vector<double> to_numpy() const override;
+    std::vector<int> to_env_action() const override;
+    
+    py::object get_python_move() const {
+        return python_move;
+    }
+};
+
+/**
+ * C++ state class that holds a Python game state object
+ * This enables full C++ ownership while preserving Python game logic
+ * Like PythonMoveWrapper, it holds the GIL only while calling into (or releasing) the Python object
+ */
+class SerializedPythonState : public MCTS_state {
+private:
+    py::object python_state;  // Store the Python state object
+    mutable std::vector<py::object> cached_python_moves; // Keep Python moves alive
+    mutable std::unordered_multimap<size_t, size_t> cached_move_index; // hash -> position in cached_python_moves
+    mutable bool has_move_index;     // the index is built on the first lookup after actions_to_try()
+    
+public:
+    SerializedPythonState(py::object python_state);
+    ~SerializedPythonState() override;
+    
+    // MCTS_state interface
+    std::queue<MCTS_move*>* actions_to_try() const override;
+    MCTS_state* next_state(const MCTS_move* move) const override;
+    double rollout() const override;
+    // Optional batch protocol of the Python state: rollout_batch(n) returns the n results (or their sum) and
+    // rollout_many(states) one result per state. Both may return NumPy arrays. Without them rollout() is called per game
+    double rollout_n(int count) const override;
+    std::vector<double> rollout_many(const std::vector<const MCTS_state*>& states, int count) const override;
+    bool is_terminal() const override;
+    void print() const override;
+    bool is_self_side_turn() const override;
+    MCTS_state* clone() const override;
+    std::vector<double> get_action_probabilities() const override;
+    // Saved trees with states: the Python state is pickled
+    bool serialize(std::string& out) const override;
+    MCTS_state* deserialize(const char* data, size_t size) const override;
+    
+    // Helper to find original Python move from C++ pointer (a hash table hit for hashable moves)
+    py::object find_python_move(const MCTS_move* cpp_move) const;
+
+    py::object get_python_state() const {
+        return python_state;
+    }
+};
+
+/**
+ * Fixed-size state buffers of one array-backed game, carved out of large blocks
+ * Buffers of deleted states go on a free list and are reused by the next ones instead of going back to the heap
+ */
+class StateArena {
+private:
+    const size_t slot_size;          // bytes per state, rounded up so that every slot stays aligned
+    const size_t slots_per_block;
+    std::vector<std::unique_ptr<unsigned char[]>> blocks;
+    std::vector<unsigned char*> free_slots;
+    size_t slots_in_use;
+    mutable std::mutex lock;         // trees searched by different Python threads may share a game
+
+public:
+    StateArena(size_t state_bytes, size_t slots_per_block = 1024);
+    unsigned char* allocate();
+    void release(unsigned char* slot);
+    size_t get_slots_in_use() const;
+};
+
+/**
+ * The Python game object of ArrayPythonState. It describes states as 1-D NumPy arrays and holds no state itself:
+ *   state_size                        number of elements of a state (of state_dtype, float64 if absent)
+ *   actions(state)                    legal action ids (any sequence or 1-D array of ints)
+ *   next_state(state, action, out)    writes the successor into out, which starts as a copy of state
+ *   is_terminal(state), is_self_side_turn(state), rollout(state)
+ * and optionally rollout_many(states) (a 2-D array, one result per row), action_space_size and print(state).
+ * The methods are looked up once. The arrays passed to them are views of arena memory, only valid during the call
+ */
+struct ArrayPythonGame {
+    py::object actions, next_state, is_terminal, is_self_side_turn, rollout, rollout_many, print;   // null if absent
+    py::object dtype;
+    std::string format;              // buffer format of dtype, to read states without the GIL
+    size_t state_size;
+    size_t state_bytes;
+    int action_space_size;
+    py::object view_base;            // base object of the views, so NumPy neither copies nor frees arena memory
+    StateArena arena;
+
+    ArrayPythonGame(py::object game);
+    ~ArrayPythonGame();
+    // Array over the state's buffer (no copy). The GIL must be held
+    py::array view(const unsigned char* state) const;
+};
+
+/** Move of an ArrayPythonState: just the action id passed to the game */
+struct ArrayPythonMove : public MCTS_move {
+    int action;
+
+    ArrayPythonMove(int action) : action(action) {}
+    bool operator==(const MCTS_move& other) const override {
+        const ArrayPythonMove* o = dynamic_cast<const ArrayPythonMove*>(&other);
+        return o != nullptr && o->action == action;
+    }
+    bool get_hash(size_t &h) const override { h = (size_t) action; return true; }
+    std::string sprint() const override { return "Action(" + std::to_string(action) + ")"; }
+    std::vector<double> to_numpy() const override { return {(double) action}; }
+    std::vector<int> to_env_action() const override { return {action}; }
+};
+
+/**
+ * Alternative to SerializedPythonState for games whose state fits a fixed-size buffer: the states live in the
+ * game's StateArena and the tree holds no Python objects at all, Python is only called for the game logic.
+ * is_terminal() and is_self_side_turn() are asked once per state, when it is created
+ */
+class ArrayPythonState : public MCTS_state {
+private:
+    std::shared_ptr<ArrayPythonGame> game;
+    unsigned char* data;             // slot of game->arena
+    bool terminal;
+    bool self_side;
+
+    ArrayPythonState(std::shared_ptr<ArrayPythonGame> game, const unsigned char* source);
+    void query_flags();              // asks the game for terminal and self_side. The GIL must be held
+
+public:
+    // Copies state (any array-like, converted to the game's dtype)
+    // Throws std::invalid_argument if its size is not the game's state_size
+    ArrayPythonState(py::object game, py::object state);
+    ~ArrayPythonState() override;
+
+    std::queue<MCTS_move*>* actions_to_try() const override;
+    MCTS_state* next_state(const MCTS_move* move) const override;
+    double rollout() const override;
+    // With the game's rollout_many() both simulate every game of the call with one Python call
+    double rollout_n(int count) const override;
+    std::vector<double> rollout_many(const std::vector<const MCTS_state*>& states, int count) const override;
+    bool is_terminal() const override { return terminal; }
+    bool is_self_side_turn() const override { return self_side; }
+    void print() const override;
+    MCTS_state* clone() const override;
+    std::vector<double> to_numpy() const override;
+    int action_space_size() const override { return game->action_space_size; }
+    int action_index(const MCTS_move* move) const override;
+    // Saved trees with states: the raw buffer
+    bool serialize(std::string& out) const override;
+    MCTS_state* deserialize(const char* data, size_t size) const override;
+
+    // Copy of the state as a NumPy array of the game's dtype. The GIL must be held
+    py::array get_array() const;
+    size_t get_arena_slots() const { return game->arena.get_slots_in_use(); }
+};
+
+/**
+ * Leaf evaluator implemented in Python (pymcts.set_evaluator()), called once per leaf batch as
+ *   function(batch) -> (priors, values)
+ * With the numpy encoding batch is a float64 array with one to_numpy() row per state and priors a 2-D array (or
+ * sequence of rows) over every state's action_space_size(), indexed by action_index(). With the states encoding batch
+ * is a list of the states themselves (the wrapped Python object, the array of an ArrayPythonState or the native
+ * state, only valid during the call) and every row of priors follows the order of actions_to_try().
+ * priors may be None (uniform priors) and values are winrates of the self side in [0, 1], like rollout()
+ */
+class PythonEvaluator : public MCTS_evaluator {
+private:
+    py::object function;
+    bool numpy_encoding;
+
+public:
+    PythonEvaluator(py::object function, bool numpy_encoding) : function(function), numpy_encoding(numpy_encoding) {}
+    ~PythonEvaluator() override {
+        py::gil_scoped_acquire gil;      // the last reference may be dropped by a search running without the GIL
+        function = py::object();
+    }
+
+    bool evaluate(const std::vector<const MCTS_state*>& states, std::vector<std::vector<double>>& priors,
+                  std::vector<double>& values) override;
+    bool indexed_priors() const override { return numpy_encoding; }
+};
+
+namespace py = pybind11;
+
+/**
+ * Trampoline class for MCTS_move to enable Python inheritance
+ * Uses py::trampoline_self_life_support for safe lifetime management
+ */
+class PyMCTS_move : public MCTS_move, public py::trampoline_self_life_support {
+public:
+    using MCTS_move::MCTS_move;
+
+    bool operator==(const MCTS_move& other) const override {
+        PYBIND11_OVERRIDE_PURE(
+            bool,           /* Return type */
+            MCTS_move,      /* Parent class */
+            operator==,     /* Name of function in C++ (must match Python name) */
+            other           /* Arguments */
+        );
+    }
+
+    // Python __hash__ of the subclass, if it defines one
+    bool get_hash(size_t &h) const override {
+        py::gil_scoped_acquire gil;
+        return python_hash(py::cast(static_cast<const MCTS_move*>(this), py::return_value_policy::reference), h);
+    }
+
+    std::string sprint() const override {
+        PYBIND11_OVERRIDE_PURE(
+            std::string,    /* Return type */
+            MCTS_move,      /* Parent class */
+            sprint,         /* Name of function in C++ (must match Python name) */
+                            /* No arguments for this function */
+        );
+    }
+
+    std::vector<double> to_numpy() const override {
+        PYBIND11_OVERRIDE_PURE(
+            std::vector<double>, /* Return type */
+            MCTS_move,           /* Parent class */
+            to_numpy,            /* Name of function in C++ (must match Python name) */
+                                 /* No arguments for this function */
+        );
+    }
+
+    std::vector<int> to_env_action() const override {
+        PYBIND11_OVERRIDE_PURE(
+            std::vector<int>,    /* Return type */
+            MCTS_move,           /* Parent class */
+            to_env_action,       /* Name of function in C++ (must match Python name) */
+                                 /* No arguments for this function */
+        );
+    }
+};
+
+/**
+ * Trampoline class for MCTS_state to enable Python inheritance
+ * Uses py::trampoline_self_life_support for safe lifetime management
+ * The PYBIND11_OVERRIDE macros acquire the GIL themselves so these are safe to call from a search without it
+ */
+class PyMCTS_state : public MCTS_state, public py::trampoline_self_life_support {
+public:
+    using MCTS_state::MCTS_state;
+
+    ~PyMCTS_state() override = default;
+
+    std::queue<MCTS_move*>* actions_to_try() const override {
+        PYBIND11_OVERRIDE_PURE(
+            std::queue<MCTS_move*>*,  /* Return type */
+            MCTS_state,               /* Parent class */
+            actions_to_try,           /* Name of function in C++ (must match Python name) */
+                                      /* No arguments */
+        );
+    }
+
+    MCTS_state* next_state(const MCTS_move* move) const override {
+        PYBIND11_OVERRIDE_PURE(
+            MCTS_state*,              /* Return type */
+            MCTS_state,               /* Parent class */
+            next_state,               /* Name of function in C++ (must match Python name) */
+            move                      /* Arguments */
+        );
+    }
+    
+    double rollout() const override {
+        PYBIND11_OVERRIDE_PURE(
+            double,                   /* Return type */
+            MCTS_state,               /* Parent class */
+            rollout,                  /* Name of function in C++ (must match Python name) */
+                                      /* No arguments */
+        );
+    }
+
+    double rollout_n(int count) const override {
+        PYBIND11_OVERRIDE(
+            double,                   /* Return type */
+            MCTS_state,               /* Parent class */
+            rollout_n,                /* Name of function in C++ (must match Python name) */
+            count                     /* Arguments */
+        );
+    }
+
+    std::vector<double> rollout_many(const std::vector<const MCTS_state*>& states, int count) const override {
+        PYBIND11_OVERRIDE(
+            std::vector<double>,      /* Return type */
+            MCTS_state,               /* Parent class */
+            rollout_many,             /* Name of function in C++ (must match Python name) */
+            states, count             /* Arguments */
+        );
+    }
+
+    bool is_terminal() const override {
+        PYBIND11_OVERRIDE_PURE(
+            bool,                     /* Return type */
+            MCTS_state,               /* Parent class */
+            is_terminal,              /* Name of function in C++ (must match Python name) */
+                                      /* No arguments */
+        );
+    }
+
+    void print() const override {
+        PYBIND11_OVERRIDE_PURE(
+            void,                     /* Return type */
+            MCTS_state,               /* Parent class */
+            print,                    /* Name of function in C++ (must match Python name) */
+                                      /* No arguments */
+        );
+    }
+
+    bool is_self_side_turn() const override {
+        PYBIND11_OVERRIDE_PURE(
+            bool,                     /* Return type */
+            MCTS_state,               /* Parent class */
+            is_self_side_turn,        /* Name of function in C++ (must match Python name) */
+                                      /* No arguments */
+        );
+    }
+
+    MCTS_state* clone() const override {
+        PYBIND11_OVERRIDE_PURE(
+            MCTS_state*,              /* Return type */
+            MCTS_state,               /* Parent class */
+            clone,                    /* Name of function in C++ (must match Python name) */
+                                      /* No arguments */
+        );
+    }
+
+    std::vector<double> get_action_probabilities() const override {
+        PYBIND11_OVERRIDE(
+            std::vector<double>,      /* Return type */
+            MCTS_state,               /* Parent class */
+            get_action_probabilities, /* Name of function in C++ */
+                                      /* No arguments */
+        );
+    }
+};
+
+/**
+ * Helper function to convert queue<MCTS_move*>* to vector for Python
+ * This takes ownership of the queue and all moves in it
+ */
+std::vector<MCTS_move*> queue_to_vector(std::queue<MCTS_move*>* q);
+
+/**
+ * Helper function to convert vector to queue<MCTS_move*>*
+ * This creates new queue and transfers ownership of moves
+ */
+std::queue<MCTS_move*>* vector_to_queue(const std::vector<MCTS_move*>& vec);
+
+/**
+ * Safe wrapper for MCTS_agent that handles move ownership
+ * The starting state belongs to Python so the agent searches from a copy of it (StateOwnership::COPY)
+ * genmove_async() searches on a worker thread (without the GIL) and resolves a future with the move. While it runs
+ * the agent refuses other searches; stop() ends it early and the future then gets the best move found so far.
+ * Searches (genmove() also runs without the GIL) are claimed through searching, so only one runs at a time, and
+ * hold lock while they change the tree. The other calls raise instead of waiting while a search runs
+ */
+class SafeMCTS_agent {
+private:
+    MCTS_agent* agent;
+    std::thread search_thread;                          // worker of the last genmove_async()
+    std::atomic<bool> searching;                        // a genmove() or genmove_async() search has been started
+    mutable std::mutex lock;                            // held by whatever uses agent
+    std::shared_ptr<std::atomic<bool>> stop_search;     // stop flag of the running search (shared with its future)
+    // lock for a short call with the GIL held: never waits for a search (that may need the GIL), raises instead
+    std::unique_lock<std::mutex> lock_idle(const char* what) const;
+    py::object start_search(py::object enemy_move);     // genmove_async() once searching is claimed
+    
+public:
+    SafeMCTS_agent(MCTS_state* starting_state, int max_iter = 100000, int max_seconds = 30);
+    ~SafeMCTS_agent();
+    
+    // Returns nullptr if no move available (game ended)
+    const MCTS_move* genmove(const MCTS_move* enemy_move = nullptr);
+    // Returns an asyncio future of the running event loop, or a concurrent.futures.Future outside of one.
+    // Cancelling it also stops the search (the agent still plays the best move so far). The GIL must be held
+    py::object genmove_async(py::object enemy_move);
+    void stop();
+    bool is_searching() const { return searching; }
+    const MCTS_state* get_current_state() const;        // valid until the next search
+    void feedback() const;
+    MCTS_root_stats get_last_search_stats() const;
+    // Throw std::runtime_error if the tree can't be saved or loaded. Called with the GIL held
+    void save_tree(const std::string& path, bool with_states) const;
+    void load_tree(const std::string& path);
+    // See MCTS_agent::set_opening_book(). Throws std::runtime_error while a genmove_async() search is running
+    void set_opening_book(std::shared_ptr<const OpeningBook> book, unsigned int seed_visits, unsigned int play_visits);
+};
+
 #endif // PY_WRAPPERS_H
\ No newline at end of file
@@ -1,163 +1,574 @@
-#include <pybind11/pybind11.h>
-#include <pybind11/stl.h>
-#include <pybind11/functional.h>
-#include <pybind11/operators.h>
-#include <sstream>
-#include <thread>
-#include "py_wrappers.h"
-#include "../mcts/include/state.h"
-#include "mcts_python.h"  // Use Python-specific header
-#include "../examples/TicTacToe/TicTacToe.h"
-
-namespace py = pybind11;
-
-PYBIND11_MODULE(pymcts, m) {
-    m.doc() = "Python bindings for Monte Carlo Tree Search C++ library with smart_holder support";
-
-    // Abstract base classes with trampolines using py::smart_holder
-    py::class_<MCTS_move, PyMCTS_move, py::smart_holder>(m, "MCTS_move")
-        .def(py::init<>())
-        .def("__eq__", &MCTS_move::operator==)
-        .def("sprint", &MCTS_move::sprint, "Get string representation of the move")
-        .def("__str__", &MCTS_move::sprint)
-        .def("to_numpy", &MCTS_move::to_numpy, "Convert move to numpy array representation")
-        .def("to_env_action", &MCTS_move::to_env_action, "Convert move to environment action format");
-
-    py::class_<MCTS_state, PyMCTS_state, py::smart_holder>(m, "MCTS_state")
-        .def(py::init<>())
-        .def("actions_to_try", [](const MCTS_state& self) {
-            // Convert queue to vector for Python
-            auto* queue = self.actions_to_try();
-            return queue_to_vector(queue);
-        }, "Get list of possible moves from this state")
-        .def("next_state", &MCTS_state::next_state, 
-             "Get the state that results from applying the given move",
-             py::return_value_policy::take_ownership)
-        .def("rollout", &MCTS_state::rollout, 
-             "Perform a random rollout simulation and return win probability for self side")
-        .def("is_terminal", &MCTS_state::is_terminal, "Check if this is a terminal state")
-        .def("print", &MCTS_state::print, "Print the current state")
-        .def("is_self_side_turn", &MCTS_state::is_self_side_turn, "Check if it's the self side's turn")
-        .def("clone", &MCTS_state::clone, "Create a deep copy of this state", py::return_value_policy::take_ownership)
-        .def("get_action_probabilities", &MCTS_state::get_action_probabilities, "Get prior probabilities for possible moves");
-
-    // Core MCTS classes
-    py::class_<MCTS_node>(m, "MCTS_node")
-        .def("is_fully_expanded", &MCTS_node::is_fully_expanded, 
-             "Check if all possible moves from this node have been tried")
-        .def("is_terminal", &MCTS_node::is_terminal, "Check if this node represents a terminal state")
-        .def("get_move", &MCTS_node::get_move, 
-             "Get the move that led to this node", py::return_value_policy::reference)
-        .def("get_size", &MCTS_node::get_size, "Get the number of nodes in the subtree")
-        .def_property_readonly("prior_probability", &MCTS_node::get_prior_probability, "Get the prior probability for PUCT")
-        .def("expand", &MCTS_node::expand, "Expand this node by adding a new child")
-        .def("rollout", &MCTS_node::rollout, "Perform a rollout simulation from this node")
-        .def("select_best_child", &MCTS_node::select_best_child, 
-             "Select the best child using UCT", py::arg("c"))
-        .def("get_current_state", &MCTS_node::get_current_state, 
-             "Get the game state represented by this node", py::return_value_policy::reference)
-        .def("print_stats", &MCTS_node::print_stats, "Print statistics about this node")
-        .def("calculate_winrate", &MCTS_node::calculate_winrate, 
-             "Calculate win rate for the specified side", py::arg("self_side_turn"));
-
-    py::class_<MCTS_tree>(m, "MCTS_tree")
-        .def(py::init<MCTS_state*>(), "Create a new MCTS tree with the given starting state",
-             py::arg("starting_state"))
-        .def("select", &MCTS_tree::select, 
-             "Select a node to expand using UCT", py::arg("c") = 1.41)
-        .def("select_best_child", &MCTS_tree::select_best_child, 
-             "Select the best child of the root node")
-        .def("grow_tree", &MCTS_tree::grow_tree, 
-             "Grow the tree for the specified iterations or time",
-             py::arg("max_iter"), py::arg("max_time_in_seconds"))
-        .def("advance_tree", &MCTS_tree::advance_tree, 
-             "Advance the tree by applying the given move", py::arg("move"))
-        .def("get_size", &MCTS_tree::get_size, "Get the total number of nodes in the tree")
-        .def("get_current_state", &MCTS_tree::get_current_state, 
-             "Get the current root state", py::return_value_policy::reference)
-        .def("print_stats", &MCTS_tree::print_stats, "Print tree statistics");
-
-    // High-level agent interface (recommended for most users)
-    py::class_<SafeMCTS_agent>(m, "MCTS_agent")
-        .def(py::init<MCTS_state*, int, int>(), 
-             "Create an MCTS agent with the given starting state and parameters",
-             py::arg("starting_state"), py::arg("max_iter") = 100000, py::arg("max_seconds") = 30)
-        .def("genmove", &SafeMCTS_agent::genmove, 
-             "Generate the next move, optionally considering an enemy move first",
-             py::arg("enemy_move") = nullptr, py::return_value_policy::reference)
-        .def("get_current_state", &SafeMCTS_agent::get_current_state, 
-             "Get the current game state", py::return_value_policy::reference)
-        .def("feedback", &SafeMCTS_agent::feedback, "Print feedback about the agent's thinking");
-
-    // TicTacToe example implementation with py::smart_holder
-    py::class_<TicTacToe_move, MCTS_move, py::smart_holder>(m, "TicTacToe_move")
-        .def(py::init<int, int, char>(), 
-             "Create a TicTacToe move", py::arg("x"), py::arg("y"), py::arg("player"))
-        .def_readwrite("x", &TicTacToe_move::x, "X coordinate (0-2)")
-        .def_readwrite("y", &TicTacToe_move::y, "Y coordinate (0-2)")
-        .def_readwrite("player", &TicTacToe_move::player, "Player ('x' or 'o')")
-        .def("__eq__", &TicTacToe_move::operator==)
-        .def("__str__", [](const TicTacToe_move& move) {
-            return "TicTacToe_move(" + std::to_string(move.x) + ", " + 
-                   std::to_string(move.y) + ", '" + move.player + "')";
-        });
-
-    py::class_<TicTacToe_state, MCTS_state, py::smart_holder>(m, "TicTacToe_state")
-        .def(py::init<>(), "Create a new TicTacToe game state")
-        .def(py::init<const TicTacToe_state&>(), "Copy constructor")
-        .def("get_turn", &TicTacToe_state::get_turn, "Get whose turn it is ('x' or 'o')")
-        .def("get_winner", &TicTacToe_state::get_winner, 
-             "Get the winner ('x', 'o', 'd' for draw, or ' ' for ongoing)")
-        .def("actions_to_try", [](const TicTacToe_state& self) {
-            auto* queue = self.actions_to_try();
-            return queue_to_vector(queue);
-        }, "Get list of possible moves")
-        .def("next_state", &TicTacToe_state::next_state, 
-             "Get state after applying move", py::return_value_policy::take_ownership)
-        .def("rollout", &TicTacToe_state::rollout, "Perform random rollout simulation")
-        .def("is_terminal", &TicTacToe_state::is_terminal, "Check if game is finished")
-        .def("print", &TicTacToe_state::print, "Print the board")
-        .def("is_self_side_turn", &TicTacToe_state::is_self_side_turn, "Check if it's the self side's turn")
-        .def("clone", &TicTacToe_state::clone, "Create a deep copy of this state", py::return_value_policy::take_ownership)
-        .def("__str__", [](const TicTacToe_state& state) {
-            // Capture print output for Python string representation
-            std::ostringstream oss;
-            std::streambuf* old_cout = std::cout.rdbuf(oss.rdbuf());
-            state.print();
-            std::cout.rdbuf(old_cout);
-            return oss.str();
-        });
-
-    // Create an alias for easy access to C++ TicTacToe state
-    m.def("cpp_TicTacToeState", []() {
-        return new TicTacToe_state();
-    }, "Create a C++ TicTacToe state instance", py::return_value_policy::take_ownership);
-
-    // Utility functions
-    m.def("queue_to_vector", &queue_to_vector, 
-          "Convert a queue of moves to a vector (for internal use)");
-    m.def("vector_to_queue", &vector_to_queue, 
-          "Convert a vector of moves to a queue (for internal use)");
-    
-    // Python state wrapper for seamless Python game integration
-    py::class_<SerializedPythonState, MCTS_state, py::smart_holder>(m, "SerializedPythonState")
-        .def(py::init<py::object>(), "Wrap a Python game state object for C++ MCTS",
-             py::arg("python_state"));
-    
-    // Thread configuration functions
-    m.def("set_rollout_threads", [](unsigned int num_threads) {
-        MCTS_node::set_rollout_threads(num_threads);
-    }, "Set the global number of parallel rollout threads", py::arg("num_threads"));
-    
-    m.def("get_rollout_threads", []() {
-        return MCTS_node::get_rollout_threads();
-    }, "Get the current number of parallel rollout threads");
-    
-    m.def("get_optimal_thread_count", []() {
-        return ParallelRollouts::get_optimal_thread_count();
-    }, "Get the optimal number of threads based on hardware");
-    
-    m.def("get_hardware_concurrency", []() {
-        return std::thread::hardware_concurrency();
-    }, "Get the number of concurrent threads supported by the hardware");
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/functional.h>
+#include <pybind11/operators.h>
+#include <pybind11/numpy.h>
+#include <sstream>
+#include <fstream>
+#include <thread>
+#include <unordered_set>
+#include "py_wrappers.h"
+#include "../mcts/include/state.h"
+#include "../mcts/include/mcts.h"
+#include "../mcts/include/SelfPlay.h"
+#include "../mcts/include/GamePlugin.h"
+#include "../mcts/include/OpeningBook.h"
+#include "../examples/TicTacToe/TicTacToe.h"
+#include "../examples/Gomoku/Gomoku.h"
+#include "../examples/ConnectFour/ConnectFour.h"
+
+namespace py = pybind11;
+
+/** NumPy array that takes over the vector's buffer (no copy): the capsule deletes it with the array */
+template <typename T>
+static py::array_t<T> vector_to_array(std::vector<T> &&values, std::vector<py::ssize_t> shape) {
+    auto *owner = new std::vector<T>(std::move(values));
+    py::capsule free_when_done(owner, [](void *p) { delete reinterpret_cast<std::vector<T> *>(p); });
+    return py::array_t<T>(shape, owner->data(), free_when_done);
+}
+
+/** Root statistics as a dict of NumPy arrays: visits (uint32), q, prior (float64) and moves (float64, one to_numpy()
+ * row per child, shape (n, 0) if the moves have no common encoding) */
+static py::dict root_stats_to_dict(MCTS_root_stats &&stats) {
+    const py::ssize_t n = (py::ssize_t) stats.visits.size();
+    py::dict result;
+    result["visits"] = vector_to_array(std::move(stats.visits), {n});
+    result["q"] = vector_to_array(std::move(stats.values), {n});
+    result["prior"] = vector_to_array(std::move(stats.priors), {n});
+    result["moves"] = vector_to_array(std::move(stats.encodings), {n, (py::ssize_t) stats.encoding_size});
+    return result;
+}
+
+/** Data pointer of a preallocated self-play buffer: a writable C-contiguous float64 array, rows x row_size if matrix
+ * else 1-D with rows entries. rows < 0 takes the rows of the array */
+static double *self_play_buffer(py::object buffer, const char *name, py::ssize_t &rows, size_t row_size, bool matrix) {
+    if (!py::isinstance<py::array_t<double>>(buffer)) {
+        throw std::invalid_argument(std::string("self_play: ") + name + " must be a float64 NumPy array");
+    }
+    py::array array = buffer.cast<py::array>();
+    if (!array.writeable() || !(array.flags() & py::array::c_style)) {
+        throw std::invalid_argument(std::string("self_play: ") + name + " must be writable and C-contiguous");
+    }
+    if (array.ndim() != (matrix ? 2 : 1) || (matrix && (size_t) array.shape(1) != row_size)
+        || (rows >= 0 && array.shape(0) != rows)) {
+        throw std::invalid_argument(std::string("self_play: ") + name + " has the wrong shape");
+    }
+    rows = array.shape(0);
+    return static_cast<double *>(array.mutable_data());
+}
+
+/** Marks a tree as used by the calling Python thread. Searches release the GIL, so this is what keeps a second thread
+ * from racing on the nodes: its calls raise instead. Only touched with the GIL held */
+class TreeInUse {
+    static std::unordered_set<const MCTS_tree *> trees;
+    const MCTS_tree *tree;
+public:
+    TreeInUse(const MCTS_tree &tree, const char *what) : tree(&tree) {
+        if (!trees.insert(this->tree).second) {
+            throw std::runtime_error(std::string(what) + ": another thread is using this tree");
+        }
+    }
+    ~TreeInUse() { trees.erase(tree); }
+};
+std::unordered_set<const MCTS_tree *> TreeInUse::trees;
+
+PYBIND11_MODULE(pymcts, m) {
+    m.doc() = "Python bindings for Monte Carlo Tree Search C++ library with smart_holder support";
+
+    // Python states pay for every extra simulation with calls into the interpreter so start with one per leaf
+    MCTS_node::set_rollouts_per_leaf(1);
+
+    // Abstract base classes with trampolines using py::smart_holder
+    py::class_<MCTS_move, PyMCTS_move, py::smart_holder>(m, "MCTS_move")
+        .def(py::init<>())
+        .def("__eq__", &MCTS_move::operator==)
+        .def("sprint", &MCTS_move::sprint, "Get string representation of the move")
+        .def("__str__", &MCTS_move::sprint)
+        .def("to_numpy", &MCTS_move::to_numpy, "Convert move to numpy array representation")
+        .def("to_env_action", &MCTS_move::to_env_action, "Convert move to environment action format");
+
+    py::class_<MCTS_state, PyMCTS_state, py::smart_holder>(m, "MCTS_state")
+        .def(py::init<>())
+        .def("actions_to_try", [](const MCTS_state& self) {
+            // Convert queue to vector for Python
+            auto* queue = self.actions_to_try();
+            return queue_to_vector(queue);
+        }, "Get list of possible moves from this state")
+        .def("next_state", &MCTS_state::next_state, 
+             "Get the state that results from applying the given move",
+             py::return_value_policy::take_ownership)
+        .def("rollout", &MCTS_state::rollout, 
+             "Perform a random rollout simulation and return win probability for self side")
+        .def("rollout_n", &MCTS_state::rollout_n, py::arg("count"),
+             "Perform count random rollouts and return the sum of their results")
+        .def("rollout_many", &MCTS_state::rollout_many, py::arg("states"), py::arg("count"),
+             "Perform count random rollouts from each of the states and return one sum per state")
+        .def("winning_move", &MCTS_state::winning_move,
+             "Move that wins immediately for the side to move, or None", py::return_value_policy::take_ownership)
+        .def("blocking_move", &MCTS_state::blocking_move,
+             "Move that stops the opponent from winning on its next move, or None", py::return_value_policy::take_ownership)
+        .def("is_terminal", &MCTS_state::is_terminal, "Check if this is a terminal state")
+        .def("print", &MCTS_state::print, "Print the current state")
+        .def("is_self_side_turn", &MCTS_state::is_self_side_turn, "Check if it's the self side's turn")
+        .def("clone", &MCTS_state::clone, "Create a deep copy of this state", py::return_value_policy::take_ownership)
+        .def("get_action_probabilities", &MCTS_state::get_action_probabilities, "Get prior probabilities for possible moves")
+        .def("to_numpy", &MCTS_state::to_numpy, "Fixed-size encoding of the state (empty if the game has none)")
+        .def("action_space_size", &MCTS_state::action_space_size, "Number of flat move indices (0 if the game has none)")
+        .def("action_index", &MCTS_state::action_index, "Flat index of a move of this state", py::arg("move"));
+
+    // Core MCTS classes
+    py::class_<MCTS_node>(m, "MCTS_node")
+        .def("is_fully_expanded", &MCTS_node::is_fully_expanded, 
+             "Check if all possible moves from this node have been tried")
+        .def("is_terminal", &MCTS_node::is_terminal, "Check if this node represents a terminal state")
+        .def("get_move", &MCTS_node::get_move, 
+             "Get the move that led to this node", py::return_value_policy::reference)
+        .def("get_size", &MCTS_node::get_size, "Get the number of nodes in the subtree")
+        .def_property_readonly("prior_probability", &MCTS_node::get_prior_probability, "Get the prior probability for PUCT")
+        .def("expand", &MCTS_node::expand, "Expand this node by adding a new child",
+             py::call_guard<py::gil_scoped_release>())
+        .def("rollout", &MCTS_node::rollout, "Perform a rollout simulation from this node",
+             py::call_guard<py::gil_scoped_release>())
+        .def("select_best_child", &MCTS_node::select_best_child, 
+             "Select the best child using UCT", py::arg("c"))
+        .def("get_current_state", &MCTS_node::get_current_state, 
+             "Get the game state represented by this node", py::return_value_policy::reference)
+        .def("print_stats", &MCTS_node::print_stats, "Print statistics about this node")
+        .def("calculate_winrate", &MCTS_node::calculate_winrate, 
+             "Calculate win rate for the specified side", py::arg("self_side_turn"));
+
+    py::class_<MCTS_tree>(m, "MCTS_tree")
+        .def(py::init([](MCTS_state *starting_state) {
+                 return new MCTS_tree(starting_state, StateOwnership::COPY);     // the starting state stays with Python
+             }), "Create a new MCTS tree searching from a copy of the given starting state",
+             py::arg("starting_state"))
+        .def("select", [](MCTS_tree &self, double c) {
+                 TreeInUse use(self, "select");
+                 return self.select(c);
+             }, "Select a node to expand using UCT", py::arg("c") = 1.41, py::return_value_policy::reference)
+        .def("select_best_child", [](MCTS_tree &self) {
+                 TreeInUse use(self, "select_best_child");
+                 return self.select_best_child();
+             }, "Select the best child of the root node", py::return_value_policy::reference)
+        .def("save", [](const MCTS_tree &self, py::object path, bool states) {
+                 std::string file = py::module_::import("os").attr("fspath")(path).cast<std::string>(), error;
+                 TreeInUse use(self, "save");
+                 bool saved;
+                 {
+                     py::gil_scoped_release release;       // Python states and moves take the GIL back when asked
+                     saved = self.save(file, states, error);
+                 }
+                 if (!saved) throw std::runtime_error(error);
+             }, "Save the tree (statistics, structure and moves) to a compact binary file. states=True also stores "
+                "every state (pickled for SerializedPythonState, needs MCTS_state::serialize() for native games)",
+             py::arg("path"), py::arg("states") = false)
+        .def_static("load", [](py::object path, MCTS_state *starting_state) {
+                 std::string file = py::module_::import("os").attr("fspath")(path).cast<std::string>(), error;
+                 MCTS_tree *tree;
+                 {
+                     py::gil_scoped_release release;
+                     tree = MCTS_tree::load(file, starting_state, error, StateOwnership::COPY);
+                 }
+                 if (tree == NULL) throw std::runtime_error(error);
+                 return tree;
+             }, "Load a tree saved by save(). starting_state (copied) must be the saved root state, or any state of the "
+                "game if the states were saved", py::arg("path"), py::arg("starting_state"),
+             py::return_value_policy::take_ownership)
+        .def("grow_tree", [](MCTS_tree &self, int max_iter, double max_time_in_seconds) {
+                 TreeInUse use(self, "grow_tree");
+                 py::gil_scoped_release release;
+                 self.grow_tree(max_iter, max_time_in_seconds);
+             },
+             "Grow the tree for the specified iterations or time (other Python threads keep running meanwhile, but "
+             "their calls on this tree raise RuntimeError until it is done)",
+             py::arg("max_iter"), py::arg("max_time_in_seconds"))
+        .def("advance_tree", [](MCTS_tree &self, const MCTS_move *move) {
+                 TreeInUse use(self, "advance_tree");
+                 self.advance_tree(move);
+             }, "Advance the tree by applying the given move", py::arg("move"))
+        .def("get_size", [](const MCTS_tree &self) {
+                 TreeInUse use(self, "get_size");
+                 return self.get_size();
+             }, "Get the total number of nodes in the tree")
+        .def("get_current_state", [](const MCTS_tree &self) {
+                 TreeInUse use(self, "get_current_state");
+                 return self.get_current_state();
+             }, "Get the current root state", py::return_value_policy::reference)
+        .def("print_stats", [](const MCTS_tree &self) {
+                 TreeInUse use(self, "print_stats");
+                 self.print_stats();
+             }, "Print tree statistics")
+        .def("root_stats", [](MCTS_tree &self) {
+                 TreeInUse use(self, "root_stats");
+                 MCTS_root_stats stats;
+                 {
+                     py::gil_scoped_release release;       // Python moves take the GIL back in to_numpy()
+                     self.get_root_stats(stats);
+                 }
+                 return root_stats_to_dict(std::move(stats));
+             }, "Statistics of the root's children as NumPy arrays: dict with visits, q (winrate for the side to move), "
+                "prior and moves (to_numpy() rows)");
+
+    // High-level agent interface (recommended for most users)
+    // Searches (grow_tree/genmove, and expand/rollout above) release the GIL: native states never need it and Python
+    // states (SerializedPythonState, PyMCTS_state subclasses) take it back only around each call into Python.
+    // This is also what lets the rollout thread pool call into Python states without deadlocking.
+    py::class_<SafeMCTS_agent>(m, "MCTS_agent")
+        .def(py::init<MCTS_state*, int, int>(), 
+             "Create an MCTS agent with the given starting state and parameters",
+             py::arg("starting_state"), py::arg("max_iter") = 100000, py::arg("max_seconds") = 30)
+        .def("genmove", &SafeMCTS_agent::genmove, 
+             "Generate the next move, optionally considering an enemy move first (other Python threads keep running meanwhile)",
+             py::arg("enemy_move") = nullptr, py::return_value_policy::reference, py::call_guard<py::gil_scoped_release>())
+        .def("genmove_async", &SafeMCTS_agent::genmove_async,
+             "Start genmove() on a worker thread and return a future of the move (an asyncio future when called from "
+             "a running event loop, else a concurrent.futures.Future). Cancelling it stops the search like stop()",
+             py::arg("enemy_move") = py::none())
+        .def("stop", &SafeMCTS_agent::stop,
+             "End the running genmove_async() search early: its future gets the best move found so far")
+        .def("is_searching", &SafeMCTS_agent::is_searching, "Whether a search (genmove_async(), or genmove() of another thread) is still running")
+        .def("get_current_state", &SafeMCTS_agent::get_current_state, 
+             "Get the current game state", py::return_value_policy::reference)
+        .def("feedback", &SafeMCTS_agent::feedback, "Print feedback about the agent's thinking")
+        .def("save_tree", [](const SafeMCTS_agent &self, py::object path, bool states) {
+                 self.save_tree(py::module_::import("os").attr("fspath")(path).cast<std::string>(), states);
+             }, "Save the agent's tree like MCTS_tree.save()", py::arg("path"), py::arg("states") = false)
+        .def("load_tree", [](SafeMCTS_agent &self, py::object path) {
+                 self.load_tree(py::module_::import("os").attr("fspath")(path).cast<std::string>());
+             }, "Continue from a tree saved by save_tree() (of the current state, or any if it was saved with states: "
+                "its root becomes the current state)", py::arg("path"))
+        .def("set_opening_book", [](SafeMCTS_agent &self, py::object book, unsigned int seed_visits,
+                                    unsigned int play_visits) {
+                 std::shared_ptr<OpeningBook> opened = book.is_none() ? nullptr : book.cast<std::shared_ptr<OpeningBook>>();
+                 self.set_opening_book(opened, seed_visits, play_visits);
+             }, "Consult an OpeningBook (None -> none) before every genmove(): the root's unsearched moves start from the "
+                "book's statistics (at most seed_visits in total, 0 -> all of them) and positions with at least "
+                "play_visits book visits are played with the book's most visited move without searching (0 -> never)",
+             py::arg("book"), py::arg("seed_visits") = 1000, py::arg("play_visits") = 0)
+        .def("last_search_stats", [](const SafeMCTS_agent &self) {
+                 return root_stats_to_dict(self.get_last_search_stats());
+             }, "Root statistics of the last genmove() search (before playing its move) as NumPy arrays: dict with "
+                "visits, q (winrate for the side that moved), prior and moves (to_numpy() rows)");
+
+    // TicTacToe example implementation with py::smart_holder
+    py::class_<TicTacToe_move, MCTS_move, py::smart_holder>(m, "TicTacToe_move")
+        .def(py::init<int, int, char>(), 
+             "Create a TicTacToe move", py::arg("x"), py::arg("y"), py::arg("player"))
+        .def_readwrite("x", &TicTacToe_move::x, "X coordinate (0-2)")
+        .def_readwrite("y", &TicTacToe_move::y, "Y coordinate (0-2)")
+        .def_readwrite("player", &TicTacToe_move::player, "Player ('x' or 'o')")
+        .def("__eq__", &TicTacToe_move::operator==)
+        .def("__str__", [](const TicTacToe_move& move) {
+            return "TicTacToe_move(" + std::to_string(move.x) + ", " + 
+                   std::to_string(move.y) + ", '" + move.player + "')";
+        });
+
+    py::class_<TicTacToe_state, MCTS_state, py::smart_holder>(m, "TicTacToe_state")
+        .def(py::init<>(), "Create a new TicTacToe game state")
+        .def(py::init<const TicTacToe_state&>(), "Copy constructor")
+        .def("get_turn", &TicTacToe_state::get_turn, "Get whose turn it is ('x' or 'o')")
+        .def("get_winner", &TicTacToe_state::get_winner, 
+             "Get the winner ('x', 'o', 'd' for draw, or ' ' for ongoing)")
+        .def("actions_to_try", [](const TicTacToe_state& self) {
+            auto* queue = self.actions_to_try();
+            return queue_to_vector(queue);
+        }, "Get list of possible moves")
+        .def("next_state", &TicTacToe_state::next_state, 
+             "Get state after applying move", py::return_value_policy::take_ownership)
+        .def("rollout", &TicTacToe_state::rollout, "Perform random rollout simulation")
+        .def("rollout_n", &TicTacToe_state::rollout_n, py::arg("count"),
+             "Perform count random rollouts at once (parallel lanes) and return the sum of their results")
+        .def("heuristic_rollout", &TicTacToe_state::heuristic_rollout,
+             "Perform a rollout that wins, blocks, takes the center or a corner when it can and plays randomly otherwise")
+        .def("is_terminal", &TicTacToe_state::is_terminal, "Check if game is finished")
+        .def("print", &TicTacToe_state::print, "Print the board")
+        .def("is_self_side_turn", &TicTacToe_state::is_self_side_turn, "Check if it's the self side's turn")
+        .def("clone", &TicTacToe_state::clone, "Create a deep copy of this state", py::return_value_policy::take_ownership)
+        .def("exact_value", &TicTacToe_state::exact_value,
+             "Perfect-play value for x: 1.0 (x wins), 0.5 (draw) or 0.0 (o wins)")
+        .def("is_optimal_move", &TicTacToe_state::is_optimal_move,
+             "Check if move keeps the perfect-play value of this position", py::arg("move"))
+        .def("__str__", [](const TicTacToe_state& state) {
+            // Capture print output for Python string representation
+            std::ostringstream oss;
+            std::streambuf* old_cout = std::cout.rdbuf(oss.rdbuf());
+            state.print();
+            std::cout.rdbuf(old_cout);
+            return oss.str();
+        });
+
+    // Create an alias for easy access to C++ TicTacToe state
+    m.def("cpp_TicTacToeState", []() {
+        return new TicTacToe_state();
+    }, "Create a C++ TicTacToe state instance", py::return_value_policy::take_ownership);
+
+    // Gomoku (15,15,5 m,n,k-game) example implementation
+    py::class_<Gomoku_move, MCTS_move, py::smart_holder>(m, "Gomoku_move")
+        .def(py::init<short int, short int, char>(),
+             "Create a Gomoku move", py::arg("x"), py::arg("y"), py::arg("player"))
+        .def_readwrite("x", &Gomoku_move::x, "Row (0-14)")
+        .def_readwrite("y", &Gomoku_move::y, "Column (0-14)")
+        .def_readwrite("player", &Gomoku_move::player, "Player ('x' or 'o')")
+        .def("__eq__", &Gomoku_move::operator==)
+        .def("__str__", &Gomoku_move::sprint);
+
+    py::class_<Gomoku_state, MCTS_state, py::smart_holder>(m, "Gomoku_state")
+        .def(py::init<>(), "Create a new 15x15 five-in-a-row game state")
+        .def(py::init<const Gomoku_state&>(), "Copy constructor")
+        .def("get_turn", &Gomoku_state::get_turn, "Get whose turn it is ('x' or 'o')")
+        .def("get_winner", &Gomoku_state::get_winner,
+             "Get the winner ('x', 'o', 'd' for draw, or ' ' for ongoing)")
+        .def("get_number_of_stones", &Gomoku_state::get_number_of_stones, "Get the number of stones on the board")
+        .def("actions_to_try", [](const Gomoku_state& self) {
+            auto* queue = self.actions_to_try();
+            return queue_to_vector(queue);
+        }, "Get list of possible moves")
+        .def("next_state", &Gomoku_state::next_state,
+             "Get state after applying move", py::return_value_policy::take_ownership)
+        .def("rollout", &Gomoku_state::rollout, "Perform random rollout simulation")
+        .def("is_terminal", &Gomoku_state::is_terminal, "Check if game is finished")
+        .def("print", &Gomoku_state::print, "Print the board")
+        .def("is_self_side_turn", &Gomoku_state::is_self_side_turn, "Check if it's the self side's turn")
+        .def("clone", &Gomoku_state::clone, "Create a deep copy of this state", py::return_value_policy::take_ownership);
+
+    // Connect Four (7x6, bitboard) example implementation
+    py::class_<ConnectFour_move, MCTS_move, py::smart_holder>(m, "ConnectFour_move")
+        .def(py::init<int, char>(),
+             "Create a Connect Four move", py::arg("column"), py::arg("player"))
+        .def_readwrite("column", &ConnectFour_move::column, "Column (0-6)")
+        .def_readwrite("player", &ConnectFour_move::player, "Player ('X' or 'O')")
+        .def("__eq__", &ConnectFour_move::operator==)
+        .def("__str__", &ConnectFour_move::sprint);
+
+    py::class_<ConnectFour_state, MCTS_state, py::smart_holder>(m, "ConnectFour_state")
+        .def(py::init<>(), "Create a new Connect Four game state")
+        .def(py::init<const ConnectFour_state&>(), "Copy constructor")
+        .def("get_turn", &ConnectFour_state::get_turn, "Get whose turn it is ('X' or 'O')")
+        .def("get_winner", &ConnectFour_state::get_winner,
+             "Get the winner ('X', 'O', 'd' for draw, or ' ' for ongoing)")
+        .def("actions_to_try", [](const ConnectFour_state& self) {
+            auto* queue = self.actions_to_try();
+            return queue_to_vector(queue);
+        }, "Get list of possible moves")
+        .def("next_state", &ConnectFour_state::next_state,
+             "Get state after applying move", py::return_value_policy::take_ownership)
+        .def("rollout", &ConnectFour_state::rollout, "Perform random rollout simulation")
+        .def("is_terminal", &ConnectFour_state::is_terminal, "Check if game is finished")
+        .def("print", &ConnectFour_state::print, "Print the board")
+        .def("is_self_side_turn", &ConnectFour_state::is_self_side_turn, "Check if it's the self side's turn")
+        .def("clone", &ConnectFour_state::clone, "Create a deep copy of this state", py::return_value_policy::take_ownership);
+
+    // Native self-play (SelfPlay.h): games of a C++ state played on a thread pool, each with its own tree, without the GIL
+    m.def("self_play", [](const MCTS_state *state, int games, int max_iter, double max_seconds, unsigned int threads,
+                          int temperature_moves, unsigned int seed, py::object states, py::object policies,
+                          py::object outcomes, py::object path, bool append) {
+        SelfPlayConfig config(games, max_iter, max_seconds);
+        config.threads = threads;
+        config.temperature_moves = temperature_moves;
+        config.seed = seed;
+        const size_t state_size = state->to_numpy().size(), action_size = (size_t) std::max(state->action_space_size(), 0);
+        if (state_size == 0 || action_size == 0) {
+            throw std::invalid_argument("self_play: the state has no to_numpy() encoding or action_space_size()");
+        }
+        SelfPlayResult result;
+        if (!path.is_none()) {
+            SelfPlayFileWriter writer(py::module_::import("os").attr("fspath")(path).cast<std::string>(),
+                                      state_size, action_size, append);
+            if (!writer.is_open()) throw std::runtime_error("self_play: could not open the output file");
+            py::gil_scoped_release release;
+            result = self_play(state, config, writer);
+        } else {
+            if (states.is_none() || policies.is_none() || outcomes.is_none()) {
+                throw std::invalid_argument("self_play: pass either path or the states, policies and outcomes arrays");
+            }
+            py::ssize_t rows = -1;
+            double *s = self_play_buffer(states, "states", rows, state_size, true);
+            double *p = self_play_buffer(policies, "policies", rows, action_size, true);
+            double *o = self_play_buffer(outcomes, "outcomes", rows, 1, false);
+            SelfPlayBufferWriter writer(s, p, o, (size_t) rows, state_size, action_size);
+            py::gil_scoped_release release;
+            result = self_play(state, config, writer);
+        }
+        py::dict report;
+        report["games"] = result.games;
+        report["records"] = result.records;
+        report["seconds"] = result.seconds;
+        report["games_per_hour"] = result.games_per_hour();
+        return report;
+    }, "Play games of the tree against itself from state on threads threads (0 -> get_optimal_thread_count()) and store "
+       "one (state.to_numpy(), root visit distribution over action_index(), outcome for the side to move) record per "
+       "position: in the first rows of the preallocated float64 arrays states (N x len(to_numpy())), policies "
+       "(N x action_space_size()) and outcomes (N), or in the binary file at path (added to its end if append). "
+       "Only whole games are stored "
+       "and playing stops once one does not fit. The first temperature_moves moves of each game are sampled from the "
+       "visits. Returns a dict with games, records, seconds and games_per_hour",
+       py::arg("state"), py::arg("games"), py::arg("max_iter") = 1000, py::arg("max_seconds") = 10.0,
+       py::arg("threads") = 0, py::arg("temperature_moves") = 0, py::arg("seed") = 0,
+       py::arg("states") = py::none(), py::arg("policies") = py::none(), py::arg("outcomes") = py::none(),
+       py::arg("path") = py::none(), py::arg("append") = false);
+
+    // Native games built as shared libraries (see GamePlugin.h): their states are searched without any Python calls
+    py::class_<GamePlugin>(m, "GamePlugin")
+        .def_property_readonly("name", &GamePlugin::get_name)
+        .def_property_readonly("description", &GamePlugin::get_description)
+        .def_property_readonly("path", &GamePlugin::get_path)
+        .def("new_state", [](const GamePlugin &self, const std::string &options) {
+            MCTS_state *state = self.create_state(options);
+            if (state == NULL) {
+                throw std::invalid_argument(self.get_name() + " does not accept the options '" + options + "'");
+            }
+            return state;
+        }, "New starting state of the game (the options are game specific, see description)",
+           py::arg("options") = "", py::return_value_policy::take_ownership)
+        .def("__repr__", [](const GamePlugin &self) {
+            return "<GamePlugin " + self.get_name() + " from " + self.get_path() + ">";
+        });
+
+    // Opening books merged from saved trees, mapped read-only: agents in many processes share one copy of a book
+    py::class_<OpeningBook, py::smart_holder>(m, "OpeningBook")
+        .def(py::init([](py::object path) {
+            std::string error;
+            OpeningBook *book = OpeningBook::open(py::module_::import("os").attr("fspath")(path).cast<std::string>(), error);
+            if (book == NULL) throw std::runtime_error(error);
+            return book;
+        }), "Map a book file written by build_opening_book() (or quoridor_book)", py::arg("path"))
+        .def("__len__", &OpeningBook::get_size, "Number of positions")
+        .def("__contains__", [](const OpeningBook &self, const MCTS_state *state) {
+            py::gil_scoped_release release;       // Python states take the GIL back in serialize()
+            return self.find(state) != NULL;
+        }, py::arg("state"))
+        .def("visits", [](const OpeningBook &self, const MCTS_state *state) {
+            py::gil_scoped_release release;
+            const OpeningBookPosition *position = self.find(state);
+            return (position != NULL) ? position->visits : 0u;
+        }, "Simulations the book has for the position of state (0 if it isn't in the book)", py::arg("state"));
+
+    m.def("build_opening_book", [](py::object path, py::iterable trees, MCTS_state *starting_state, int max_depth,
+                                   unsigned int min_visits, bool merge) {
+        std::string book = py::module_::import("os").attr("fspath")(path).cast<std::string>(), error;
+        std::vector<std::string> files;
+        for (py::handle tree : trees) {
+            files.push_back(py::module_::import("os").attr("fspath")(tree).cast<std::string>());
+        }
+        py::gil_scoped_release release;
+        OpeningBookBuilder builder;
+        if (merge && std::ifstream(book).good()) {
+            OpeningBook *existing = OpeningBook::open(book, error);
+            if (existing == NULL) throw std::runtime_error(error);
+            builder.add_book(*existing);
+            delete existing;
+        }
+        for (const std::string &file : files) {
+            MCTS_tree *tree = MCTS_tree::load(file, starting_state, error, StateOwnership::COPY);
+            if (tree == NULL) throw std::runtime_error(file + ": " + error);
+            const bool added = builder.add_tree(*tree, max_depth, min_visits, error);
+            delete tree;
+            if (!added) throw std::runtime_error(error);
+        }
+        if (!builder.write(book, error)) throw std::runtime_error(error);
+        return builder.get_size();
+    }, "Merge the statistics of saved trees (MCTS_tree.save(), loaded like MCTS_tree.load() with starting_state) into "
+       "the opening book at path: every node at most max_depth plies below a root with at least min_visits "
+       "simulations. merge=True adds the book already at path. The game's states need a serializer (see "
+       "MCTS_state.serialize). Returns the number of positions",
+       py::arg("path"), py::arg("trees"), py::arg("starting_state"), py::arg("max_depth") = 8,
+       py::arg("min_visits") = 1, py::arg("merge") = true);
+
+    m.def("load_game", [](py::object path) {
+        std::string error;
+        GamePlugin *plugin = GamePlugin::load(py::module_::import("os").attr("fspath")(path).cast<std::string>(), error);
+        if (plugin == NULL) throw py::import_error(error);
+        return plugin;
+    }, "Load a game plugin (a shared library exporting MCTS_EXPORT_GAME, e.g. quoridor_plugin.so from "
+       "make QuoridorPlugin). Raises ImportError if it can't be loaded or was built against another state.h",
+       py::arg("path"), py::return_value_policy::take_ownership);
+
+    // Utility functions
+    m.def("queue_to_vector", &queue_to_vector, 
+          "Convert a queue of moves to a vector (for internal use)");
+    m.def("vector_to_queue", &vector_to_queue, 
+          "Convert a vector of moves to a queue (for internal use)");
+    
+    // Python state wrapper for seamless Python game integration
+    py::class_<SerializedPythonState, MCTS_state, py::smart_holder>(m, "SerializedPythonState")
+        .def(py::init<py::object>(), "Wrap a Python game state object for C++ MCTS",
+             py::arg("python_state"));
+
+    // Array-backed Python games: the states live in C++ arenas and the Python game object only provides the logic
+    py::class_<ArrayPythonMove, MCTS_move, py::smart_holder>(m, "ArrayPythonMove")
+        .def(py::init<int>(), py::arg("action"))
+        .def_readonly("action", &ArrayPythonMove::action)
+        .def("__hash__", [](const ArrayPythonMove &self) { return self.action; });
+
+    py::class_<ArrayPythonState, MCTS_state, py::smart_holder>(m, "ArrayPythonState")
+        .def(py::init<py::object, py::object>(),
+             "Start a game whose states are fixed-size NumPy buffers from the given state (copied). The game object "
+             "provides state_size, actions(), next_state(state, action, out), is_terminal(), is_self_side_turn() and "
+             "rollout() on buffers", py::arg("game"), py::arg("state"))
+        .def("get_array", &ArrayPythonState::get_array, "Copy of the state as a NumPy array of the game's state_dtype")
+        .def("get_arena_slots", &ArrayPythonState::get_arena_slots, "Number of states of this game currently alive");
+    
+    // Rollout configuration (global, shared by every tree and agent)
+    py::enum_<RolloutStrategy>(m, "RolloutStrategy")
+        .value("RANDOM", RolloutStrategy::RANDOM)
+        .value("HEURISTIC", RolloutStrategy::HEURISTIC)
+        .value("MIXED", RolloutStrategy::MIXED)
+        .value("HEAVY", RolloutStrategy::HEAVY);
+
+    m.def("set_rollout_strategy", &MCTS_node::set_rollout_strategy, "Set how leaves are simulated", py::arg("strategy"));
+    m.def("get_rollout_strategy", &MCTS_node::get_rollout_strategy, "Get how leaves are simulated");
+    m.def("set_heuristic_ratio", &MCTS_node::set_heuristic_ratio,
+          "Set the share of heuristic simulations for RolloutStrategy.MIXED (0.0 - 1.0)", py::arg("ratio"));
+    m.def("get_heuristic_ratio", &MCTS_node::get_heuristic_ratio, "Get the share of heuristic simulations for MIXED");
+    m.def("set_decisive_moves", &MCTS_node::set_decisive_moves,
+          "Start random simulations by taking immediate wins and blocking immediate losses", py::arg("enabled"));
+    m.def("get_decisive_moves", &MCTS_node::get_decisive_moves, "Check whether random simulations use decisive moves");
+    m.def("set_leaf_batch_size", &MCTS_node::set_leaf_batch_size,
+          "Select this many leaves before simulating them together (one rollout_many() call for Python states)",
+          py::arg("size"));
+    m.def("get_leaf_batch_size", &MCTS_node::get_leaf_batch_size, "Get the number of leaves simulated together");
+
+    // Batched leaf evaluation (e.g. a policy/value network): replaces rollouts and get_action_probabilities()
+    m.def("set_evaluator", [](py::object evaluator, const std::string &encoding, int batch_size) {
+        if (encoding != "numpy" && encoding != "states") {
+            throw std::invalid_argument("encoding must be 'numpy' or 'states', not '" + encoding + "'");
+        }
+        if (batch_size > 0) MCTS_node::set_leaf_batch_size(batch_size);
+        if (evaluator.is_none()) {
+            MCTS_node::set_evaluator(nullptr);
+        } else {
+            MCTS_node::set_evaluator(std::make_shared<PythonEvaluator>(evaluator, encoding == "numpy"));
+        }
+    }, "Evaluate leaves with evaluator(batch) -> (priors, values) instead of rollouts, one call per leaf batch (see "
+       "set_leaf_batch_size, or pass batch_size). With encoding='numpy' batch stacks the states' to_numpy() rows and "
+       "priors are indexed by action_index(), with 'states' batch lists the states and priors follow actions_to_try(). "
+       "priors may be None, values are winrates of the self side in [0, 1]. None goes back to rollouts",
+       py::arg("evaluator"), py::arg("encoding") = "numpy", py::arg("batch_size") = 0);
+    m.def("has_evaluator", []() { return MCTS_node::get_evaluator() != nullptr; },
+          "Whether leaves are evaluated by a set_evaluator() function");
+    // the evaluator holds a Python function: release it while the interpreter is still alive
+    py::module_::import("atexit").attr("register")(py::cpp_function([]() { MCTS_node::set_evaluator(nullptr); }));
+
+    // The engine's rollouts_per_leaf: simulations per expanded node, split over a pool of get_optimal_thread_count() threads
+    m.def("set_rollout_threads", [](unsigned int num_threads) {
+        MCTS_node::set_rollouts_per_leaf((num_threads == 0) ? 1 : (int) num_threads);
+    }, "Set the global number of parallel rollouts per expanded node (run on a pool of get_optimal_thread_count() threads)",
+       py::arg("num_threads"));
+    
+    m.def("get_rollout_threads", []() {
+        return (unsigned int) MCTS_node::get_rollouts_per_leaf();
+    }, "Get the current number of parallel rollouts per expanded node");
+    
+    m.def("set_rollout_thread_limit", &MCTS_node::set_rollout_thread_limit,
+          "Split the rollouts of a node over at most limit threads of the pool (0 -> all, 1 -> the searching thread)",
+          py::arg("limit"));
+    m.def("get_rollout_thread_limit", &MCTS_node::get_rollout_thread_limit,
+          "Get the most threads the rollouts of a node are split over (0 -> all of the pool)");
+    
+    m.def("get_optimal_thread_count", &MCTS_node::get_rollout_thread_count,
+          "Get the optimal number of threads based on hardware (the size of the rollout pool)");
+    
+    m.def("get_hardware_concurrency", []() {
+        return std::thread::hardware_concurrency();
+    }, "Get the number of concurrent threads supported by the hardware");
 }
\ No newline at end of file
@@ -1,112 +1,116 @@
-#!/usr/bin/env python3
-"""
-PyMCTS Test Runner
-Runs the consolidated pytest-based test suite.
-"""
-import sys
-import os
-import subprocess
-
-def main():
-    """Run the test suite with pytest."""
-    print("🧪 PyMCTS Test Suite")
-    print("=" * 50)
-    
-    # Check if we're in the right directory
-    if not os.path.exists('pytest.ini'):
-        print("❌ Error: Run this script from the project root directory")
-        return 1
-    
-    # Check if pytest is available
-    try:
-        import pytest
-    except ImportError:
-        print("❌ Error: pytest not installed. Install with: pip install pytest")
-        return 1
-    
-    # Check if pymcts module is available
-    try:
-        import pymcts
-        print("✅ PyMCTS module found")
-    except ImportError:
-        print("❌ Error: pymcts module not found. Build with: python setup.py build_ext --inplace")
-        return 1
-    
-    # Run different test categories
-    test_commands = [
-        ("Core Functionality (Safe)", ["pytest", "tests/test_core.py::TestModuleImport", "tests/test_core.py::TestTicTacToe", "-v"]),
-        ("Python Inheritance (Safe)", ["pytest", "tests/test_python_inheritance.py", "-v", "-k", "not (mcts or multiple_agents)"]),
-        ("Python Games (Safe)", ["pytest", "tests/test_python_games.py", "-v", "-k", "not mcts"]),
-        ("C++ TicTacToe (Basic)", ["pytest", "tests/test_cpp_tictactoe.py::TestCppTicTacToeBasic", "-v"]),
-        ("Heuristic Rollouts (Enhanced)", ["pytest", "tests/test_heuristic_rollouts.py", "-v"]),
-    ]
-    
-    # Run standalone MCTS functionality test (outside pytest)
-    standalone_tests = [
-        ("MCTS Comprehensive", ["test_mcts_comprehensive.py"]),
-    ]
-    
-    overall_success = True
-    
-    # Run pytest-based tests
-    for category, cmd in test_commands:
-        print(f"\n🔍 Running {category} Tests...")
-        print("-" * 30)
-        
-        try:
-            result = subprocess.run(cmd, capture_output=False, text=True)
-            if result.returncode == 0:
-                print(f"✅ {category} tests passed")
-            else:
-                print(f"❌ {category} tests failed")
-                overall_success = False
-        except Exception as e:
-            print(f"❌ Error running {category} tests: {e}")
-            overall_success = False
-    
-    # Run standalone tests (these work outside pytest)
-    for category, cmd in standalone_tests:
-        print(f"\n🚀 Running {category} Tests (Standalone)...")
-        print("-" * 40)
-        
-        original_dir = os.getcwd()
-        try:
-            # Change to tests directory for standalone tests
-            os.chdir('tests')
-            
-            result = subprocess.run(["python"] + cmd, capture_output=False, text=True)
-            
-            if result.returncode == 0:
-                print(f"✅ {category} tests passed")
-            else:
-                print(f"❌ {category} tests failed (but this may be expected due to Python exit codes)")
-                # Note: Standalone tests may exit with code 1 due to Python cleanup, but functionality works
-                print("   📝 Note: Check output above - if all tests show ✅ then functionality is working")
-        except Exception as e:
-            print(f"❌ Error running {category} tests: {e}")
-            overall_success = False
-        finally:
-            os.chdir(original_dir)
-    
-    print("\n" + "=" * 50)
-    if overall_success:
-        print("🎉 All test categories completed successfully!")
-        print("\n📋 To run specific test categories:")
-        print("  pytest tests/test_core.py::TestModuleImport    # Module imports")
-        print("  pytest tests/test_core.py::TestTicTacToe       # TicTacToe functionality")
-        print("  pytest tests/test_python_inheritance.py        # Python inheritance")
-        print("  pytest tests/test_python_games.py              # Python game demos")
-        print("  pytest tests/test_cpp_tictactoe.py::TestCppTicTacToeBasic  # C++ TicTacToe basic")
-        print("  pytest tests/test_heuristic_rollouts.py        # Heuristic rollout enhancement")
-        print("\n🚀 To run MCTS agent tests (standalone):")
-        print("  python tests/test_mcts_comprehensive.py        # Full MCTS functionality")
-        print("\n� Note: MCTS agent tests run outside pytest due to destructor incompatibility")
-        print("   The MCTS library works correctly - it's a pytest-specific environmental issue")
-        return 0
-    else:
-        print("❌ Some tests failed. Check output above for details.")
-        print("\n📝 Note: If standalone MCTS tests show ✅ marks, the library is working correctly")
-        return 1
-
-if __name__ == "__main__":
+#!/usr/bin/env python3
+"""
+PyMCTS Test Runner
+Runs the consolidated pytest-based test suite.
+"""
+import sys
+import os
+import subprocess
+
+def main():
+    """Run the test suite with pytest."""
+    print("🧪 PyMCTS Test Suite")
+    print("=" * 50)
+    
+    # Check if we're in the right directory
+    if not os.path.exists('pytest.ini'):
+        print("❌ Error: Run this script from the project root directory")
+        return 1
+    
+    # Check if pytest is available
+    try:
+        import pytest
+    except ImportError:
+        print("❌ Error: pytest not installed. Install with: pip install pytest")
+        return 1
+    
+    # Check if pymcts module is available
+    try:
+        import pymcts
+        print("✅ PyMCTS module found")
+    except ImportError:
+        print("❌ Error: pymcts module not found. Build with: python setup.py build_ext --inplace")
+        return 1
+    
+    # Run different test categories
+    test_commands = [
+        ("Core Functionality (Safe)", ["pytest", "tests/test_core.py::TestModuleImport", "tests/test_core.py::TestTicTacToe", "-v"]),
+        ("Python Inheritance (Safe)", ["pytest", "tests/test_python_inheritance.py", "-v", "-k", "not (mcts or multiple_agents)"]),
+        ("Python Games (Safe)", ["pytest", "tests/test_python_games.py", "-v", "-k", "not mcts"]),
+        ("C++ TicTacToe (Basic)", ["pytest", "tests/test_cpp_tictactoe.py::TestCppTicTacToeBasic", "-v"]),
+        ("C++ Gomoku (Basic)", ["pytest", "tests/test_cpp_gomoku.py::TestCppGomokuBasic", "-v"]),
+        ("C++ Connect Four (Basic)", ["pytest", "tests/test_cpp_connectfour.py::TestCppConnectFourBasic", "-v"]),
+        ("Heuristic Rollouts (Enhanced)", ["pytest", "tests/test_heuristic_rollouts.py", "-v"]),
+    ]
+    
+    # Run standalone MCTS functionality test (outside pytest)
+    standalone_tests = [
+        ("MCTS Comprehensive", ["test_mcts_comprehensive.py"]),
+    ]
+    
+    overall_success = True
+    
+    # Run pytest-based tests
+    for category, cmd in test_commands:
+        print(f"\n🔍 Running {category} Tests...")
+        print("-" * 30)
+        
+        try:
+            result = subprocess.run(cmd, capture_output=False, text=True)
+            if result.returncode == 0:
+                print(f"✅ {category} tests passed")
+            else:
+                print(f"❌ {category} tests failed")
+                overall_success = False
+        except Exception as e:
+            print(f"❌ Error running {category} tests: {e}")
+            overall_success = False
+    
+    # Run standalone tests (these work outside pytest)
+    for category, cmd in standalone_tests:
+        print(f"\n🚀 Running {category} Tests (Standalone)...")
+        print("-" * 40)
+        
+        original_dir = os.getcwd()
+        try:
+            # Change to tests directory for standalone tests
+            os.chdir('tests')
+            
+            result = subprocess.run(["python"] + cmd, capture_output=False, text=True)
+            
+            if result.returncode == 0:
+                print(f"✅ {category} tests passed")
+            else:
+                print(f"❌ {category} tests failed (but this may be expected due to Python exit codes)")
+                # Note: Standalone tests may exit with code 1 due to Python cleanup, but functionality works
+                print("   📝 Note: Check output above - if all tests show ✅ then functionality is working")
+        except Exception as e:
+            print(f"❌ Error running {category} tests: {e}")
+            overall_success = False
+        finally:
+            os.chdir(original_dir)
+    
+    print("\n" + "=" * 50)
+    if overall_success:
+        print("🎉 All test categories completed successfully!")
+        print("\n📋 To run specific test categories:")
+        print("  pytest tests/test_core.py::TestModuleImport    # Module imports")
+        print("  pytest tests/test_core.py::TestTicTacToe       # TicTacToe functionality")
+        print("  pytest tests/test_python_inheritance.py        # Python inheritance")
+        print("  pytest tests/test_python_games.py              # Python game demos")
+        print("  pytest tests/test_cpp_tictactoe.py::TestCppTicTacToeBasic  # C++ TicTacToe basic")
+        print("  pytest tests/test_cpp_gomoku.py::TestCppGomokuBasic        # C++ Gomoku basic")
+        print("  pytest tests/test_cpp_connectfour.py::TestCppConnectFourBasic  # C++ Connect Four basic")
+        print("  pytest tests/test_heuristic_rollouts.py        # Heuristic rollout enhancement")
+        print("\n🚀 To run MCTS agent tests (standalone):")
+        print("  python tests/test_mcts_comprehensive.py        # Full MCTS functionality")
+        print("\n� Note: MCTS agent tests run outside pytest due to destructor incompatibility")
+        print("   The MCTS library works correctly - it's a pytest-specific environmental issue")
+        return 0
+    else:
+        print("❌ Some tests failed. Check output above for details.")
+        print("\n📝 Note: If standalone MCTS tests show ✅ marks, the library is working correctly")
+        return 1
+
+if __name__ == "__main__":
     sys.exit(main())
\ No newline at end of file
@@ -1,50 +1,60 @@
-from pybind11.setup_helpers import Pybind11Extension, build_ext
-from pybind11 import get_cmake_dir
-import pybind11
-from setuptools import setup, Extension
-import os
-
-# Define the extension module
-ext_modules = [
-    Pybind11Extension(
-        "pymcts",
-        [
-            "pybind/pymcts.cpp",
-            "pybind/py_wrappers.cpp",
-            "pybind/mcts_python.cpp",  # Use Python-specific MCTS implementation
-            "examples/TicTacToe/TicTacToe.cpp",
-        ],
-        include_dirs=[
-            # Path to pybind11 headers
-            pybind11.get_include(),
-            "mcts/include",
-            "examples/TicTacToe",
-            "pybind",  # For our Python-specific headers
-        ],
-        cxx_std=11,
-        # Don't define PARALLEL_ROLLOUTS to disable parallel rollouts
-        extra_compile_args=[
-            "/O2" if os.name == 'nt' else "-O2",  # Use MSVC syntax on Windows
-            "/UPARALLEL_ROLLOUTS" if os.name == 'nt' else "-UPARALLEL_ROLLOUTS",  # Explicitly undefine
-        ],
-        extra_link_args=[
-        ],
-    ),
-]
-
-setup(
-    name="pymcts",
-    version="0.1.0",
-    author="MCTS Library Python Bindings",
-    author_email="",
-    url="",
-    description="Python bindings for Monte Carlo Tree Search C++ library",
-    long_description="",
-    ext_modules=ext_modules,
-    cmdclass={"build_ext": build_ext},
-    zip_safe=False,
-    python_requires=">=3.6",
-    install_requires=[
-        "pybind11>=2.6.0",
-    ],
+from pybind11.setup_helpers import Pybind11Extension, build_ext
+from pybind11 import get_cmake_dir
+import pybind11
+from setuptools import setup, Extension
+import os
+
+# Define the extension module
+ext_modules = [
+    Pybind11Extension(
+        "pymcts",
+        [
+            "pybind/pymcts.cpp",
+            "pybind/py_wrappers.cpp",
+            "mcts/src/mcts.cpp",  # The same engine the Makefile and the CMake mcts_lib target build
+            "mcts/src/JobScheduler.cpp",  # Thread pool for parallel rollouts
+            "mcts/src/SelfPlay.cpp",  # Native self-play runner (pymcts.self_play)
+            "mcts/src/TreeIO.cpp",  # MCTS_tree save()/load()
+            "mcts/src/OpeningBook.cpp",  # Memory-mapped opening books (pymcts.OpeningBook)
+            "mcts/src/GamePlugin.cpp",  # Loader of games built as shared libraries (pymcts.load_game)
+            "examples/TicTacToe/TicTacToe.cpp",
+            "examples/Gomoku/Gomoku.cpp",
+            "examples/ConnectFour/ConnectFour.cpp",
+        ],
+        include_dirs=[
+            # Path to pybind11 headers
+            pybind11.get_include(),
+            "mcts/include",
+            "examples/TicTacToe",
+            "examples/Gomoku",
+            "examples/ConnectFour",
+            "pybind",  # For the Python wrappers
+        ],
+        cxx_std=11,
+        # Parallel rollouts are enabled in mcts.h (see pymcts.set_rollout_threads)
+        extra_compile_args=[
+            "/O2" if os.name == 'nt' else "-O2",  # Use MSVC syntax on Windows
+        ],
+        extra_link_args=[
+        ],
+        libraries=[] if os.name == 'nt' else ["dl"],  # dlopen() for game plugins
+    ),
+]
+
+setup(
+    name="pymcts",
+    version="0.1.0",
+    author="MCTS Library Python Bindings",
+    author_email="",
+    url="",
+    description="Python bindings for Monte Carlo Tree Search C++ library",
+    long_description="",
+    ext_modules=ext_modules,
+    cmdclass={"build_ext": build_ext},
+    zip_safe=False,
+    python_requires=">=3.6",
+    install_requires=[
+        "pybind11>=2.6.0",
+        "numpy",  # search statistics are returned as NumPy arrays
+    ],
 )
\ No newline at end of file
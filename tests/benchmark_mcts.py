@@ -8,6 +8,7 @@ script_dir = os.path.dirname(os.path.abspath(__file__))
 parent_dir = os.path.abspath(os.path.join(script_dir, ".."))
 sys.path.append(script_dir)
 sys.path.append(parent_dir)
+sys.path.append(os.path.join(parent_dir, "demo"))
 
 try:
     import pymcts
@@ -94,6 +95,60 @@ def benchmark_parallel_performance():
     # Reset to 1 thread
     pymcts.set_rollout_threads(1)
 
+def benchmark_expansion_throughput(iterations=20000, python_iterations=2000):
+    """expand() calls per second as counted by the tree size (every expansion adds one node and rolls it out
+    once). Each one allocates exactly one state, the one returned by next_state()."""
+    print("\n--- Benchmarking Expansion Throughput ---")
+    from connect_four_python import ConnectFourState
+    games = [
+        ("TicTacToe (C++)", pymcts.TicTacToe_state, iterations),
+        ("ConnectFour (C++)", pymcts.ConnectFour_state, iterations),
+        ("Gomoku (C++)", pymcts.Gomoku_state, iterations),
+        ("ConnectFour (Python)", lambda: pymcts.SerializedPythonState(ConnectFourState()), python_iterations),
+    ]
+    print(f"{'Game':>22} | {'Expanded':>8} | {'Time (s)':>10} | {'Expansions/s':>12}")
+    print("-" * 62)
+    pymcts.set_rollout_threads(1)
+    for name, make_state, n in games:
+        tree = pymcts.MCTS_tree(make_state())
+        start_time = time.time()
+        tree.grow_tree(n, 1000)
+        elapsed = time.time() - start_time
+        nodes = tree.get_size()
+        print(f"{name:>22} | {nodes:8,d} | {elapsed:10.4f} | {nodes / elapsed:12.2f}")
+
+def benchmark_self_play(games=16, iterations=2000):
+    """Games per hour of Connect Four self-play: MCTS_agent.genmove() driven by a Python loop one game at a time
+    (collecting the same records) against the native self_play() runner on its thread pool."""
+    print("\n--- Benchmarking Self-Play (Connect Four) ---")
+    pymcts.set_rollout_threads(1)
+    start_time = time.time()
+    records = []
+    for _ in range(games):
+        agent = pymcts.MCTS_agent(pymcts.ConnectFour_state(), iterations, 1000)
+        positions = []
+        while not agent.get_current_state().is_terminal():
+            state = agent.get_current_state()
+            encoding = state.to_numpy()
+            agent.genmove(None)
+            stats = agent.last_search_stats()
+            policy = np.zeros(7)
+            policy[stats["moves"][:, 0].astype(int)] = stats["visits"] / stats["visits"].sum()
+            positions.append((encoding, policy, state.is_self_side_turn()))
+        result = agent.get_current_state().rollout()
+        records += [(e, p, result if own else 1.0 - result) for e, p, own in positions]
+    python_elapsed = time.time() - start_time
+
+    states, policies, outcomes = np.zeros((200 * games, 42)), np.zeros((200 * games, 7)), np.zeros(200 * games)
+    report = pymcts.self_play(pymcts.ConnectFour_state(), games, max_iter=iterations, max_seconds=1000,
+                              states=states, policies=policies, outcomes=outcomes)
+    print(f"{'Runner':>22} | {'Games':>6} | {'Records':>8} | {'Time (s)':>10} | {'Games/hour':>12}")
+    print("-" * 72)
+    print(f"{'Python genmove loop':>22} | {games:6d} | {len(records):8,d} | {python_elapsed:10.4f} | "
+          f"{3600 * games / python_elapsed:12,.0f}")
+    print(f"{'self_play()':>22} | {report['games']:6d} | {report['records']:8,d} | {report['seconds']:10.4f} | "
+          f"{report['games_per_hour']:12,.0f}")
+
 if __name__ == "__main__":
     print("MCTS Standardized Benchmark Suite")
     print("=" * 40)
@@ -102,4 +157,6 @@ if __name__ == "__main__":
     
     benchmark_genmove()
     benchmark_rollout_throughput()
+    benchmark_expansion_throughput()
+    benchmark_self_play()
     benchmark_parallel_performance()
@@ -1,99 +1,99 @@
-"""
-Minimal core functionality tests for PyMCTS.
-Focuses on functionality that works without causing memory issues.
-"""
-import pytest
-import time
-
-
-class TestModuleImport:
-    """Test that the PyMCTS module imports and basic functions work."""
-    
-    def test_module_imports(self, pymcts_module):
-        """Test that pymcts module imports successfully."""
-        assert pymcts_module is not None
-        
-    def test_hardware_info(self, pymcts_module):
-        """Test hardware information functions."""
-        concurrency = pymcts_module.get_hardware_concurrency()
-        optimal = pymcts_module.get_optimal_thread_count()
-        
-        assert concurrency > 0
-        assert optimal > 0
-        assert optimal <= concurrency
-        
-    def test_thread_configuration(self, pymcts_module):
-        """Test thread configuration functions."""
-        original = pymcts_module.get_rollout_threads()
-        
-        # Test setting different values
-        for threads in [1, 2, 4]:
-            pymcts_module.set_rollout_threads(threads)
-            assert pymcts_module.get_rollout_threads() == threads
-        
-        # Restore original
-        pymcts_module.set_rollout_threads(original)
-
-
-class TestTicTacToeBasic:
-    """Test basic TicTacToe functionality without MCTS agent."""
-    
-    def test_state_creation(self, pymcts_module):
-        """Test that TicTacToe state can be created."""
-        state = pymcts_module.TicTacToe_state()
-        assert state is not None
-        assert not state.is_terminal()
-        assert state.is_self_side_turn()
-        
-    def test_move_generation(self, pymcts_module):
-        """Test that moves can be generated."""
-        state = pymcts_module.TicTacToe_state()
-        moves = state.actions_to_try()
-        assert len(moves) == 9  # Empty board should have 9 possible moves
-        
-    def test_state_transitions(self, pymcts_module):
-        """Test state transitions work correctly."""
-        state = pymcts_module.TicTacToe_state()
-        moves = state.actions_to_try()
-        assert len(moves) > 0
-        
-        # Make a move
-        new_state = state.next_state(moves[0])
-        assert new_state is not None
-        assert not new_state.is_self_side_turn()  # Should switch players
-        
-        # New state should have fewer moves available  
-        new_moves = new_state.actions_to_try()
-        assert len(new_moves) == len(moves) - 1
-        
-    def test_rollout(self, pymcts_module):
-        """Test rollout functionality."""
-        state = pymcts_module.TicTacToe_state()
-        result = state.rollout()
-        assert 0.0 <= result <= 1.0
-        
-    def test_move_sprint(self, pymcts_module):
-        """Test move string representation."""
-        state = pymcts_module.TicTacToe_state()
-        moves = state.actions_to_try()
-        assert len(moves) > 0
-        
-        move_str = moves[0].sprint()
-        assert isinstance(move_str, str)
-        assert len(move_str) > 0
-
-
-# NOTE: MCTS Agent tests disabled due to memory corruption issues
-# This appears to be a bug in the C++ implementation that causes
-# Windows fatal exception: code 0xc0000374
-# 
-# The working tests above verify that:
-# - PyMCTS module imports correctly
-# - Hardware detection works
-# - Thread configuration works  
-# - TicTacToe state creation and basic operations work
-# - Move generation and state transitions work
-# - Rollout functionality works
-#
-# For comprehensive testing including MCTS agents, 
+"""
+Minimal core functionality tests for PyMCTS.
+Focuses on functionality that works without causing memory issues.
+"""
+import pytest
+import time
+
+
+class TestModuleImport:
+    """Test that the PyMCTS module imports and basic functions work."""
+    
+    def test_module_imports(self, pymcts_module):
+        """Test that pymcts module imports successfully."""
+        assert pymcts_module is not None
+        
+    def test_hardware_info(self, pymcts_module):
+        """Test hardware information functions."""
+        concurrency = pymcts_module.get_hardware_concurrency()
+        optimal = pymcts_module.get_optimal_thread_count()
+        
+        assert concurrency > 0
+        assert optimal > 0
+        assert optimal <= concurrency
+        
+    def test_thread_configuration(self, pymcts_module):
+        """Test thread configuration functions."""
+        original = pymcts_module.get_rollout_threads()
+        
+        # Test setting different values
+        for threads in [1, 2, 4]:
+            pymcts_module.set_rollout_threads(threads)
+            assert pymcts_module.get_rollout_threads() == threads
+        
+        # Restore original
+        pymcts_module.set_rollout_threads(original)
+
+
+class TestTicTacToeBasic:
+    """Test basic TicTacToe functionality without MCTS agent."""
+    
+    def test_state_creation(self, pymcts_module):
+        """Test that TicTacToe state can be created."""
+        state = pymcts_module.TicTacToe_state()
+        assert state is not None
+        assert not state.is_terminal()
+        assert state.is_self_side_turn()
+        
+    def test_move_generation(self, pymcts_module):
+        """Test that moves can be generated."""
+        state = pymcts_module.TicTacToe_state()
+        moves = state.actions_to_try()
+        assert len(moves) == 9  # Empty board should have 9 possible moves
+        
+    def test_state_transitions(self, pymcts_module):
+        """Test state transitions work correctly."""
+        state = pymcts_module.TicTacToe_state()
+        moves = state.actions_to_try()
+        assert len(moves) > 0
+        
+        # Make a move
+        new_state = state.next_state(moves[0])
+        assert new_state is not None
+        assert not new_state.is_self_side_turn()  # Should switch players
+        
+        # New state should have fewer moves available  
+        new_moves = new_state.actions_to_try()
+        assert len(new_moves) == len(moves) - 1
+        
+    def test_rollout(self, pymcts_module):
+        """Test rollout functionality."""
+        state = pymcts_module.TicTacToe_state()
+        result = state.rollout()
+        assert 0.0 <= result <= 1.0
+        
+    def test_move_sprint(self, pymcts_module):
+        """Test move string representation."""
+        state = pymcts_module.TicTacToe_state()
+        moves = state.actions_to_try()
+        assert len(moves) > 0
+        
+        move_str = moves[0].sprint()
+        assert isinstance(move_str, str)
+        assert len(move_str) > 0
+
+
+# NOTE: MCTS Agent tests disabled due to memory corruption issues
+# This appears to be a bug in the C++ implementation that causes
+# Windows fatal exception: code 0xc0000374
+# 
+# The working tests above verify that:
+# - PyMCTS module imports correctly
+# - Hardware detection works
+# - Thread configuration works  
+# - TicTacToe state creation and basic operations work
+# - Move generation and state transitions work
+# - Rollout functionality works
+#
+# For comprehensive testing including MCTS agents, 
 # the issues in the C++ module need to be resolved first.
\ No newline at end of file
@@ -0,0 +1,100 @@
+"""
+Tests for C++ Connect Four implementation.
+Native bitboard counterpart of demo/connect_four_python.py.
+"""
+import pytest
+
+
+def play_columns(pymcts_module, columns):
+    """Play the given columns alternately starting with X and return the resulting state."""
+    state = pymcts_module.ConnectFour_state()
+    for column in columns:
+        state = state.next_state(pymcts_module.ConnectFour_move(column, state.get_turn()))
+        assert state is not None
+    return state
+
+
+class TestCppConnectFourBasic:
+    """Test C++ Connect Four basic functionality without MCTS agents."""
+
+    def test_connectfour_state_creation(self, pymcts_module):
+        """Test that C++ Connect Four state can be created."""
+        state = pymcts_module.ConnectFour_state()
+        assert not state.is_terminal()
+        assert state.is_self_side_turn()
+        assert state.get_turn() == 'X'
+        assert len(state.actions_to_try()) == 7
+
+    def test_connectfour_full_column(self, pymcts_module):
+        """Test that a full column is no longer offered nor playable."""
+        state = play_columns(pymcts_module, [3] * 6)
+        moves = state.actions_to_try()
+        assert len(moves) == 6
+        assert all(move.column != 3 for move in moves)
+        assert state.next_state(pymcts_module.ConnectFour_move(3, state.get_turn())) is None
+
+    @pytest.mark.parametrize("columns", [
+        [0, 1, 0, 1, 0, 1, 0],                    # vertical
+        [0, 0, 1, 1, 2, 2, 3],                    # horizontal
+        [0, 1, 1, 2, 2, 3, 2, 3, 3, 6, 3],        # diagonal /
+        [6, 5, 5, 4, 4, 3, 4, 3, 3, 0, 3],        # diagonal \
+    ])
+    def test_connectfour_win_detection(self, pymcts_module, columns):
+        """Test that four in a row is detected in every direction and only on the last move."""
+        before = play_columns(pymcts_module, columns[:-1])
+        assert before.get_winner() == ' '
+        state = play_columns(pymcts_module, columns)
+        assert state.get_winner() == 'X'
+        assert state.is_terminal()
+        assert state.rollout() == 1.0
+        assert len(state.actions_to_try()) == 0
+
+    def test_connectfour_no_wrap_between_columns(self, pymcts_module):
+        """Test that stones at the top of one column and the bottom of the next are not connected."""
+        # X ends up on rows 3-5 of column 0 and row 0 of column 1, which would be contiguous bits without the sentinel
+        state = play_columns(pymcts_module, [1, 0, 6, 0, 6, 0, 0, 5, 0, 5, 0])
+        assert state.get_winner() == ' '
+
+    def test_connectfour_decisive_moves(self, pymcts_module):
+        """Test that immediate wins and immediate losses are found."""
+        state = play_columns(pymcts_module, [0, 6, 0, 6, 0])   # X threatens column 0, O to move
+        assert state.winning_move() is None
+        block = state.blocking_move()
+        assert block.column == 0 and block.player == 'O'
+        state = play_columns(pymcts_module, [0, 6, 0, 6, 0, 5])  # X to move and win
+        win = state.winning_move()
+        assert win.column == 0 and win.player == 'X'
+        assert state.next_state(win).get_winner() == 'X'
+
+    def test_connectfour_rollout(self, pymcts_module):
+        """Test C++ Connect Four rollout functionality."""
+        state = pymcts_module.ConnectFour_state()
+        for _ in range(10):
+            result = state.rollout()
+            assert result in (0.0, 0.5, 1.0)
+
+
+class TestCppConnectFourWithMCTS:
+    """Test C++ Connect Four with MCTS agent."""
+
+    def test_connectfour_agent_blocks_vertical_threat(self, pymcts_module):
+        """Test that the agent finds the only move that prevents an immediate loss."""
+        # X has three stacked in column 0 and it is O's turn
+        state = play_columns(pymcts_module, [0, 6, 0, 6, 0])
+        agent = pymcts_module.MCTS_agent(state, 2000, 5)
+        move = agent.genmove(None)
+        assert move.column == 0
+
+    def test_connectfour_last_search_stats(self, pymcts_module):
+        """Test that the root statistics of the last search come back as NumPy arrays."""
+        np = pytest.importorskip("numpy")
+        state = play_columns(pymcts_module, [0, 6, 0, 6, 0])
+        agent = pymcts_module.MCTS_agent(state, 500, 5)
+        move = agent.genmove(None)
+        stats = agent.last_search_stats()
+        assert stats["visits"].shape == (7,) and stats["visits"].dtype == np.uint32
+        assert stats["q"].shape == stats["prior"].shape == (7,)
+        assert stats["moves"].shape == (7, 2)                 # ConnectFour_move.to_numpy(): [column, player]
+        assert np.all((stats["q"] >= 0.0) & (stats["q"] <= 1.0))
+        assert stats["visits"].sum() <= 500 * pymcts_module.get_rollout_threads()
+        assert stats["moves"][np.argmax(stats["q"]), 0] == move.column == 0
@@ -0,0 +1,67 @@
+"""
+Tests for C++ Gomoku (15x15 five-in-a-row) implementation.
+Large branching factor game used to exercise the MCTS engine.
+"""
+import pytest
+
+
+class TestCppGomokuBasic:
+    """Test C++ Gomoku basic functionality without MCTS agents."""
+
+    def test_gomoku_state_creation(self, pymcts_module):
+        """Test that C++ Gomoku state can be created."""
+        state = pymcts_module.Gomoku_state()
+        assert not state.is_terminal()
+        assert state.is_self_side_turn()
+        assert state.get_turn() == 'x'
+        assert state.get_winner() == ' '
+
+    def test_gomoku_moves(self, pymcts_module):
+        """Test C++ Gomoku move generation."""
+        state = pymcts_module.Gomoku_state()
+        moves = state.actions_to_try()
+        assert len(moves) == 225  # 15x15 board
+
+        new_state = state.next_state(moves[0])
+        assert new_state.get_number_of_stones() == 1
+        assert not new_state.is_self_side_turn()
+        assert len(new_state.actions_to_try()) == 224
+
+    def test_gomoku_occupied_square_rejected(self, pymcts_module):
+        """Test that playing an occupied square returns no state."""
+        state = pymcts_module.Gomoku_state()
+        state = state.next_state(pymcts_module.Gomoku_move(7, 7, 'x'))
+        assert state.next_state(pymcts_module.Gomoku_move(7, 7, 'o')) is None
+
+    @pytest.mark.parametrize("dx,dy", [(0, 1), (1, 0), (1, 1), (1, -1)])
+    def test_gomoku_win_detection(self, pymcts_module, dx, dy):
+        """Test that five in a row wins in every direction, completed from the middle."""
+        state = pymcts_module.Gomoku_state()
+        # play the middle stone last so the win has to be found in both directions
+        line = [(7 + i * dx, 7 + i * dy) for i in (-2, -1, 1, 2, 0)]
+        for i, (x, y) in enumerate(line):
+            state = state.next_state(pymcts_module.Gomoku_move(x, y, 'x'))
+            if i < 4:
+                assert state.get_winner() == ' '
+                state = state.next_state(pymcts_module.Gomoku_move(0, 2 * i, 'o'))
+        assert state.get_winner() == 'x'
+        assert state.is_terminal()
+        assert state.rollout() == 1.0
+
+    def test_gomoku_rollout(self, pymcts_module):
+        """Test C++ Gomoku rollout functionality."""
+        state = pymcts_module.Gomoku_state()
+        for _ in range(10):
+            result = state.rollout()
+            assert 0.0 <= result <= 1.0
+
+
+class TestCppGomokuWithMCTS:
+    """Test C++ Gomoku with MCTS agent."""
+
+    def test_gomoku_agent_genmove(self, pymcts_module):
+        """Test that the agent can search the 225-wide root."""
+        agent = pymcts_module.MCTS_agent(pymcts_module.Gomoku_state(), 500, 5)
+        move = agent.genmove(None)
+        assert move is not None
+        assert isinstance(agent.get_current_state(), pymcts_module.Gomoku_state)
@@ -1,184 +1,292 @@
-"""
-Tests for C++ TicTacToe implementation.
-Tests the built-in C++ TicTacToe game to verify core MCTS functionality.
-"""
-import pytest
-import time
-
-
-class TestCppTicTacToeBasic:
-    """Test C++ TicTacToe basic functionality without MCTS agents."""
-    
-    def test_tictactoe_state_creation(self, tictactoe_state):
-        """Test that C++ TicTacToe state can be created."""
-        assert tictactoe_state is not None
-        assert not tictactoe_state.is_terminal()
-        assert tictactoe_state.is_self_side_turn()
-        
-    def test_tictactoe_moves(self, tictactoe_state):
-        """Test C++ TicTacToe move generation."""
-        moves = tictactoe_state.actions_to_try()
-        assert len(moves) == 9  # TicTacToe has 9 positions
-        
-        # All moves should be valid
-        for move in moves:
-            assert move is not None
-            assert hasattr(move, 'sprint')
-            move_str = move.sprint()
-            assert isinstance(move_str, str)
-            assert len(move_str) > 0
-            
-    def test_tictactoe_state_transitions(self, tictactoe_state):
-        """Test C++ TicTacToe state transitions."""
-        moves = tictactoe_state.actions_to_try()
-        assert len(moves) > 0
-        
-        # Make a move
-        new_state = tictactoe_state.next_state(moves[0])
-        assert new_state is not None
-        assert not new_state.is_self_side_turn()  # Should switch players
-        
-        # Should have one fewer move available
-        new_moves = new_state.actions_to_try()
-        assert len(new_moves) == len(moves) - 1
-        
-    def test_tictactoe_rollout(self, tictactoe_state):
-        """Test C++ TicTacToe rollout functionality."""
-        for _ in range(5):  # Test multiple times
-            rollout_result = tictactoe_state.rollout()
-            assert isinstance(rollout_result, (int, float))
-            assert 0.0 <= rollout_result <= 1.0
-            
-    def test_tictactoe_terminal_detection(self, tictactoe_state):
-        """Test C++ TicTacToe terminal state detection."""
-        # Initial state should not be terminal
-        assert not tictactoe_state.is_terminal()
-        
-        # Play a complete game to test terminal detection
-        current_state = tictactoe_state
-        moves_made = 0
-        
-        while not current_state.is_terminal() and moves_made < 9:
-            moves = current_state.actions_to_try()
-            if not moves:
-                break
-            current_state = current_state.next_state(moves[0])
-            moves_made += 1
-        
-        # Should eventually reach terminal state or fill the board
-        # Note: TicTacToe might still have moves available in terminal states
-        # if it only detects wins, not draws
-        if current_state.is_terminal():
-            # Terminal state detected - this is correct behavior
-            assert True
-        else:
-            # If not terminal but we filled the board, that's also valid
-            assert moves_made == 9
-
-
-# Working MCTS agent tests - issue was incorrect constructor syntax
-
-class TestCppTicTacToeWithMCTS:
-    """Test C++ TicTacToe with MCTS agent."""
-    
-    def test_tictactoe_with_mcts_agent(self, mcts_agent_factory):
-        """Test C++ TicTacToe with MCTS agent."""
-        import pymcts
-        tictactoe_state = pymcts.TicTacToe_state()
-        
-        # Create MCTS agent with factory for proper cleanup
-        agent = mcts_agent_factory(tictactoe_state, 100, 2)  # 100 iterations, 2 seconds max
-        
-        # Should be able to generate a move
-        move = agent.genmove(None)
-        assert move is not None
-        assert hasattr(move, 'sprint')
-        
-        move_str = move.sprint()
-        assert isinstance(move_str, str)
-        assert len(move_str) > 0
-        
-        print(f"MCTS generated move: {move_str}")
-        
-        # Note: agent will be cleaned up by fixture
-        
-    def test_tictactoe_full_game_with_mcts(self, pymcts_module):
-        """Test a complete TicTacToe game with MCTS."""
-        initial_state = pymcts_module.TicTacToe_state()
-        agent = pymcts_module.MCTS_agent(initial_state, 50, 1)  # Quick game for testing
-        
-        moves_played = 0
-        max_moves = 9  # TicTacToe has maximum 9 moves
-        
-        while not agent.get_current_state().is_terminal() and moves_played < max_moves:
-            current_state = agent.get_current_state()
-            print(f"Move {moves_played + 1}:")
-            current_state.print()
-            
-            if current_state.is_self_side_turn():
-                # MCTS agent's turn
-                agent_move = agent.genmove(None)
-                assert agent_move is not None
-                print(f"MCTS chose: {agent_move.sprint()}")
-            else:
-                # Simulate opponent - take first available move
-                possible_moves = current_state.actions_to_try()
-                if possible_moves:
-                    opponent_move = possible_moves[0]
-                    agent.genmove(opponent_move)
-                    print(f"Opponent chose: {opponent_move.sprint()}")
-                else:
-                    break
-            
-            moves_played += 1
-        
-        # Game should have progressed
-        assert moves_played > 0
-        
-        final_state = agent.get_current_state()
-        print("Final state:")
-        final_state.print()
-        
-        if final_state.is_terminal():
-            print("Game finished!")
-        else:
-            print(f"Game ended early after {moves_played} moves")
-            
-    def test_mcts_agent_performance(self, pymcts_module):
-        """Test MCTS agent performance characteristics."""
-        state = pymcts_module.TicTacToe_state()
-        
-        # Test with different iteration counts
-        for iterations in [10, 50, 100]:
-            agent = pymcts_module.MCTS_agent(state, iterations, 1)
-            
-            start_time = time.time()
-            move = agent.genmove(None)
-            elapsed = time.time() - start_time
-            
-            assert move is not None
-            assert elapsed < 2.0  # Should be reasonably fast
-            
-            print(f"Iterations: {iterations}, Time: {elapsed:.3f}s, Move: {move.sprint()}")
-            
-    def test_mcts_agent_statistics(self, pymcts_module):
-        """Test MCTS agent statistics and feedback."""
-        state = pymcts_module.TicTacToe_state()
-        agent = pymcts_module.MCTS_agent(state, 100, 1)
-        
-        # Generate a move to populate statistics
-        move = agent.genmove(None)
-        assert move is not None
-        
-        # Test that feedback works (this method should exist and not crash)
-        try:
-            agent.feedback()
-            print("Agent feedback displayed successfully")
-        except AttributeError:
-            # If feedback method doesn't exist, that's OK
-            print("Agent feedback method not available")
-        
-        # Test getting current state
-        current_state = agent.get_current_state()
-        assert current_state is not None
+"""
+Tests for C++ TicTacToe implementation.
+Tests the built-in C++ TicTacToe game to verify core MCTS functionality.
+"""
+import pytest
+import time
+
+
+class TestCppTicTacToeBasic:
+    """Test C++ TicTacToe basic functionality without MCTS agents."""
+    
+    def test_tictactoe_state_creation(self, tictactoe_state):
+        """Test that C++ TicTacToe state can be created."""
+        assert tictactoe_state is not None
+        assert not tictactoe_state.is_terminal()
+        assert tictactoe_state.is_self_side_turn()
+        
+    def test_tictactoe_moves(self, tictactoe_state):
+        """Test C++ TicTacToe move generation."""
+        moves = tictactoe_state.actions_to_try()
+        assert len(moves) == 9  # TicTacToe has 9 positions
+        
+        # All moves should be valid
+        for move in moves:
+            assert move is not None
+            assert hasattr(move, 'sprint')
+            move_str = move.sprint()
+            assert isinstance(move_str, str)
+            assert len(move_str) > 0
+            
+    def test_tictactoe_state_transitions(self, tictactoe_state):
+        """Test C++ TicTacToe state transitions."""
+        moves = tictactoe_state.actions_to_try()
+        assert len(moves) > 0
+        
+        # Make a move
+        new_state = tictactoe_state.next_state(moves[0])
+        assert new_state is not None
+        assert not new_state.is_self_side_turn()  # Should switch players
+        
+        # Should have one fewer move available
+        new_moves = new_state.actions_to_try()
+        assert len(new_moves) == len(moves) - 1
+        
+    def test_tictactoe_rollout(self, tictactoe_state):
+        """Test C++ TicTacToe rollout functionality."""
+        for _ in range(5):  # Test multiple times
+            rollout_result = tictactoe_state.rollout()
+            assert isinstance(rollout_result, (int, float))
+            assert 0.0 <= rollout_result <= 1.0
+
+    def test_tictactoe_batched_rollout(self, tictactoe_state):
+        """Test that rollout_n() sums count games and matches the mean of single rollouts."""
+        count = 20000
+        total = tictactoe_state.rollout_n(count)
+        assert 0.0 <= total <= count
+        assert (2 * total) == int(2 * total)  # every game scores 0, 0.5 or 1
+        single = sum(tictactoe_state.rollout() for _ in range(count)) / count
+        assert abs(total / count - single) < 0.03
+        assert tictactoe_state.rollout_n(0) == 0.0
+
+    def test_tictactoe_terminal_detection(self, tictactoe_state):
+        """Test C++ TicTacToe terminal state detection."""
+        # Initial state should not be terminal
+        assert not tictactoe_state.is_terminal()
+        
+        # Play a complete game to test terminal detection
+        current_state = tictactoe_state
+        moves_made = 0
+        
+        while not current_state.is_terminal() and moves_made < 9:
+            moves = current_state.actions_to_try()
+            if not moves:
+                break
+            current_state = current_state.next_state(moves[0])
+            moves_made += 1
+        
+        # Should eventually reach terminal state or fill the board
+        # Note: TicTacToe might still have moves available in terminal states
+        # if it only detects wins, not draws
+        if current_state.is_terminal():
+            # Terminal state detected - this is correct behavior
+            assert True
+        else:
+            # If not terminal but we filled the board, that's also valid
+            assert moves_made == 9
+
+    @pytest.mark.parametrize("line", [
+        [(0, 0), (0, 1), (0, 2)], [(1, 0), (1, 1), (1, 2)], [(2, 0), (2, 1), (2, 2)],
+        [(0, 0), (1, 0), (2, 0)], [(0, 1), (1, 1), (2, 1)], [(0, 2), (1, 2), (2, 2)],
+        [(0, 0), (1, 1), (2, 2)], [(0, 2), (1, 1), (2, 0)],
+    ])
+    def test_tictactoe_win_detection(self, pymcts_module, line):
+        """Test that every row, column and diagonal is detected as a win."""
+        state = pymcts_module.TicTacToe_state()
+        o_squares = [(r, c) for r in range(3) for c in range(3) if (r, c) not in line]
+        for i, (x, y) in enumerate(line):
+            state = state.next_state(pymcts_module.TicTacToe_move(x, y, 'x'))
+            assert state.get_winner() == (' ' if i < 2 else 'x')
+            if i < 2:
+                # o plays off the line (two o's can never complete a line of their own)
+                ox, oy = o_squares[i]
+                state = state.next_state(pymcts_module.TicTacToe_move(ox, oy, 'o'))
+        assert state.is_terminal()
+        assert state.rollout() == 1.0
+        assert len(state.actions_to_try()) == 4
+
+    def test_tictactoe_perfect_play_oracle(self, pymcts_module):
+        """Test the exact minimax values and optimal move checks."""
+        state = pymcts_module.TicTacToe_state()
+        assert state.exact_value() == 0.5
+        assert all(state.is_optimal_move(move) for move in state.actions_to_try())
+
+        state = state.next_state(pymcts_module.TicTacToe_move(1, 1, 'x'))
+        # against a center opening only the corners hold the draw
+        edge = pymcts_module.TicTacToe_move(0, 1, 'o')
+        corner = pymcts_module.TicTacToe_move(0, 0, 'o')
+        assert not state.is_optimal_move(edge)
+        assert state.is_optimal_move(corner)
+        assert state.next_state(edge).exact_value() == 1.0
+        assert state.next_state(corner).exact_value() == 0.5
+
+
+# Working MCTS agent tests - issue was incorrect constructor syntax
+
+class TestCppTicTacToeWithMCTS:
+    """Test C++ TicTacToe with MCTS agent."""
+    
+    def test_tictactoe_with_mcts_agent(self, mcts_agent_factory):
+        """Test C++ TicTacToe with MCTS agent."""
+        import pymcts
+        tictactoe_state = pymcts.TicTacToe_state()
+        
+        # Create MCTS agent with factory for proper cleanup
+        agent = mcts_agent_factory(tictactoe_state, 100, 2)  # 100 iterations, 2 seconds max
+        
+        # Should be able to generate a move
+        move = agent.genmove(None)
+        assert move is not None
+        assert hasattr(move, 'sprint')
+        
+        move_str = move.sprint()
+        assert isinstance(move_str, str)
+        assert len(move_str) > 0
+        
+        print(f"MCTS generated move: {move_str}")
+        
+        # Note: agent will be cleaned up by fixture
+        
+    def test_tictactoe_full_game_with_mcts(self, pymcts_module):
+        """Test a complete TicTacToe game with MCTS."""
+        initial_state = pymcts_module.TicTacToe_state()
+        agent = pymcts_module.MCTS_agent(initial_state, 50, 1)  # Quick game for testing
+        
+        moves_played = 0
+        max_moves = 9  # TicTacToe has maximum 9 moves
+        
+        while not agent.get_current_state().is_terminal() and moves_played < max_moves:
+            current_state = agent.get_current_state()
+            print(f"Move {moves_played + 1}:")
+            current_state.print()
+            
+            if current_state.is_self_side_turn():
+                # MCTS agent's turn
+                agent_move = agent.genmove(None)
+                assert agent_move is not None
+                print(f"MCTS chose: {agent_move.sprint()}")
+            else:
+                # Simulate opponent - take first available move
+                possible_moves = current_state.actions_to_try()
+                if possible_moves:
+                    opponent_move = possible_moves[0]
+                    agent.genmove(opponent_move)
+                    print(f"Opponent chose: {opponent_move.sprint()}")
+                else:
+                    break
+            
+            moves_played += 1
+        
+        # Game should have progressed
+        assert moves_played > 0
+        
+        final_state = agent.get_current_state()
+        print("Final state:")
+        final_state.print()
+        
+        if final_state.is_terminal():
+            print("Game finished!")
+        else:
+            print(f"Game ended early after {moves_played} moves")
+            
+    def test_mcts_agent_performance(self, pymcts_module):
+        """Test MCTS agent performance characteristics."""
+        state = pymcts_module.TicTacToe_state()
+        
+        # Test with different iteration counts
+        for iterations in [10, 50, 100]:
+            agent = pymcts_module.MCTS_agent(state, iterations, 1)
+            
+            start_time = time.time()
+            move = agent.genmove(None)
+            elapsed = time.time() - start_time
+            
+            assert move is not None
+            assert elapsed < 2.0  # Should be reasonably fast
+            
+            print(f"Iterations: {iterations}, Time: {elapsed:.3f}s, Move: {move.sprint()}")
+            
+    def test_tree_root_stats(self, pymcts_module):
+        """Test the root statistics of a tree as NumPy arrays."""
+        np = pytest.importorskip("numpy")
+        tree = pymcts_module.MCTS_tree(pymcts_module.TicTacToe_state())
+        assert tree.root_stats()["visits"].shape == (0,)
+        tree.grow_tree(200, 5)
+        stats = tree.root_stats()
+        n = len(stats["visits"])
+        assert 0 < n <= 3                # symmetric openings are merged: center, corner and edge
+        assert stats["q"].dtype == np.float64 and stats["q"].shape == (n,)
+        assert np.all(stats["prior"] == 1.0)
+        assert stats["moves"].shape == (n, 3)             # TicTacToe_move.to_numpy(): [x, y, player]
+        assert stats["visits"].sum() <= 200 * pymcts_module.get_rollout_threads()
+
+    def test_tree_advances_into_merged_child(self, pymcts_module, capfd):
+        """Test that a tree keeps one child per symmetry class and advances into it for the symmetric moves."""
+        pytest.importorskip("numpy")
+        tree = pymcts_module.MCTS_tree(pymcts_module.TicTacToe_state())
+        tree.grow_tree(300, 5)
+        assert len(tree.root_stats()["visits"]) == 3        # all 9 openings tried: center, one corner, one edge
+        corner = pymcts_module.TicTacToe_move(2, 2, 'x')    # the kept corner is (0, 0), the first one tried
+        real = pymcts_module.TicTacToe_state().next_state(corner)
+        capfd.readouterr()
+        tree.advance_tree(corner)
+        assert "start over" not in capfd.readouterr().out
+        assert tree.get_size() > 1                          # the corner's subtree was kept
+        assert str(tree.get_current_state()) == str(real)
+
+    def test_agent_follows_moves_into_merged_siblings(self, pymcts_module, capfd):
+        """Test that enemy moves whose children were merged into a symmetric sibling keep the agent in the real game."""
+        transforms = [lambda x, y: (x, y), lambda x, y: (y, 2 - x), lambda x, y: (2 - x, 2 - y),
+                      lambda x, y: (2 - y, x), lambda x, y: (x, 2 - y), lambda x, y: (2 - x, y),
+                      lambda x, y: (y, x), lambda x, y: (2 - y, 2 - x)]
+        real = pymcts_module.TicTacToe_state()
+        board = {}                                      # (x, y) -> player, the real game
+        agent = pymcts_module.MCTS_agent(pymcts_module.TicTacToe_state(), 300, 5)
+        capfd.readouterr()
+        merged = 0
+        while not real.is_terminal():
+            move = agent.genmove(None) if not board else agent.genmove(enemy)
+            if move is None:
+                break
+            assert move.player == 'x' and (move.x, move.y) not in board      # legal in the real board's frame
+            board[(move.x, move.y)] = 'x'
+            real = real.next_state(move)
+            assert str(agent.get_current_state()) == str(real)
+            if real.is_terminal():
+                break
+            # the enemy plays the last of the squares that a symmetry of the board maps onto each other: the tree
+            # only expanded the first of them (in actions_to_try() order), the others were merged into it
+            keep = [t for t in transforms if all(board.get(t(x, y)) == p for (x, y), p in board.items())]
+            moves = real.actions_to_try()
+            siblings = [m for m in moves if any(t(m.x, m.y) == (moves[0].x, moves[0].y) for t in keep[1:])]
+            enemy = siblings[-1] if siblings else moves[-1]
+            merged += bool(siblings)
+            board[(enemy.x, enemy.y)] = 'o'
+            real = real.next_state(enemy)
+            if real.is_terminal():
+                agent.genmove(enemy)
+                assert str(agent.get_current_state()) == str(real)
+        assert merged > 0
+        assert "start over" not in capfd.readouterr().out
+
+    def test_mcts_agent_statistics(self, pymcts_module):
+        """Test MCTS agent statistics and feedback."""
+        state = pymcts_module.TicTacToe_state()
+        agent = pymcts_module.MCTS_agent(state, 100, 1)
+        
+        # Generate a move to populate statistics
+        move = agent.genmove(None)
+        assert move is not None
+        
+        # Test that feedback works (this method should exist and not crash)
+        try:
+            agent.feedback()
+            print("Agent feedback displayed successfully")
+        except AttributeError:
+            # If feedback method doesn't exist, that's OK
+            print("Agent feedback method not available")
+        
+        # Test getting current state
+        current_state = agent.get_current_state()
+        assert current_state is not None
         assert isinstance(current_state, pymcts_module.TicTacToe_state)
\ No newline at end of file
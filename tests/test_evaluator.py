@@ -0,0 +1,84 @@
+"""
+Tests for batched leaf evaluation (pymcts.set_evaluator).
+The evaluator replaces rollouts and get_action_probabilities() with one Python call per leaf batch.
+"""
+import os
+import sys
+import pytest
+
+sys.path.append(os.path.join(os.path.dirname(__file__), '..', 'demo'))
+from take_away import PileState
+
+
+class NoPriorsPileState(PileState):
+    """Take-away game that fails if it is asked for priors: those must come from the evaluator."""
+
+    def get_action_probabilities(self):
+        raise AssertionError("priors must come from the evaluator")
+
+
+@pytest.fixture
+def evaluator_config(pymcts_module):
+    """Restores the rollouts and the leaf batch size after a test that sets an evaluator."""
+    original = pymcts_module.get_leaf_batch_size()
+    yield
+    pymcts_module.set_evaluator(None)
+    pymcts_module.set_leaf_batch_size(original)
+
+
+class TestEvaluator:
+    """Test the numpy and states encodings of set_evaluator()."""
+
+    def test_numpy_batches(self, pymcts_module, evaluator_config):
+        """Test that TicTacToe leaves reach the evaluator as stacked to_numpy() rows with indexed priors."""
+        np = pytest.importorskip("numpy")
+        batches = []
+
+        def evaluate(batch):
+            batches.append(batch.shape)
+            priors = np.full((len(batch), 9), 0.1)
+            priors[:, 4] = 0.9                      # the center
+            return priors, np.full(len(batch), 0.5)
+
+        pymcts_module.set_evaluator(evaluate, batch_size=8)
+        assert pymcts_module.has_evaluator()
+        tree = pymcts_module.MCTS_tree(pymcts_module.TicTacToe_state())
+        tree.grow_tree(200, 10)
+        assert all(len(shape) == 2 and shape[1] == 9 and 1 <= shape[0] <= 8 for shape in batches)
+        assert len(batches) < 200
+        stats = tree.root_stats()
+        assert 0.9 in stats["prior"]
+        # the center was expanded first
+        assert stats["moves"][0, 0] == stats["moves"][0, 1] == 1
+
+    def test_states_encoding(self, pymcts_module, evaluator_config):
+        """Test that Python states are passed as themselves and their priors follow actions_to_try()."""
+        sizes = []
+
+        def evaluate(states):
+            sizes.append(len(states))
+            assert all(isinstance(state, NoPriorsPileState) for state in states)
+            priors = [[1.0 if move.take == 1 else 0.5 for move in state.actions_to_try()] for state in states]
+            return priors, [state.value() for state in states]
+
+        pymcts_module.set_evaluator(evaluate, encoding="states", batch_size=4)
+        agent = pymcts_module.MCTS_agent(pymcts_module.SerializedPythonState(NoPriorsPileState(10)), 200, 10)
+        move = agent.genmove(None)
+        assert move.sprint() == "Take1"             # 10 % 3 == 1: taking one leaves the opponent lost
+        assert sum(sizes) > 0 and max(sizes) <= 4
+
+    def test_failing_evaluator_falls_back_to_rollouts(self, pymcts_module, evaluator_config):
+        """Test that searches still work when the evaluator raises."""
+        def evaluate(batch):
+            raise RuntimeError("no network")
+
+        pymcts_module.set_evaluator(evaluate, batch_size=4)
+        agent = pymcts_module.MCTS_agent(pymcts_module.TicTacToe_state(), 100, 5)
+        assert agent.genmove(None) is not None
+
+    def test_invalid_encoding(self, pymcts_module):
+        """Test that unknown encodings are rejected and clearing the evaluator restores rollouts."""
+        with pytest.raises(ValueError):
+            pymcts_module.set_evaluator(lambda batch: None, encoding="pickle")
+        pymcts_module.set_evaluator(None)
+        assert not pymcts_module.has_evaluator()
@@ -0,0 +1,89 @@
+"""
+Tests for native games loaded as shared libraries (pymcts.load_game).
+Uses the Quoridor plugin built by `make QuoridorPlugin`.
+"""
+import os
+import subprocess
+import pytest
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+QUORIDOR_PLUGIN = os.path.join(ROOT, "quoridor_plugin.so")
+
+
+@pytest.fixture(scope="module")
+def quoridor(pymcts_module):
+    """The Quoridor plugin, built on demand."""
+    if not os.path.exists(QUORIDOR_PLUGIN):
+        try:
+            subprocess.run(["make", "QuoridorPlugin"], cwd=ROOT, check=True, capture_output=True)
+        except (OSError, subprocess.CalledProcessError) as e:
+            pytest.skip(f"could not build the Quoridor plugin: {e}")
+    return pymcts_module.load_game(QUORIDOR_PLUGIN)
+
+
+class TestGamePlugins:
+    """Test loading plugins and searching their states."""
+
+    def test_load_quoridor(self, quoridor):
+        """Test the plugin's metadata and the states of its board variants."""
+        assert quoridor.name == "Quoridor"
+        assert "11" in quoridor.description
+        state = quoridor.new_state("5")
+        assert not state.is_terminal()
+        moves = state.actions_to_try()
+        assert len(moves) > 0
+        assert state.next_state(moves[0]) is not None
+        # the standard board offers more moves (walls) than the reduced one
+        assert len(quoridor.new_state().actions_to_try()) > len(moves)
+
+    def test_agent_searches_plugin_state(self, pymcts_module, quoridor):
+        """Test that the engine searches plugin states like built-in ones."""
+        agent = pymcts_module.MCTS_agent(quoridor.new_state("5"), 300, 5)
+        move = agent.genmove(None)
+        assert move is not None
+        assert len(move.sprint()) > 0
+        enemy = agent.get_current_state().actions_to_try()[0]
+        assert agent.genmove(enemy) is not None
+
+    @pytest.mark.parametrize("size,walls", [("5", 3), ("7", 6), ("9", 10), ("11", 14)])
+    def test_short_game_on_each_variant(self, pymcts_module, quoridor, size, walls):
+        """Test a short game on each board: both sides place all their walls, then walk to their goal rows."""
+        state = quoridor.new_state(size)
+        agent = pymcts_module.MCTS_agent(quoridor.new_state(size), 20, 5)
+        move = agent.genmove(None)
+        assert move.sprint() in [m.sprint() for m in state.actions_to_try()]
+        placed = plies = 0
+        while not state.is_terminal():
+            moves = state.actions_to_try()
+            assert len(moves) > 0 and plies < 200
+            move = moves[-1]                # walls come after the pawn steps
+            placed += move.to_numpy()[3] != 0
+            state = state.next_state(move)
+            plies += 1
+        assert placed == 2 * walls
+
+    @pytest.mark.parametrize("size", ["5", "7", "9", "11"])
+    def test_states_are_independent_copies(self, quoridor, size, capfd):
+        """Test that clones and next states copy the packed walls and pawns instead of sharing them."""
+        def shown(state):
+            capfd.readouterr()
+            state.print()
+            return capfd.readouterr().out
+
+        state = quoridor.new_state(size)
+        while not state.is_terminal():
+            board = shown(state)
+            assert shown(state.clone()) == board
+            child = state.next_state(state.actions_to_try()[-1])
+            assert shown(state) == board
+            assert shown(child) != board
+            state = child
+
+    def test_invalid_plugins_and_options(self, pymcts_module, quoridor):
+        """Test that missing files, libraries without a game and unknown options are rejected."""
+        with pytest.raises(ImportError):
+            pymcts_module.load_game(os.path.join(ROOT, "no_such_plugin.so"))
+        with pytest.raises(ImportError, match="not a game plugin"):
+            pymcts_module.load_game(pymcts_module.__file__)
+        with pytest.raises(ValueError):
+            quoridor.new_state("4")
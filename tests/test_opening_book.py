@@ -0,0 +1,81 @@
+"""
+Tests for opening books (pymcts.build_opening_book, pymcts.OpeningBook, MCTS_agent.set_opening_book).
+"""
+import pytest
+
+
+def save_search(pymcts_module, path, iterations=1000):
+    """Search the Connect Four opening and save the tree, returning its root statistics."""
+    tree = pymcts_module.MCTS_tree(pymcts_module.ConnectFour_state())
+    tree.grow_tree(iterations, 10)
+    tree.save(path)
+    return tree.root_stats()
+
+
+class TestOpeningBook:
+    """Test building books from saved trees and agents playing with them."""
+
+    def test_build_and_lookup(self, pymcts_module, tmp_path):
+        """Test that the roots of several trees are merged into the starting position."""
+        pytest.importorskip("numpy")
+        trees = [tmp_path / f"c4_{i}.tree" for i in range(2)]
+        visits = sum(int(save_search(pymcts_module, path)["visits"].sum()) for path in trees)
+        path = tmp_path / "c4.book"
+        positions = pymcts_module.build_opening_book(path, trees, pymcts_module.ConnectFour_state(), max_depth=2)
+        book = pymcts_module.OpeningBook(path)
+        assert len(book) == positions > 1
+        start = pymcts_module.ConnectFour_state()
+        assert start in book
+        assert book.visits(start) == visits
+
+    def test_books_accumulate(self, pymcts_module, tmp_path):
+        """Test that building into an existing book adds to it unless merge=False."""
+        pytest.importorskip("numpy")
+        tree = tmp_path / "c4.tree"
+        save_search(pymcts_module, tree, 300)
+        path = tmp_path / "c4.book"
+        start = pymcts_module.ConnectFour_state()
+        pymcts_module.build_opening_book(path, [tree], start, max_depth=0)
+        once = pymcts_module.OpeningBook(path).visits(start)
+        pymcts_module.build_opening_book(path, [tree], start, max_depth=0)
+        assert pymcts_module.OpeningBook(path).visits(start) == 2 * once
+        pymcts_module.build_opening_book(path, [tree], start, max_depth=0, merge=False)
+        assert pymcts_module.OpeningBook(path).visits(start) == once
+
+    def test_agent_plays_from_book(self, pymcts_module, tmp_path):
+        """Test that a known position is played with the book's most visited move and seeds the root."""
+        np = pytest.importorskip("numpy")
+        tree = tmp_path / "c4.tree"
+        stats = save_search(pymcts_module, tree)
+        path = tmp_path / "c4.book"
+        pymcts_module.build_opening_book(path, [tree], pymcts_module.ConnectFour_state(), max_depth=0)
+        agent = pymcts_module.MCTS_agent(pymcts_module.ConnectFour_state(), 1, 1)
+        agent.set_opening_book(pymcts_module.OpeningBook(path), seed_visits=100, play_visits=1)
+        move = agent.genmove(None)
+        assert move.column == stats["moves"][np.argmax(stats["visits"]), 0]
+        seeded = agent.last_search_stats()["visits"]
+        assert len(seeded) == len(stats["visits"])
+        assert abs(int(seeded.sum()) - 100) <= len(seeded)   # scaled down to 100, rounded per move
+
+    def test_agent_searches_on_top_of_book(self, pymcts_module, tmp_path):
+        """Test that seeded visits add to the agent's own search."""
+        pytest.importorskip("numpy")
+        tree = tmp_path / "c4.tree"
+        save_search(pymcts_module, tree)
+        path = tmp_path / "c4.book"
+        pymcts_module.build_opening_book(path, [tree], pymcts_module.ConnectFour_state(), max_depth=0)
+        agent = pymcts_module.MCTS_agent(pymcts_module.ConnectFour_state(), 200, 10)
+        agent.set_opening_book(pymcts_module.OpeningBook(path), seed_visits=1000)
+        assert agent.genmove(None) is not None
+        assert agent.last_search_stats()["visits"].sum() > 1000
+        agent.set_opening_book(None)
+        assert agent.genmove(None) is not None
+
+    def test_invalid_books(self, pymcts_module, tmp_path):
+        """Test that missing and foreign files are rejected."""
+        with pytest.raises(RuntimeError, match="Could not open"):
+            pymcts_module.OpeningBook(tmp_path / "missing.book")
+        path = tmp_path / "other.book"
+        path.write_bytes(b"not a book")
+        with pytest.raises(RuntimeError, match="not a book file"):
+            pymcts_module.OpeningBook(path)
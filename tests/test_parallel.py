@@ -1,169 +1,319 @@
-"""
-Parallel rollout tests for PyMCTS.
-Tests multi-threading functionality and performance characteristics.
-NOTE: MCTS agent tests disabled due to C++ memory corruption issue.
-"""
-import pytest
-import time
-
-
-class TestParallelConfiguration:
-    """Test parallel rollout configuration."""
-    
-    def test_thread_setting(self, pymcts_module, thread_configs):
-        """Test setting different thread counts."""
-        for threads in thread_configs:
-            pymcts_module.set_rollout_threads(threads)
-            assert pymcts_module.get_rollout_threads() == threads
-            
-    def test_hardware_limits(self, pymcts_module):
-        """Test that thread configuration respects hardware limits."""
-        max_threads = pymcts_module.get_hardware_concurrency()
-        
-        # Setting threads within hardware limits should work
-        pymcts_module.set_rollout_threads(max_threads)
-        assert pymcts_module.get_rollout_threads() == max_threads
-        
-        # Setting threads beyond hardware limits should be clamped or work
-        pymcts_module.set_rollout_threads(max_threads * 2)
-        # Should either be clamped to max_threads or work with the higher value
-        assert pymcts_module.get_rollout_threads() > 0
-
-
-class TestParallelBasicFunctionality:
-    """Test basic parallel functionality without MCTS agents."""
-    
-    def test_thread_configuration_functions(self, pymcts_module):
-        """Test that thread configuration functions work."""
-        # Test hardware detection
-        hardware_threads = pymcts_module.get_hardware_concurrency()
-        assert hardware_threads > 0
-        assert hardware_threads <= 64  # Reasonable upper bound
-        
-        # Test optimal thread count
-        optimal_threads = pymcts_module.get_optimal_thread_count()
-        assert optimal_threads > 0
-        assert optimal_threads <= hardware_threads
-        
-        # Test thread setting and getting
-        for threads in [1, 2, 4]:
-            pymcts_module.set_rollout_threads(threads)
-            assert pymcts_module.get_rollout_threads() == threads
-    
-    def test_basic_state_operations_with_threads(self, pymcts_module):
-        """Test basic state operations work with different thread settings."""
-        # Create a TicTacToe state for testing
-        tictactoe_state = pymcts_module.TicTacToe_state()
-        
-        for threads in [1, 2, 4]:
-            pymcts_module.set_rollout_threads(threads)
-            
-            # Test that basic operations still work
-            assert not tictactoe_state.is_terminal()
-            assert tictactoe_state.is_self_side_turn()
-            
-            moves = tictactoe_state.actions_to_try()
-            assert len(moves) > 0
-            
-            # Test state transitions
-            if moves:
-                new_state = tictactoe_state.next_state(moves[0])
-                assert new_state is not None
-                assert not new_state.is_self_side_turn()  # Should switch players
-
-
-# Working MCTS agent tests - issue was incorrect constructor syntax
-
-class TestParallelPerformance:
-    """Test parallel rollout performance characteristics."""
-    
-    def test_single_vs_multi_thread_basic(self, pymcts_module):
-        """Basic test comparing single vs multi-threaded performance."""
-        iterations = 50  # Reduced iterations
-        time_limit = 1   # Reduced time limit
-        
-        # Test single thread - use scope to ensure cleanup
-        pymcts_module.set_rollout_threads(1)
-        state1 = pymcts_module.TicTacToe_state()
-        agent1 = pymcts_module.MCTS_agent(state1, iterations, time_limit)
-        
-        start_time = time.time()
-        move1 = agent1.genmove(None)
-        single_thread_time = time.time() - start_time
-        
-        # Clear reference to agent1
-        del agent1
-        del state1
-        
-        # Test multiple threads - use scope to ensure cleanup
-        optimal_threads = min(2, pymcts_module.get_hardware_concurrency())  # Limit to 2 threads
-        pymcts_module.set_rollout_threads(optimal_threads)
-        state2 = pymcts_module.TicTacToe_state()
-        agent2 = pymcts_module.MCTS_agent(state2, iterations, time_limit)
-        
-        start_time = time.time()
-        move2 = agent2.genmove(None)
-        multi_thread_time = time.time() - start_time
-        
-        # Clear reference to agent2
-        del agent2
-        del state2
-        
-        # Both should generate valid moves
-        assert move1 is not None
-        assert move2 is not None
-        
-        # Both should complete in reasonable time
-        assert single_thread_time < 5.0
-        assert multi_thread_time < 5.0
-        
-        print(f"Single thread: {single_thread_time:.3f}s, Multi thread: {multi_thread_time:.3f}s")
-
-
-class TestThreadSafety:
-    """Test thread safety of MCTS operations."""
-    
-    def test_thread_count_changes(self, pymcts_module):
-        """Test changing thread count during operation."""
-        # Start with single thread
-        pymcts_module.set_rollout_threads(1)
-        state = pymcts_module.TicTacToe_state()
-        agent = pymcts_module.MCTS_agent(state, 10, 1)  # Very short test
-        move1 = agent.genmove(None)
-        
-        # Change to multiple threads (but don't create new agents)
-        pymcts_module.set_rollout_threads(2)
-        
-        # Just verify the thread count changed
-        assert pymcts_module.get_rollout_threads() == 2
-        assert move1 is not None
-        
-        # Clean up
-        del agent
-        del state
-        
-        print("Thread count change test completed successfully")
-
-
-class TestParallelStressTest:
-    """Stress test parallel rollout system."""
-    
-    def test_basic_parallel_functionality(self, pymcts_module):
-        """Test basic parallel functionality works."""
-        pymcts_module.set_rollout_threads(2)
-        
-        state = pymcts_module.TicTacToe_state()
-        agent = pymcts_module.MCTS_agent(state, 20, 1)  # Small test
-        
-        start_time = time.time()
-        move = agent.genmove(None)
-        elapsed = time.time() - start_time
-        
-        assert move is not None
-        assert elapsed < 3.0  # Should complete quickly
-        
-        # Clean up
-        del agent
-        del state
-        
-        print(f"Basic parallel test completed in {elapsed:.3f}s")
\ No newline at end of file
+"""
+Parallel rollout tests for PyMCTS.
+Tests multi-threading functionality and performance characteristics.
+NOTE: MCTS agent tests disabled due to C++ memory corruption issue.
+"""
+import pytest
+import os
+import sys
+import threading
+import time
+
+sys.path.append(os.path.join(os.path.dirname(__file__), '..', 'demo'))
+
+
+class TestParallelConfiguration:
+    """Test parallel rollout configuration."""
+    
+    def test_thread_setting(self, pymcts_module, thread_configs):
+        """Test setting different thread counts."""
+        for threads in thread_configs:
+            pymcts_module.set_rollout_threads(threads)
+            assert pymcts_module.get_rollout_threads() == threads
+            
+    def test_hardware_limits(self, pymcts_module):
+        """Test that thread configuration respects hardware limits."""
+        max_threads = pymcts_module.get_hardware_concurrency()
+        
+        # Setting threads within hardware limits should work
+        pymcts_module.set_rollout_threads(max_threads)
+        assert pymcts_module.get_rollout_threads() == max_threads
+        
+        # Setting threads beyond hardware limits should be clamped or work
+        pymcts_module.set_rollout_threads(max_threads * 2)
+        # Should either be clamped to max_threads or work with the higher value
+        assert pymcts_module.get_rollout_threads() > 0
+
+
+class TestParallelBasicFunctionality:
+    """Test basic parallel functionality without MCTS agents."""
+    
+    def test_thread_configuration_functions(self, pymcts_module):
+        """Test that thread configuration functions work."""
+        # Test hardware detection
+        hardware_threads = pymcts_module.get_hardware_concurrency()
+        assert hardware_threads > 0
+        assert hardware_threads <= 64  # Reasonable upper bound
+        
+        # Test optimal thread count
+        optimal_threads = pymcts_module.get_optimal_thread_count()
+        assert optimal_threads > 0
+        assert optimal_threads <= hardware_threads
+        
+        # Test thread setting and getting
+        for threads in [1, 2, 4]:
+            pymcts_module.set_rollout_threads(threads)
+            assert pymcts_module.get_rollout_threads() == threads
+    
+    def test_basic_state_operations_with_threads(self, pymcts_module):
+        """Test basic state operations work with different thread settings."""
+        # Create a TicTacToe state for testing
+        tictactoe_state = pymcts_module.TicTacToe_state()
+        
+        for threads in [1, 2, 4]:
+            pymcts_module.set_rollout_threads(threads)
+            
+            # Test that basic operations still work
+            assert not tictactoe_state.is_terminal()
+            assert tictactoe_state.is_self_side_turn()
+            
+            moves = tictactoe_state.actions_to_try()
+            assert len(moves) > 0
+            
+            # Test state transitions
+            if moves:
+                new_state = tictactoe_state.next_state(moves[0])
+                assert new_state is not None
+                assert not new_state.is_self_side_turn()  # Should switch players
+
+
+# Working MCTS agent tests - issue was incorrect constructor syntax
+
+class TestParallelPerformance:
+    """Test parallel rollout performance characteristics."""
+    
+    def test_single_vs_multi_thread_basic(self, pymcts_module):
+        """Basic test comparing single vs multi-threaded performance."""
+        iterations = 50  # Reduced iterations
+        time_limit = 1   # Reduced time limit
+        
+        # Test single thread - use scope to ensure cleanup
+        pymcts_module.set_rollout_threads(1)
+        state1 = pymcts_module.TicTacToe_state()
+        agent1 = pymcts_module.MCTS_agent(state1, iterations, time_limit)
+        
+        start_time = time.time()
+        move1 = agent1.genmove(None)
+        single_thread_time = time.time() - start_time
+        
+        # Clear reference to agent1
+        del agent1
+        del state1
+        
+        # Test multiple threads - use scope to ensure cleanup
+        optimal_threads = min(2, pymcts_module.get_hardware_concurrency())  # Limit to 2 threads
+        pymcts_module.set_rollout_threads(optimal_threads)
+        state2 = pymcts_module.TicTacToe_state()
+        agent2 = pymcts_module.MCTS_agent(state2, iterations, time_limit)
+        
+        start_time = time.time()
+        move2 = agent2.genmove(None)
+        multi_thread_time = time.time() - start_time
+        
+        # Clear reference to agent2
+        del agent2
+        del state2
+        
+        # Both should generate valid moves
+        assert move1 is not None
+        assert move2 is not None
+        
+        # Both should complete in reasonable time
+        assert single_thread_time < 5.0
+        assert multi_thread_time < 5.0
+        
+        print(f"Single thread: {single_thread_time:.3f}s, Multi thread: {multi_thread_time:.3f}s")
+
+
+    @pytest.mark.slow
+    def test_parallel_rollouts_speed_up_native_games(self, pymcts_module):
+        """Test that rollout threads increase the simulations per second on a C++ game."""
+        threads = min(4, pymcts_module.get_optimal_thread_count())
+        if threads < 2:
+            pytest.skip("needs at least 2 hardware threads")
+        iterations = 300
+
+        def simulations_per_second(limit):
+            pymcts_module.set_rollout_thread_limit(limit)
+            tree = pymcts_module.MCTS_tree(pymcts_module.Gomoku_state())
+            start_time = time.perf_counter()
+            tree.grow_tree(iterations, 60)
+            return threads * iterations / (time.perf_counter() - start_time)
+
+        # the same rollouts per leaf every time: only the number of threads running them changes
+        original = (pymcts_module.get_rollout_threads(), pymcts_module.get_rollout_thread_limit())
+        try:
+            pymcts_module.set_rollout_threads(threads)
+            single = simulations_per_second(1)
+            multi = simulations_per_second(threads)
+        finally:
+            pymcts_module.set_rollout_threads(original[0])
+            pymcts_module.set_rollout_thread_limit(original[1])
+        print(f"Gomoku simulations/s: 1 thread {single:.0f}, {threads} threads {multi:.0f}")
+        assert multi > 1.3 * single
+
+
+class TestThreadSafety:
+    """Test thread safety of MCTS operations."""
+    
+    def test_thread_count_changes(self, pymcts_module):
+        """Test changing thread count during operation."""
+        # Start with single thread
+        pymcts_module.set_rollout_threads(1)
+        state = pymcts_module.TicTacToe_state()
+        agent = pymcts_module.MCTS_agent(state, 10, 1)  # Very short test
+        move1 = agent.genmove(None)
+        
+        # Change to multiple threads (but don't create new agents)
+        pymcts_module.set_rollout_threads(2)
+        
+        # Just verify the thread count changed
+        assert pymcts_module.get_rollout_threads() == 2
+        assert move1 is not None
+        
+        # Clean up
+        del agent
+        del state
+        
+        print("Thread count change test completed successfully")
+
+
+class TestParallelStressTest:
+    """Stress test parallel rollout system."""
+    
+    def test_basic_parallel_functionality(self, pymcts_module):
+        """Test basic parallel functionality works."""
+        pymcts_module.set_rollout_threads(2)
+        
+        state = pymcts_module.TicTacToe_state()
+        agent = pymcts_module.MCTS_agent(state, 20, 1)  # Small test
+        
+        start_time = time.time()
+        move = agent.genmove(None)
+        elapsed = time.time() - start_time
+        
+        assert move is not None
+        assert elapsed < 3.0  # Should complete quickly
+        
+        # Clean up
+        del agent
+        del state
+        
+        print(f"Basic parallel test completed in {elapsed:.3f}s")
+
+
+class TestGilRelease:
+    """Test that searches let other Python threads run."""
+
+    def test_native_search_does_not_block_python_threads(self, pymcts_module):
+        """Test that a Python thread keeps running while genmove searches a C++ state."""
+        agent = pymcts_module.MCTS_agent(pymcts_module.TicTacToe_state(), 200000, 2)
+        result = {}
+        search = threading.Thread(target=lambda: result.setdefault("move", agent.genmove(None)))
+        ticks = 0
+        search.start()
+        while search.is_alive():
+            ticks += 1
+            time.sleep(0.001)
+        search.join()
+        assert result["move"] is not None
+        assert ticks > 10   # with the GIL held the loop could not run until the search was over
+
+    def test_python_state_searches_in_parallel_threads(self, pymcts_module):
+        """Test that several agents on Python states can search from different Python threads."""
+        from connect_four_python import ConnectFourState
+        moves = [None] * 3
+
+        def search(i):
+            agent = pymcts_module.MCTS_agent(pymcts_module.SerializedPythonState(ConnectFourState()), 30, 5)
+            moves[i] = str(agent.genmove(None))
+
+        threads = [threading.Thread(target=search, args=(i,)) for i in range(len(moves))]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        assert all(move is not None and 'Drop' in move for move in moves)
+
+    def test_tree_shared_by_two_threads_raises(self, pymcts_module):
+        """Test that calls on a tree another thread is growing raise instead of racing on its nodes."""
+        tree = pymcts_module.MCTS_tree(pymcts_module.Gomoku_state())
+        worker = threading.Thread(target=tree.grow_tree, args=(10 ** 9, 1.0))
+        worker.start()
+        time.sleep(0.2)
+        for call in (lambda: tree.grow_tree(10, 1.0), tree.get_size, tree.select_best_child, tree.root_stats):
+            with pytest.raises(RuntimeError, match="another thread"):
+                call()
+        worker.join()
+        assert tree.get_size() > 0
+
+
+class TestAsyncGenmove:
+    """Test genmove_async() with and without an asyncio event loop."""
+
+    def test_await_keeps_event_loop_running(self, pymcts_module):
+        """Test that awaiting a search lets other coroutines run and gives the same kind of move as genmove."""
+        import asyncio
+        agent = pymcts_module.MCTS_agent(pymcts_module.TicTacToe_state(), 200000, 2)
+
+        async def main():
+            ticks = 0
+            future = agent.genmove_async()
+            while not future.done():
+                ticks += 1
+                await asyncio.sleep(0.001)
+            return await future, ticks
+
+        move, ticks = asyncio.run(main())
+        assert isinstance(move, pymcts_module.TicTacToe_move)
+        assert ticks > 10
+        assert not agent.is_searching()
+        assert agent.get_current_state().get_turn() == 'o'
+
+    def test_stop_returns_best_move_so_far(self, pymcts_module):
+        """Test that stop() ends a long search early and still resolves with a move."""
+        from test_cpp_connectfour import play_columns
+        agent = pymcts_module.MCTS_agent(play_columns(pymcts_module, [0, 6, 0, 6, 0]), 10 ** 9, 60)
+        start = time.time()
+        future = agent.genmove_async()
+        assert agent.is_searching()
+        with pytest.raises(RuntimeError):
+            agent.genmove(None)
+        time.sleep(0.3)
+        agent.stop()
+        move = future.result(timeout=10)      # outside of an event loop: concurrent.futures.Future
+        assert time.time() - start < 10
+        assert move.column == 0
+
+    def test_calls_during_a_search_are_refused(self, pymcts_module):
+        """Test that a genmove() of another thread makes the agent's other calls raise instead of racing on its tree."""
+        agent = pymcts_module.MCTS_agent(pymcts_module.Gomoku_state(), 10 ** 9, 1)
+        worker = threading.Thread(target=agent.genmove)
+        worker.start()
+        time.sleep(0.2)
+        assert agent.is_searching()
+        for call in (agent.genmove, agent.genmove_async, agent.get_current_state, agent.last_search_stats):
+            with pytest.raises(RuntimeError, match="still running"):
+                call()
+        worker.join()
+        assert not agent.is_searching()
+        assert agent.get_current_state().get_number_of_stones() == 1
+
+    def test_cancelling_the_task_stops_the_search(self, pymcts_module):
+        """Test that cancelling the awaiting task frees the agent well before its time limit."""
+        import asyncio
+        agent = pymcts_module.MCTS_agent(pymcts_module.Gomoku_state(), 10 ** 9, 60)
+
+        async def main():
+            task = asyncio.ensure_future(agent.genmove_async())
+            await asyncio.sleep(0.2)
+            task.cancel()
+            with pytest.raises(asyncio.CancelledError):
+                await task
+            while agent.is_searching():
+                await asyncio.sleep(0.01)
+
+        start = time.time()
+        asyncio.run(main())
+        assert time.time() - start < 10
+        assert agent.get_current_state().get_number_of_stones() == 1     # the best move so far was still played
@@ -1,321 +1,527 @@
-"""
-Tests for Python game implementations.
-Tests Python games from the demo folder without using MCTS agents.
-NOTE: MCTS agent tests disabled due to C++ memory corruption issue.
-"""
-import pytest
-import sys
-import os
-
-# Import demo games for testing
-sys.path.append(os.path.join(os.path.dirname(__file__), '..', 'demo'))
-
-try:
-    from connect_four_python import ConnectFourMove, ConnectFourState
-    CONNECT_FOUR_AVAILABLE = True
-except ImportError:
-    CONNECT_FOUR_AVAILABLE = False
-
-try:
-    from simple_python_games import CoinFlipMove, CoinFlipState, GuessMove, NumberGuessingState
-    SIMPLE_GAMES_AVAILABLE = True
-except ImportError:
-    SIMPLE_GAMES_AVAILABLE = False
-
-
-class TestPythonGameBasics:
-    """Test basic functionality of Python games without MCTS."""
-    
-    @pytest.mark.skipif(not CONNECT_FOUR_AVAILABLE, reason="Connect Four not available")
-    def test_connect_four_basic_functionality(self):
-        """Test Connect Four basic functionality."""
-        # Test move creation
-        move = ConnectFourMove(3, 'X')
-        assert move.column == 3
-        assert move.player == 'X'
-        assert '3' in move.sprint()
-        assert 'X' in move.sprint()
-        
-        # Test state creation
-        state = ConnectFourState()
-        assert not state.is_terminal()
-        assert state.is_self_side_turn()
-        
-        # Test move generation
-        moves = state.actions_to_try()
-        assert len(moves) == 7  # 7 columns
-        
-        # Test state transition
-        if moves:
-            new_state = state.next_state(moves[0])
-            assert new_state is not None
-            assert not new_state.is_self_side_turn()  # Should switch players
-            
-        # Test rollout
-        rollout_result = state.rollout()
-        assert 0.0 <= rollout_result <= 1.0
-        
-    @pytest.mark.skipif(not SIMPLE_GAMES_AVAILABLE, reason="Simple games not available")
-    def test_coin_flip_game(self):
-        """Test coin flip game functionality."""
-        # Test move
-        move = CoinFlipMove('heads')
-        assert move.choice == 'heads'
-        assert 'heads' in move.sprint().lower()
-        
-        # Test state
-        state = CoinFlipState()
-        assert not state.is_terminal()
-        assert state.is_self_side_turn()
-        
-        moves = state.actions_to_try()
-        assert len(moves) == 2  # heads or tails
-        
-        # Test state transition
-        if moves:
-            new_state = state.next_state(moves[0])
-            assert not new_state.is_terminal()  # Game continues (3 guesses total)
-            assert new_state.guesses_left == 2  # Started with 3, now has 2
-            
-    @pytest.mark.skipif(not SIMPLE_GAMES_AVAILABLE, reason="Simple games not available")
-    def test_number_game(self):
-        """Test number guessing game functionality."""
-        # Test move
-        move = GuessMove(5)
-        assert move.number == 5
-        assert '5' in move.sprint()
-        
-        # Test state
-        state = NumberGuessingState()
-        assert not state.is_terminal()
-        assert state.is_self_side_turn()
-        
-        moves = state.actions_to_try()
-        assert len(moves) > 0  # Should have some number choices
-        
-        # Test rollout
-        rollout_result = state.rollout()
-        assert 0.0 <= rollout_result <= 1.0
-
-
-class TestPythonGameInheritance:
-    """Test that Python games properly inherit from C++ base classes."""
-    
-    @pytest.mark.skipif(not CONNECT_FOUR_AVAILABLE, reason="Connect Four not available")
-    def test_connect_four_inheritance(self, pymcts_module):
-        """Test Connect Four inheritance from C++ classes."""
-        move = ConnectFourMove(3, 'X')
-        state = ConnectFourState()
-        
-        assert isinstance(move, pymcts_module.MCTS_move)
-        assert isinstance(state, pymcts_module.MCTS_state)
-        
-        # Test required methods exist
-        required_move_methods = ['__eq__', 'sprint']
-        for method in required_move_methods:
-            assert hasattr(move, method)
-            assert callable(getattr(move, method))
-            
-        required_state_methods = ['actions_to_try', 'next_state', 'rollout', 'is_terminal', 'is_self_side_turn']
-        for method in required_state_methods:
-            assert hasattr(state, method)
-            assert callable(getattr(state, method))
-            
-    @pytest.mark.skipif(not SIMPLE_GAMES_AVAILABLE, reason="Simple games not available")
-    def test_simple_games_inheritance(self, pymcts_module):
-        """Test simple games inheritance from C++ classes."""
-        coin_move = CoinFlipMove('heads')
-        coin_state = CoinFlipState()
-        
-        assert isinstance(coin_move, pymcts_module.MCTS_move)
-        assert isinstance(coin_state, pymcts_module.MCTS_state)
-        
-        number_move = GuessMove(5)
-        number_state = NumberGuessingState()
-        
-        assert isinstance(number_move, pymcts_module.MCTS_move)
-        assert isinstance(number_state, pymcts_module.MCTS_state)
-
-
-class TestPythonGameLogic:
-    """Test game logic and rule implementation."""
-    
-    @pytest.mark.skipif(not CONNECT_FOUR_AVAILABLE, reason="Connect Four not available")
-    def test_connect_four_game_logic(self):
-        """Test Connect Four game logic implementation."""
-        state = ConnectFourState()
-        
-        # Test initial state
-        assert len(state.board) == 6  # 6 rows
-        assert len(state.board[0]) == 7  # 7 columns
-        assert all(cell == ' ' for row in state.board for cell in row)
-        
-        # Test valid moves
-        moves = state.actions_to_try()
-        assert all(0 <= move.column < 7 for move in moves)
-        
-        # Test move application
-        first_move = moves[0]
-        new_state = state.next_state(first_move)
-        
-        # Check that the piece was placed correctly
-        column = first_move.column
-        assert new_state.board[5][column] == 'X'  # Bottom row should have the piece
-        
-        # Check player switch
-        assert new_state.current_player == 'O'
-        
-    @pytest.mark.skipif(not CONNECT_FOUR_AVAILABLE, reason="Connect Four not available")
-    def test_connect_four_win_detection(self):
-        """Test Connect Four win detection logic."""
-        state = ConnectFourState()
-        
-        # Create a winning state manually (4 in a row horizontally)
-        test_state = ConnectFourState()
-        test_state.board[5][0] = 'X'
-        test_state.board[5][1] = 'X'
-        test_state.board[5][2] = 'X'
-        test_state.board[5][3] = 'X'
-        
-        # Should detect the win
-        winner = test_state.get_winner()
-        assert winner == 'X'
-        assert test_state.is_terminal()
-
-
-# Working MCTS agent tests - issue was incorrect constructor syntax
-
-class TestPythonGamesWithMCTS:
-    """Test Python games with MCTS agents."""
-    
-    @pytest.mark.skipif(not CONNECT_FOUR_AVAILABLE, reason="Connect Four not available")
-    def test_connect_four_with_mcts(self, pymcts_module):
-        """Test Connect Four with MCTS agent."""
-        state = ConnectFourState()
-        
-        # Use SerializedPythonState wrapper for MCTS compatibility
-        wrapped_state = pymcts_module.SerializedPythonState(state)
-        agent = pymcts_module.MCTS_agent(wrapped_state, 20, 1)  # 20 iterations, 1 second max
-        
-        move = agent.genmove(None)
-        assert move is not None
-        
-        # Should be a valid Connect Four move (returned as MCTS_move)
-        move_str = str(move)
-        assert 'Drop' in move_str
-        assert '@' in move_str
-        
-        # Parse the move string to verify it's valid
-        parts = move_str.split('@')
-        assert len(parts) == 2
-        column = int(parts[1])
-        assert 0 <= column <= 6
-        
-        print(f"Connect Four MCTS move: {move_str}")
-        
-    @pytest.mark.skipif(not SIMPLE_GAMES_AVAILABLE, reason="Simple games not available")
-    def test_simple_games_with_mcts(self, pymcts_module):
-        """Test simple games with MCTS agent."""
-        # Test coin flip game
-        coin_state = CoinFlipState()
-        wrapped_coin_state = pymcts_module.SerializedPythonState(coin_state)
-        coin_agent = pymcts_module.MCTS_agent(wrapped_coin_state, 10, 1)  # 10 iterations, 1 second max
-        
-        coin_move = coin_agent.genmove(None)
-        assert coin_move is not None
-        coin_move_str = str(coin_move)
-        assert 'Choose' in coin_move_str and ('heads' in coin_move_str or 'tails' in coin_move_str)
-        
-        print(f"Coin flip MCTS choice: {coin_move_str}")
-        
-        # Test number game
-        number_state = NumberGuessingState()
-        wrapped_number_state = pymcts_module.SerializedPythonState(number_state)
-        number_agent = pymcts_module.MCTS_agent(wrapped_number_state, 10, 1)  # 10 iterations, 1 second max
-        
-        number_move = number_agent.genmove(None)
-        assert number_move is not None
-        number_move_str = str(number_move)
-        assert 'Guess' in number_move_str
-        
-        print(f"Number game MCTS choice: {number_move_str}")
-        
-    @pytest.mark.skipif(not CONNECT_FOUR_AVAILABLE, reason="Connect Four not available")
-    def test_connect_four_full_game_with_mcts(self, pymcts_module):
-        """Test a full Connect Four game with MCTS vs random opponent."""
-        state = ConnectFourState()
-        wrapped_state = pymcts_module.SerializedPythonState(state)
-        agent = pymcts_module.MCTS_agent(wrapped_state, 50, 1)  # 50 iterations, 1 second max
-        
-        moves_played = 0
-        max_moves = 10  # Limit for testing
-        
-        # Simplified test - just verify MCTS can generate valid moves
-        agent_move = agent.genmove(None)
-        assert agent_move is not None
-        
-        # Parse the move string to verify it's valid
-        move_str = str(agent_move)
-        assert 'Drop' in move_str and '@' in move_str
-        column = int(move_str.split('@')[1])
-        assert 0 <= column <= 6
-        
-        print(f"MCTS chose column {column}")
-        print(f"Connect Four MCTS test completed successfully")
-    
-    @pytest.mark.skipif(not CONNECT_FOUR_AVAILABLE, reason="Connect Four not available")
-    def test_connect_four_mcts_finds_winning_move(self, pymcts_module):
-        """Test that MCTS can identify and choose a winning move when one is available."""
-        # Create a specific board state where X can win in one move
-        # Board layout (X needs to play in column 3 to win horizontally):
-        #   0 1 2 3 4 5 6
-        # 5 . . . . . . .
-        # 4 . . . . . . .
-        # 3 . . . . . . .
-        # 2 . . . . . . .
-        # 1 . . . . . . .
-        # 0 X X X . O O O
-        
-        state = ConnectFourState()
-        
-        # Manually set up the board for a winning scenario
-        # Bottom row: X X X . O O O
-        state.board[5][0] = 'X'  # X at position (5,0)
-        state.board[5][1] = 'X'  # X at position (5,1) 
-        state.board[5][2] = 'X'  # X at position (5,2)
-        state.board[5][3] = ' '  # Empty at position (5,3) - winning move!
-        state.board[5][4] = 'O'  # O at position (5,4)
-        state.board[5][5] = 'O'  # O at position (5,5)
-        state.board[5][6] = 'O'  # O at position (5,6)
-        
-        # Set current player to X (should be X's turn to make the winning move)
-        state.current_player = 'X'
-        
-        # Use SerializedPythonState wrapper for MCTS compatibility
-        wrapped_state = pymcts_module.SerializedPythonState(state)
-        
-        # Use more iterations to ensure MCTS finds the obvious win
-        agent = pymcts_module.MCTS_agent(wrapped_state, 100, 2)  # 100 iterations, 2 seconds max
-        
-        # MCTS should find the winning move
-        move = agent.genmove(None)
-        assert move is not None, "MCTS should find a move"
-        
-        # Parse the move
-        move_str = str(move)
-        assert 'Drop' in move_str, f"Expected Drop move, got: {move_str}"
-        assert '@' in move_str, f"Expected @ in move format, got: {move_str}"
-        
-        # Extract column from move string (format: "DropX@3")
-        column = int(move_str.split('@')[1])
-        
-        # The winning move should be column 3
-        assert column == 3, f"MCTS should choose winning column 3, but chose column {column}"
-        
-        # Verify this move actually wins the game
-        winning_move = ConnectFourMove(3, 'X')
-        final_state = state.next_state(winning_move)
-        assert final_state.is_terminal(), "The move should result in a terminal state"
-        assert final_state.get_winner() == 'X', "X should win after this move"
-        
-        print(f"✅ MCTS correctly identified winning move: column {column}")
\ No newline at end of file
+"""
+Tests for Python game implementations.
+Tests Python games from the demo folder without using MCTS agents.
+NOTE: MCTS agent tests disabled due to C++ memory corruption issue.
+"""
+import pytest
+import sys
+import os
+
+# Import demo games for testing
+sys.path.append(os.path.join(os.path.dirname(__file__), '..', 'demo'))
+
+try:
+    from connect_four_python import ConnectFourMove, ConnectFourState
+    CONNECT_FOUR_AVAILABLE = True
+except ImportError:
+    CONNECT_FOUR_AVAILABLE = False
+
+try:
+    from simple_python_games import CoinFlipMove, CoinFlipState, GuessMove, NumberGuessingState
+    SIMPLE_GAMES_AVAILABLE = True
+except ImportError:
+    SIMPLE_GAMES_AVAILABLE = False
+
+from take_away import ArrayPileGame, PileMove, PileState
+
+
+class TestPythonGameBasics:
+    """Test basic functionality of Python games without MCTS."""
+    
+    @pytest.mark.skipif(not CONNECT_FOUR_AVAILABLE, reason="Connect Four not available")
+    def test_connect_four_basic_functionality(self):
+        """Test Connect Four basic functionality."""
+        # Test move creation
+        move = ConnectFourMove(3, 'X')
+        assert move.column == 3
+        assert move.player == 'X'
+        assert '3' in move.sprint()
+        assert 'X' in move.sprint()
+        
+        # Test state creation
+        state = ConnectFourState()
+        assert not state.is_terminal()
+        assert state.is_self_side_turn()
+        
+        # Test move generation
+        moves = state.actions_to_try()
+        assert len(moves) == 7  # 7 columns
+        
+        # Test state transition
+        if moves:
+            new_state = state.next_state(moves[0])
+            assert new_state is not None
+            assert not new_state.is_self_side_turn()  # Should switch players
+            
+        # Test rollout
+        rollout_result = state.rollout()
+        assert 0.0 <= rollout_result <= 1.0
+        
+    @pytest.mark.skipif(not SIMPLE_GAMES_AVAILABLE, reason="Simple games not available")
+    def test_coin_flip_game(self):
+        """Test coin flip game functionality."""
+        # Test move
+        move = CoinFlipMove('heads')
+        assert move.choice == 'heads'
+        assert 'heads' in move.sprint().lower()
+        
+        # Test state
+        state = CoinFlipState()
+        assert not state.is_terminal()
+        assert state.is_self_side_turn()
+        
+        moves = state.actions_to_try()
+        assert len(moves) == 2  # heads or tails
+        
+        # Test state transition
+        if moves:
+            new_state = state.next_state(moves[0])
+            assert not new_state.is_terminal()  # Game continues (3 guesses total)
+            assert new_state.guesses_left == 2  # Started with 3, now has 2
+            
+    @pytest.mark.skipif(not SIMPLE_GAMES_AVAILABLE, reason="Simple games not available")
+    def test_number_game(self):
+        """Test number guessing game functionality."""
+        # Test move
+        move = GuessMove(5)
+        assert move.number == 5
+        assert '5' in move.sprint()
+        
+        # Test state
+        state = NumberGuessingState()
+        assert not state.is_terminal()
+        assert state.is_self_side_turn()
+        
+        moves = state.actions_to_try()
+        assert len(moves) > 0  # Should have some number choices
+        
+        # Test rollout
+        rollout_result = state.rollout()
+        assert 0.0 <= rollout_result <= 1.0
+
+
+class TestPythonGameInheritance:
+    """Test that Python games properly inherit from C++ base classes."""
+    
+    @pytest.mark.skipif(not CONNECT_FOUR_AVAILABLE, reason="Connect Four not available")
+    def test_connect_four_inheritance(self, pymcts_module):
+        """Test Connect Four inheritance from C++ classes."""
+        move = ConnectFourMove(3, 'X')
+        state = ConnectFourState()
+        
+        assert isinstance(move, pymcts_module.MCTS_move)
+        assert isinstance(state, pymcts_module.MCTS_state)
+        
+        # Test required methods exist
+        required_move_methods = ['__eq__', 'sprint']
+        for method in required_move_methods:
+            assert hasattr(move, method)
+            assert callable(getattr(move, method))
+            
+        required_state_methods = ['actions_to_try', 'next_state', 'rollout', 'is_terminal', 'is_self_side_turn']
+        for method in required_state_methods:
+            assert hasattr(state, method)
+            assert callable(getattr(state, method))
+            
+    @pytest.mark.skipif(not SIMPLE_GAMES_AVAILABLE, reason="Simple games not available")
+    def test_simple_games_inheritance(self, pymcts_module):
+        """Test simple games inheritance from C++ classes."""
+        coin_move = CoinFlipMove('heads')
+        coin_state = CoinFlipState()
+        
+        assert isinstance(coin_move, pymcts_module.MCTS_move)
+        assert isinstance(coin_state, pymcts_module.MCTS_state)
+        
+        number_move = GuessMove(5)
+        number_state = NumberGuessingState()
+        
+        assert isinstance(number_move, pymcts_module.MCTS_move)
+        assert isinstance(number_state, pymcts_module.MCTS_state)
+
+
+class TestPythonGameLogic:
+    """Test game logic and rule implementation."""
+    
+    @pytest.mark.skipif(not CONNECT_FOUR_AVAILABLE, reason="Connect Four not available")
+    def test_connect_four_game_logic(self):
+        """Test Connect Four game logic implementation."""
+        state = ConnectFourState()
+        
+        # Test initial state
+        assert len(state.board) == 6  # 6 rows
+        assert len(state.board[0]) == 7  # 7 columns
+        assert all(cell == ' ' for row in state.board for cell in row)
+        
+        # Test valid moves
+        moves = state.actions_to_try()
+        assert all(0 <= move.column < 7 for move in moves)
+        
+        # Test move application
+        first_move = moves[0]
+        new_state = state.next_state(first_move)
+        
+        # Check that the piece was placed correctly
+        column = first_move.column
+        assert new_state.board[5][column] == 'X'  # Bottom row should have the piece
+        
+        # Check player switch
+        assert new_state.current_player == 'O'
+        
+    @pytest.mark.skipif(not CONNECT_FOUR_AVAILABLE, reason="Connect Four not available")
+    def test_connect_four_win_detection(self):
+        """Test Connect Four win detection logic."""
+        state = ConnectFourState()
+        
+        # Create a winning state manually (4 in a row horizontally)
+        test_state = ConnectFourState()
+        test_state.board[5][0] = 'X'
+        test_state.board[5][1] = 'X'
+        test_state.board[5][2] = 'X'
+        test_state.board[5][3] = 'X'
+        
+        # Should detect the win
+        winner = test_state.get_winner()
+        assert winner == 'X'
+        assert test_state.is_terminal()
+
+
+# Working MCTS agent tests - issue was incorrect constructor syntax
+
+class TestPythonGamesWithMCTS:
+    """Test Python games with MCTS agents."""
+    
+    @pytest.mark.skipif(not CONNECT_FOUR_AVAILABLE, reason="Connect Four not available")
+    def test_connect_four_with_mcts(self, pymcts_module):
+        """Test Connect Four with MCTS agent."""
+        state = ConnectFourState()
+        
+        # Use SerializedPythonState wrapper for MCTS compatibility
+        wrapped_state = pymcts_module.SerializedPythonState(state)
+        agent = pymcts_module.MCTS_agent(wrapped_state, 20, 1)  # 20 iterations, 1 second max
+        
+        move = agent.genmove(None)
+        assert move is not None
+        
+        # Should be a valid Connect Four move (returned as MCTS_move)
+        move_str = str(move)
+        assert 'Drop' in move_str
+        assert '@' in move_str
+        
+        # Parse the move string to verify it's valid
+        parts = move_str.split('@')
+        assert len(parts) == 2
+        column = int(parts[1])
+        assert 0 <= column <= 6
+        
+        print(f"Connect Four MCTS move: {move_str}")
+        
+    @pytest.mark.skipif(not SIMPLE_GAMES_AVAILABLE, reason="Simple games not available")
+    def test_simple_games_with_mcts(self, pymcts_module):
+        """Test simple games with MCTS agent."""
+        # Test coin flip game
+        coin_state = CoinFlipState()
+        wrapped_coin_state = pymcts_module.SerializedPythonState(coin_state)
+        coin_agent = pymcts_module.MCTS_agent(wrapped_coin_state, 10, 1)  # 10 iterations, 1 second max
+        
+        coin_move = coin_agent.genmove(None)
+        assert coin_move is not None
+        coin_move_str = str(coin_move)
+        assert 'Choose' in coin_move_str and ('heads' in coin_move_str or 'tails' in coin_move_str)
+        
+        print(f"Coin flip MCTS choice: {coin_move_str}")
+        
+        # Test number game
+        number_state = NumberGuessingState()
+        wrapped_number_state = pymcts_module.SerializedPythonState(number_state)
+        number_agent = pymcts_module.MCTS_agent(wrapped_number_state, 10, 1)  # 10 iterations, 1 second max
+        
+        number_move = number_agent.genmove(None)
+        assert number_move is not None
+        number_move_str = str(number_move)
+        assert 'Guess' in number_move_str
+        
+        print(f"Number game MCTS choice: {number_move_str}")
+        
+    @pytest.mark.skipif(not CONNECT_FOUR_AVAILABLE, reason="Connect Four not available")
+    def test_connect_four_full_game_with_mcts(self, pymcts_module):
+        """Test a full Connect Four game with MCTS vs random opponent."""
+        state = ConnectFourState()
+        wrapped_state = pymcts_module.SerializedPythonState(state)
+        agent = pymcts_module.MCTS_agent(wrapped_state, 50, 1)  # 50 iterations, 1 second max
+        
+        moves_played = 0
+        max_moves = 10  # Limit for testing
+        
+        # Simplified test - just verify MCTS can generate valid moves
+        agent_move = agent.genmove(None)
+        assert agent_move is not None
+        
+        # Parse the move string to verify it's valid
+        move_str = str(agent_move)
+        assert 'Drop' in move_str and '@' in move_str
+        column = int(move_str.split('@')[1])
+        assert 0 <= column <= 6
+        
+        print(f"MCTS chose column {column}")
+        print(f"Connect Four MCTS test completed successfully")
+    
+    @pytest.mark.skipif(not CONNECT_FOUR_AVAILABLE, reason="Connect Four not available")
+    def test_connect_four_mcts_finds_winning_move(self, pymcts_module):
+        """Test that MCTS can identify and choose a winning move when one is available."""
+        # Create a specific board state where X can win in one move
+        # Board layout (X needs to play in column 3 to win horizontally):
+        #   0 1 2 3 4 5 6
+        # 5 . . . . . . .
+        # 4 . . . . . . .
+        # 3 . . . . . . .
+        # 2 . . . . . . .
+        # 1 . . . . . . .
+        # 0 X X X . O O O
+        
+        state = ConnectFourState()
+        
+        # Manually set up the board for a winning scenario
+        # Bottom row: X X X . O O O
+        state.board[5][0] = 'X'  # X at position (5,0)
+        state.board[5][1] = 'X'  # X at position (5,1) 
+        state.board[5][2] = 'X'  # X at position (5,2)
+        state.board[5][3] = ' '  # Empty at position (5,3) - winning move!
+        state.board[5][4] = 'O'  # O at position (5,4)
+        state.board[5][5] = 'O'  # O at position (5,5)
+        state.board[5][6] = 'O'  # O at position (5,6)
+        
+        # Set current player to X (should be X's turn to make the winning move)
+        state.current_player = 'X'
+        
+        # Use SerializedPythonState wrapper for MCTS compatibility
+        wrapped_state = pymcts_module.SerializedPythonState(state)
+        
+        # Use more iterations to ensure MCTS finds the obvious win
+        agent = pymcts_module.MCTS_agent(wrapped_state, 100, 2)  # 100 iterations, 2 seconds max
+        
+        # MCTS should find the winning move
+        move = agent.genmove(None)
+        assert move is not None, "MCTS should find a move"
+        
+        # Parse the move
+        move_str = str(move)
+        assert 'Drop' in move_str, f"Expected Drop move, got: {move_str}"
+        assert '@' in move_str, f"Expected @ in move format, got: {move_str}"
+        
+        # Extract column from move string (format: "DropX@3")
+        column = int(move_str.split('@')[1])
+        
+        # The winning move should be column 3
+        assert column == 3, f"MCTS should choose winning column 3, but chose column {column}"
+        
+        # Verify this move actually wins the game
+        winning_move = ConnectFourMove(3, 'X')
+        final_state = state.next_state(winning_move)
+        assert final_state.is_terminal(), "The move should result in a terminal state"
+        assert final_state.get_winner() == 'X', "X should win after this move"
+        
+        print(f"✅ MCTS correctly identified winning move: column {column}")
+
+class CountingPileMove(PileMove):
+    """PileMove that counts its sprint() and __hash__() calls and has NumPy encodings."""
+    sprint_calls = 0
+    hash_calls = 0
+
+    def __hash__(self):
+        CountingPileMove.hash_calls += 1
+        return super().__hash__()
+
+    def sprint(self):
+        CountingPileMove.sprint_calls += 1
+        return super().sprint()
+
+    def to_numpy(self):
+        try:
+            import numpy
+            return numpy.array([self.take], dtype=numpy.int64)
+        except ImportError:
+            return [self.take]
+
+    def to_env_action(self):
+        return (self.take,)
+
+
+class BatchedPileState(PileState):
+    """Take-away game that only simulates in batches and counts its rollout calls."""
+    move_class = CountingPileMove
+    calls = {"rollout": 0, "rollout_many": 0, "rollout_batch": 0, "states": 0}
+
+    def rollout(self):
+        BatchedPileState.calls["rollout"] += 1
+        return self.value()
+
+    def rollout_batch(self, n):
+        BatchedPileState.calls["rollout_batch"] += 1
+        return [self.value()] * n
+
+    def rollout_many(self, states):
+        BatchedPileState.calls["rollout_many"] += 1
+        BatchedPileState.calls["states"] += len(states)
+        return [state.value() for state in states]
+
+
+class TestPythonRolloutBatches:
+    """Test the rollout_many()/rollout_batch() protocol of SerializedPythonState."""
+
+    def test_rollout_many_called_once_per_leaf_batch(self, pymcts_module):
+        """Test that batched leaves are simulated with a single Python call and the search still works."""
+        BatchedPileState.calls.update(rollout=0, rollout_many=0, rollout_batch=0, states=0)
+        original = pymcts_module.get_leaf_batch_size()
+        try:
+            pymcts_module.set_leaf_batch_size(8)
+            agent = pymcts_module.MCTS_agent(pymcts_module.SerializedPythonState(BatchedPileState(10)), 200, 10)
+            move = agent.genmove(None)
+        finally:
+            pymcts_module.set_leaf_batch_size(original)
+        assert BatchedPileState.calls["rollout"] == 0
+        assert BatchedPileState.calls["states"] == 200
+        assert BatchedPileState.calls["rollout_many"] == 25
+        assert move.sprint() == "Take1"          # leaves 9 stones, a multiple of 3
+
+    def test_rollout_batch_used_for_rollouts_per_leaf(self, pymcts_module):
+        """Test that several rollouts of the same leaf go through one rollout_batch() call."""
+        BatchedPileState.calls.update(rollout=0, rollout_many=0, rollout_batch=0, states=0)
+        state = pymcts_module.SerializedPythonState(BatchedPileState(4))
+        assert state.rollout_n(16) == 16.0
+        assert BatchedPileState.calls["rollout_batch"] == 1
+        assert BatchedPileState.calls["rollout"] == 0
+
+
+class TestPythonMoveWrapper:
+    """Test how moves of SerializedPythonState games are wrapped for the engine."""
+
+    def test_sprint_is_called_lazily(self, pymcts_module):
+        """Test that searching never asks for move strings and printing asks only once per move."""
+        CountingPileMove.sprint_calls = 0
+        agent = pymcts_module.MCTS_agent(pymcts_module.SerializedPythonState(BatchedPileState(10)), 100, 10)
+        move = agent.genmove(None)
+        assert CountingPileMove.sprint_calls == 0
+        assert move.sprint() == "Take1"
+        assert move.sprint() == "Take1"
+        assert CountingPileMove.sprint_calls == 1
+
+    def test_numpy_move_encodings(self, pymcts_module):
+        """Test that to_numpy()/to_env_action() accept NumPy arrays and tuples."""
+        pytest.importorskip("numpy")
+        agent = pymcts_module.MCTS_agent(pymcts_module.SerializedPythonState(BatchedPileState(10)), 100, 10)
+        move = agent.genmove(None)
+        assert move.to_numpy() == [1.0]
+        assert move.to_env_action() == [1]
+        assert sorted(agent.last_search_stats()["moves"][:, 0].tolist()) == [1.0, 2.0]
+
+    def test_enemy_move_found_by_hash(self, pymcts_module, capfd):
+        """Test that a hashable enemy move defined in Python finds its child instead of restarting the tree."""
+        class EnemyPileMove(pymcts_module.MCTS_move):
+            def __init__(self, take):
+                super().__init__()
+                self.take = take
+
+            def __eq__(self, other):
+                return getattr(other, "take", None) == self.take
+
+            def __hash__(self):
+                return hash(self.take)
+
+            def sprint(self):
+                return f"Take{self.take}"
+
+        agent = pymcts_module.MCTS_agent(pymcts_module.SerializedPythonState(BatchedPileState(10)), 200, 10)
+        agent.genmove(None)                       # 9 stones left
+        CountingPileMove.hash_calls = 0
+        capfd.readouterr()
+        move = agent.genmove(EnemyPileMove(2))    # 7 left, the agent should take 1
+        assert "start over" not in capfd.readouterr().out
+        assert move.sprint() == "Take1"
+        assert 0 < CountingPileMove.hash_calls <= 4     # once per child of the two roots, not once per comparison
+
+
+class CountingArrayPileGame(ArrayPileGame):
+    """take_away.ArrayPileGame that counts its calls."""
+
+    def __init__(self):
+        self.calls = {"next_state": 0, "rollout": 0, "rollout_many": 0, "rows": 0}
+
+    def next_state(self, state, action, out):
+        self.calls["next_state"] += 1
+        super().next_state(state, action, out)
+
+    def rollout(self, state):
+        self.calls["rollout"] += 1
+        return super().rollout(state)
+
+
+class BatchedArrayPileGame(CountingArrayPileGame):
+    """CountingArrayPileGame that simulates whole batches with NumPy."""
+
+    def rollout_many(self, states):
+        self.calls["rollout_many"] += 1
+        self.calls["rows"] += len(states)
+        return ((states[:, 0] % 3 != 0) == (states[:, 1] != 0)).astype(float)
+
+
+class TestArrayPythonState:
+    """Test Python games whose states are fixed-size buffers stored by the engine."""
+
+    def test_array_state_transitions(self, pymcts_module):
+        """Test that next_state() writes into a copy and leaves the parent's buffer alone."""
+        np = pytest.importorskip("numpy")
+        state = pymcts_module.ArrayPythonState(CountingArrayPileGame(), np.array([10, 1]))
+        assert not state.is_terminal() and state.is_self_side_turn()
+        assert [move.action for move in state.actions_to_try()] == [1, 2]
+        child = state.next_state(pymcts_module.ArrayPythonMove(2))
+        assert child.get_array().tolist() == [8, 0]
+        assert state.get_array().tolist() == [10, 1]
+        assert not child.is_self_side_turn()
+        assert child.to_numpy() == [8.0, 0.0]
+        assert child.action_index(pymcts_module.ArrayPythonMove(2)) == 2
+        with pytest.raises(ValueError):
+            pymcts_module.ArrayPythonState(CountingArrayPileGame(), np.zeros(3))
+
+    def test_array_state_search_keeps_states_in_arena(self, pymcts_module, capfd):
+        """Test a search on array states, an enemy move and that deleted trees give their buffers back."""
+        np = pytest.importorskip("numpy")
+        start = pymcts_module.ArrayPythonState(CountingArrayPileGame(), np.array([10, 1]))
+        agent = pymcts_module.MCTS_agent(start, 200, 10)
+        assert agent.genmove(None).action == 1           # leaves 9 stones, a multiple of 3
+        assert isinstance(agent.get_current_state(), pymcts_module.ArrayPythonState)
+        assert start.get_arena_slots() > 2
+        capfd.readouterr()
+        assert agent.genmove(pymcts_module.ArrayPythonMove(2)).action == 1
+        assert "start over" not in capfd.readouterr().out
+        del agent
+        assert start.get_arena_slots() == 1
+
+    def test_array_state_rollout_many(self, pymcts_module):
+        """Test that leaf batches and rollouts per leaf go through one rollout_many() call on a 2-D array."""
+        np = pytest.importorskip("numpy")
+        game = BatchedArrayPileGame()
+        original = pymcts_module.get_leaf_batch_size()
+        try:
+            pymcts_module.set_leaf_batch_size(8)
+            agent = pymcts_module.MCTS_agent(pymcts_module.ArrayPythonState(game, np.array([10, 1])), 200, 10)
+            assert agent.genmove(None).action == 1
+        finally:
+            pymcts_module.set_leaf_batch_size(original)
+        assert game.calls["rollout"] == 0
+        assert game.calls["rows"] == 200 and game.calls["rollout_many"] == 25
+        state = pymcts_module.ArrayPythonState(game, np.array([4, 1]))
+        assert state.rollout_n(16) == 16.0
+        assert game.calls["rollout_many"] == 26
+
+    def test_array_connect_four_finds_win(self, pymcts_module):
+        """Test the array-backed Connect Four demo: X completes four in column 0."""
+        pytest.importorskip("numpy")
+        from connect_four_array import ConnectFourArrayGame
+        game = ConnectFourArrayGame()
+        state = pymcts_module.ArrayPythonState(game, ConnectFourArrayGame.initial_state())
+        for column in [0, 6, 0, 6, 0, 5]:
+            state = state.next_state(pymcts_module.ArrayPythonMove(column))
+        agent = pymcts_module.MCTS_agent(state, 1000, 10)
+        move = agent.genmove(None)
+        assert move.action == 0
+        assert agent.get_current_state().is_terminal()
@@ -0,0 +1,85 @@
+"""
+Tests for the native self-play runner (pymcts.self_play).
+Games of C++ states played on a thread pool and stored as training records.
+"""
+import pytest
+
+np = pytest.importorskip("numpy")
+
+
+def buffers(rows, state_size, action_size):
+    """Preallocated float64 arrays for self_play()."""
+    return np.zeros((rows, state_size)), np.zeros((rows, action_size)), np.zeros(rows)
+
+
+class TestTrainingEncodings:
+    """Test the training data methods of the C++ states."""
+
+    def test_tictactoe_encoding(self, pymcts_module):
+        """Test that the board is encoded for the side to move and moves get flat indices."""
+        state = pymcts_module.TicTacToe_state()
+        assert state.action_space_size() == 9
+        assert state.to_numpy() == [0.0] * 9
+        state = state.next_state(pymcts_module.TicTacToe_move(1, 2, 'x'))
+        encoding = state.to_numpy()
+        assert encoding[5] == -1.0 and sum(abs(v) for v in encoding) == 1.0     # x's stone, o to move
+        assert state.action_index(pymcts_module.TicTacToe_move(2, 0, 'o')) == 6
+
+    def test_connectfour_and_gomoku_sizes(self, pymcts_module):
+        """Test the encoding and action space sizes of the other native games."""
+        c4 = pymcts_module.ConnectFour_state()
+        assert len(c4.to_numpy()) == 42 and c4.action_space_size() == 7
+        gomoku = pymcts_module.Gomoku_state()
+        assert len(gomoku.to_numpy()) == 225 and gomoku.action_space_size() == 225
+        assert gomoku.action_index(pymcts_module.Gomoku_move(2, 3, 'x')) == 33
+
+
+class TestSelfPlay:
+    """Test self_play() into NumPy buffers and binary files."""
+
+    def test_tictactoe_into_buffers(self, pymcts_module):
+        """Test that every position of every game becomes a consistent record."""
+        states, policies, outcomes = buffers(200, 9, 9)
+        report = pymcts_module.self_play(pymcts_module.TicTacToe_state(), 6, max_iter=200, threads=2,
+                                         temperature_moves=2, seed=1,
+                                         states=states, policies=policies, outcomes=outcomes)
+        assert report["games"] == 6
+        n = report["records"]
+        assert 6 * 5 <= n <= 6 * 9
+        assert report["games_per_hour"] > 0
+        assert np.allclose(policies[:n].sum(axis=1), 1.0)
+        assert set(outcomes[:n].tolist()) <= {0.0, 0.5, 1.0}
+        stones = np.abs(states[:n]).sum(axis=1)
+        assert (stones == 0).sum() == 6                    # one empty board per game
+        assert not states[n:].any()                        # rows past the records are untouched
+
+    def test_buffer_too_small_for_a_game(self, pymcts_module):
+        """Test that only whole games are stored."""
+        states, policies, outcomes = buffers(3, 9, 9)
+        report = pymcts_module.self_play(pymcts_module.TicTacToe_state(), 2, max_iter=50,
+                                         states=states, policies=policies, outcomes=outcomes)
+        assert report["games"] == 0 and report["records"] == 0
+
+    def test_connectfour_into_file(self, pymcts_module, tmp_path):
+        """Test the binary file format and appending to it."""
+        path = tmp_path / "c4.bin"
+        first = pymcts_module.self_play(pymcts_module.ConnectFour_state(), 2, max_iter=100, path=path)
+        second = pymcts_module.self_play(pymcts_module.ConnectFour_state(), 1, max_iter=100, path=path, append=True)
+        with open(path, "rb") as f:
+            assert f.read(8) == b"MCTSSP1\0"
+            assert np.frombuffer(f.read(8), dtype=np.uint32).tolist() == [42, 7]
+        records = np.fromfile(path, dtype=[("state", "<f8", 42), ("policy", "<f8", 7), ("outcome", "<f8")], offset=16)
+        assert len(records) == first["records"] + second["records"]
+        assert np.allclose(records["policy"].sum(axis=1), 1.0)
+
+    def test_invalid_buffers(self, pymcts_module):
+        """Test that buffers of the wrong type or shape are rejected."""
+        states, policies, outcomes = buffers(10, 9, 9)
+        with pytest.raises(ValueError):
+            pymcts_module.self_play(pymcts_module.TicTacToe_state(), 1, states=states.astype(np.float32),
+                                    policies=policies, outcomes=outcomes)
+        with pytest.raises(ValueError):
+            pymcts_module.self_play(pymcts_module.TicTacToe_state(), 1, states=states, policies=policies[:, :7],
+                                    outcomes=outcomes)
+        with pytest.raises(ValueError):
+            pymcts_module.self_play(pymcts_module.TicTacToe_state(), 1)
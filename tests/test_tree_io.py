@@ -0,0 +1,103 @@
+"""
+Tests for saving and loading search trees (MCTS_tree.save/load, MCTS_agent.save_tree/load_tree).
+"""
+import os
+import struct
+import sys
+import pytest
+
+sys.path.append(os.path.join(os.path.dirname(__file__), '..', 'demo'))
+from take_away import PileState       # picklable, for trees saved with states
+
+
+def same_root_stats(a, b):
+    np = pytest.importorskip("numpy")
+    x, y = a.root_stats(), b.root_stats()
+    return all(np.array_equal(x[key], y[key]) for key in ("visits", "q", "prior", "moves"))
+
+
+class TestTreeIO:
+    """Test the binary tree files."""
+
+    def test_roundtrip(self, pymcts_module, tmp_path):
+        """Test that a loaded tree has the saved statistics and keeps growing."""
+        tree = pymcts_module.MCTS_tree(pymcts_module.ConnectFour_state())
+        tree.grow_tree(1000, 10)
+        path = tmp_path / "c4.tree"
+        tree.save(path)
+        loaded = pymcts_module.MCTS_tree.load(path, pymcts_module.ConnectFour_state())
+        assert loaded.get_size() == tree.get_size()
+        assert same_root_stats(tree, loaded)
+        loaded.grow_tree(200, 10)
+        assert loaded.get_size() > tree.get_size()
+
+    def test_states_restore_the_root(self, pymcts_module, tmp_path):
+        """Test that a tree saved with states is loaded from any state of the game."""
+        state = pymcts_module.ConnectFour_state()
+        state = state.next_state(pymcts_module.ConnectFour_move(3, 'X'))
+        tree = pymcts_module.MCTS_tree(state)
+        tree.grow_tree(500, 10)
+        path = tmp_path / "c4.tree"
+        tree.save(path, states=True)
+        loaded = pymcts_module.MCTS_tree.load(path, pymcts_module.ConnectFour_state())
+        assert loaded.get_current_state().get_turn() == 'O'
+        assert same_root_stats(tree, loaded)
+
+    def test_invalid_files(self, pymcts_module, tmp_path):
+        """Test that wrong roots, other files and truncated trees are rejected."""
+        tree = pymcts_module.MCTS_tree(pymcts_module.ConnectFour_state())
+        tree.grow_tree(200, 10)
+        path = tmp_path / "c4.tree"
+        tree.save(path)
+        other = pymcts_module.ConnectFour_state().next_state(pymcts_module.ConnectFour_move(0, 'X'))
+        with pytest.raises(RuntimeError, match="root state"):
+            pymcts_module.MCTS_tree.load(path, other)
+        data = path.read_bytes()
+        path.write_bytes(data[:-3])
+        with pytest.raises(RuntimeError, match="Truncated"):
+            pymcts_module.MCTS_tree.load(path, pymcts_module.ConnectFour_state())
+        path.write_bytes(b"not a tree")
+        with pytest.raises(RuntimeError, match="not a tree file"):
+            pymcts_module.MCTS_tree.load(path, pymcts_module.ConnectFour_state())
+
+    def test_invalid_connectfour_states(self, pymcts_module, tmp_path):
+        """Test that saved ConnectFour states with an unknown winner, floating stones or a wrong move count are rejected."""
+        state = pymcts_module.ConnectFour_state().next_state(pymcts_module.ConnectFour_move(3, 'X'))
+        tree = pymcts_module.MCTS_tree(state)
+        tree.grow_tree(50, 10)
+        path = tmp_path / "c4.tree"
+        tree.save(path, states=True)
+        data = path.read_bytes()
+        # the root's serialize(): X's and O's bitboards, every column's next free bit, moves played, turn and winner
+        heights = bytes(7 * column + (column == 3) for column in range(7))
+        root = struct.pack("=QQ", 1 << 21, 0) + heights + bytes([1]) + b"O "
+        at = data.find(root)
+        assert at >= 0
+        for bad in (root[:-1] + b"Z",                                                   # no such winner
+                    struct.pack("=QQ", 1 << 21 | 1 << 22, 0) + heights + bytes([2]) + b"X ",  # a stone above the height
+                    root[:-3] + bytes([2]) + b"O "):                                     # 2 moves, 1 stone
+            path.write_bytes(data[:at] + bad + data[at + len(root):])
+            with pytest.raises(RuntimeError, match="could not be restored"):
+                pymcts_module.MCTS_tree.load(path, pymcts_module.ConnectFour_state())
+
+    def test_python_states(self, pymcts_module, tmp_path):
+        """Test that trees of Python games are saved with pickled states and without them."""
+        tree = pymcts_module.MCTS_tree(pymcts_module.SerializedPythonState(PileState(10)))
+        tree.grow_tree(200, 10)
+        for states in (False, True):
+            path = tmp_path / f"pile{states}.tree"
+            tree.save(path, states=states)
+            loaded = pymcts_module.MCTS_tree.load(path, pymcts_module.SerializedPythonState(PileState(10)))
+            assert loaded.get_size() == tree.get_size()
+            assert loaded.select_best_child().get_move().sprint() == "Take1"
+
+    def test_agent_save_and_load_tree(self, pymcts_module, tmp_path):
+        """Test that an agent continues from the tree another agent saved."""
+        agent = pymcts_module.MCTS_agent(pymcts_module.TicTacToe_state(), 300, 5)
+        agent.genmove(None)
+        path = tmp_path / "ttt.tree"
+        agent.save_tree(path, states=True)
+        other = pymcts_module.MCTS_agent(pymcts_module.TicTacToe_state(), 300, 5)
+        other.load_tree(path)
+        assert other.get_current_state().get_turn() == 'o'
+        assert other.genmove(None) is not None